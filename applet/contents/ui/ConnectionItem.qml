@@ -45,6 +45,9 @@ PlasmaExtras.ExpandableListItem {
                               Type == PlasmaNM.Enums.Wireless ||
                               Type == PlasmaNM.Enums.Gsm ||
                               Type == PlasmaNM.Enums.Cdma)
+    property bool showModemSignal: showSpeed &&
+                                   (Type == PlasmaNM.Enums.Gsm ||
+                                    Type == PlasmaNM.Enums.Cdma)
 
     property real rxBytes: 0
     property real txBytes: 0
@@ -281,6 +284,10 @@ PlasmaExtras.ExpandableListItem {
         connectionModel.setDeviceStatisticsRefreshRateMs(DevicePath, showSpeed ? 2000 : 0)
     }
 
+    onShowModemSignalChanged: {
+        connectionModel.setModemSignalRefreshRate(DevicePath, showModemSignal ? 5 : 0)
+    }
+
     onActivatingChanged: {
         if (ConnectionState == PlasmaNM.Enums.Activating) {
             ListView.view.positionViewAtBeginning()
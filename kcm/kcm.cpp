@@ -25,6 +25,7 @@
 #include "mobileconnectionwizard.h"
 #include "uiutils.h"
 #include "vpnuiplugin.h"
+#include "vpnuipluginregistry.h"
 #include "settings/wireguardinterfacewidget.h"
 
 // KDE
@@ -32,8 +33,6 @@
 #include <KPluginFactory>
 #include <KSharedConfig>
 #include <kdeclarative/kdeclarative.h>
-#include <KService>
-#include <KServiceTypeTrader>
 
 #include <NetworkManagerQt/ActiveConnection>
 #include <NetworkManagerQt/Connection>
@@ -410,9 +409,8 @@ void KCMNetworkmanagement::onRequestExportConnection(const QString &connectionPa
     qCDebug(PLASMA_NM) << "Exporting VPN connection" << connection->name() << "type:" << vpnSetting->serviceType();
 
     QString error;
-    VpnUiPlugin * vpnPlugin = KServiceTypeTrader::createInstanceFromQuery<VpnUiPlugin>(QStringLiteral("PlasmaNetworkManagement/VpnUiPlugin"),
-                                                                                       QStringLiteral("[X-NetworkManager-Services]=='%1'").arg(vpnSetting->serviceType()),
-                                                                                       this, QVariantList(), &error);
+    VpnUiPluginRegistry *registry = VpnUiPluginRegistry::self();
+    VpnUiPlugin * vpnPlugin = registry->plugin(vpnSetting->serviceType(), &error);
 
     if (vpnPlugin) {
         if (vpnPlugin->suggestedFileName(connSettings).isEmpty()) { // this VPN doesn't support export
@@ -421,7 +419,7 @@ void KCMNetworkmanagement::onRequestExportConnection(const QString &connectionPa
         }
 
         const QString url = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + QDir::separator() + vpnPlugin->suggestedFileName(connSettings);
-        const QString filename = QFileDialog::getSaveFileName(this, i18n("Export VPN Connection"), url, vpnPlugin->supportedFileExtensions());
+        const QString filename = QFileDialog::getSaveFileName(this, i18n("Export VPN Connection"), url, registry->supportedFileExtensions(vpnSetting->serviceType()));
         if (!filename.isEmpty()) {
             if (!vpnPlugin->exportConnectionSettings(connSettings, filename)) {
                 // TODO display failure
@@ -430,7 +428,6 @@ void KCMNetworkmanagement::onRequestExportConnection(const QString &connectionPa
                 // TODO display success
             }
         }
-        delete vpnPlugin;
     } else {
         qCWarning(PLASMA_NM) << "Error getting VpnUiPlugin for export:" << error;
     }
@@ -519,22 +516,14 @@ void KCMNetworkmanagement::loadConnectionSettings(const NetworkManager::Connecti
 
 void KCMNetworkmanagement::importVpn()
 {
-    // get the list of supported extensions
-    const KService::List services = KServiceTypeTrader::self()->query("PlasmaNetworkManagement/VpnUiPlugin");
-    QString extensions;
-    for (const KService::Ptr &service : services) {
-        VpnUiPlugin * vpnPlugin = service->createInstance<VpnUiPlugin>(this);
-        if (vpnPlugin) {
-            extensions += vpnPlugin->supportedFileExtensions() % QStringLiteral(" ");
-            delete vpnPlugin;
-        }
-    }
-
-    const QString &filename = QFileDialog::getOpenFileName(this, i18n("Import VPN Connection"), QDir::homePath(), extensions.simplified());
-
-    if (!filename.isEmpty()) {
-        const KService::List services = KServiceTypeTrader::self()->query("PlasmaNetworkManagement/VpnUiPlugin");
-
+    // get the list of supported extensions from the plugin metadata
+    VpnUiPluginRegistry *registry = VpnUiPluginRegistry::self();
+    const QStringList filenames = QFileDialog::getOpenFileNames(this, i18n("Import VPN Connection"), QDir::homePath(), registry->supportedFileExtensions());
+
+    if (filenames.size() > 1) {
+        importVpnFiles(filenames);
+    } else if (!filenames.isEmpty()) {
+        const QString &filename = filenames.first();
         QFileInfo fi(filename);
         const QString ext = QStringLiteral("*.") % fi.suffix();
         qCDebug(PLASMA_NM) << "Importing VPN connection " << filename << "extension:" << ext;
@@ -555,37 +544,82 @@ void KCMNetworkmanagement::importVpn()
                 return; // get out if the import produced at least some output
             }
         }
-        for (const KService::Ptr &service : services) {
-            VpnUiPlugin * vpnPlugin = service->createInstance<VpnUiPlugin>(this);
-            if (vpnPlugin && vpnPlugin->supportedFileExtensions().contains(ext)) {
-                qCDebug(PLASMA_NM) << "Found VPN plugin" << service->name() << ", type:" << service->property("X-NetworkManager-Services", QVariant::String).toString();
 
-                NMVariantMapMap connection = vpnPlugin->importConnectionSettings(filename);
+        const QString serviceType = registry->serviceTypeForFile(filename);
+        VpnUiPlugin * vpnPlugin = serviceType.isEmpty() ? nullptr : registry->plugin(serviceType);
+        if (vpnPlugin) {
+            qCDebug(PLASMA_NM) << "Found VPN plugin" << registry->service(serviceType)->name() << ", type:" << serviceType;
 
-                // qCDebug(PLASMA_NM) << "Raw connection:" << connection;
+            NMVariantMapMap connection = vpnPlugin->importConnectionSettings(filename);
 
-                NetworkManager::ConnectionSettings connectionSettings;
-                connectionSettings.fromMap(connection);
-                connectionSettings.setUuid(NetworkManager::ConnectionSettings::createNewUuid());
+            // qCDebug(PLASMA_NM) << "Raw connection:" << connection;
 
-                // qCDebug(PLASMA_NM) << "Converted connection:" << connectionSettings;
+            NetworkManager::ConnectionSettings connectionSettings;
+            connectionSettings.fromMap(connection);
+            connectionSettings.setUuid(NetworkManager::ConnectionSettings::createNewUuid());
 
-                m_handler->addConnection(connectionSettings.toMap());
-                // qCDebug(PLASMA_NM) << "Adding imported connection under id:" << conId;
+            // qCDebug(PLASMA_NM) << "Converted connection:" << connectionSettings;
 
-                if (connection.isEmpty()) { // the "positive" part will arrive with connectionAdded
-                    // TODO display success
-                } else {
-                    delete vpnPlugin;
-                    break; // stop iterating over the plugins if the import produced at least some output
-                }
+            m_handler->addConnection(connectionSettings.toMap());
+            // qCDebug(PLASMA_NM) << "Adding imported connection under id:" << conId;
 
-                delete vpnPlugin;
+            if (connection.isEmpty()) { // the "positive" part will arrive with connectionAdded
+                // TODO display success
             }
         }
     }
 }
 
+void KCMNetworkmanagement::importVpnFiles(const QStringList &filenames)
+{
+    VpnUiPluginRegistry *registry = VpnUiPluginRegistry::self();
+
+    int imported = 0;
+    QStringList messages;
+    auto addImportedConnection = [this, &imported] (const NMVariantMapMap &connection) {
+        NetworkManager::ConnectionSettings connectionSettings;
+        connectionSettings.fromMap(connection);
+        connectionSettings.setUuid(NetworkManager::ConnectionSettings::createNewUuid());
+        m_handler->addConnection(connectionSettings.toMap());
+        ++imported;
+    };
+
+    // Every plugin gets all of its files at once, so it can import them together
+    QMap<QString, QStringList> filenamesByServiceType;
+    for (const QString &filename : filenames) {
+        const QString ext = QStringLiteral("*.") % QFileInfo(filename).suffix();
+        if (WireGuardInterfaceWidget::supportedFileExtensions().contains(ext)) {
+            const NMVariantMapMap connection = WireGuardInterfaceWidget::importConnectionSettings(filename);
+            if (!connection.isEmpty()) {
+                addImportedConnection(connection);
+                continue;
+            }
+        }
+
+        const QString serviceType = registry->serviceTypeForFile(filename);
+        if (serviceType.isEmpty() || !registry->plugin(serviceType)) {
+            messages << i18nc("@item file name and problem", "%1: %2", QFileInfo(filename).fileName(), i18n("Unsupported file type"));
+            continue;
+        }
+        filenamesByServiceType[serviceType] << filename;
+    }
+
+    for (auto it = filenamesByServiceType.constBegin(); it != filenamesByServiceType.constEnd(); ++it) {
+        qCDebug(PLASMA_NM) << "Importing" << it.value().size() << "VPN connections of type" << it.key();
+
+        const QList<NMVariantMapMap> connections = registry->plugin(it.key())->importConnections(it.value(), &messages);
+        for (const NMVariantMapMap &connection : connections) {
+            addImportedConnection(connection);
+        }
+    }
+
+    if (messages.isEmpty()) {
+        KMessageBox::information(this, i18np("Imported %1 VPN connection.", "Imported %1 VPN connections.", imported));
+    } else {
+        KMessageBox::informationList(this, i18n("Imported %1 of %2 VPN connections.", imported, filenames.size()), messages);
+    }
+}
+
 void KCMNetworkmanagement::resetSelection()
 {
     // Reset selected connections
@@ -51,6 +51,7 @@ private Q_SLOTS:
 private:
     void addConnection(const NetworkManager::ConnectionSettings::Ptr &connectionSettings);
     void importVpn();
+    void importVpnFiles(const QStringList &filenames);
     void kcmChanged(bool kcmChanged);
     void loadConnectionSettings(const NetworkManager::ConnectionSettings::Ptr &connectionSettings);
     void resetSelection();
@@ -33,6 +33,11 @@
 #include <NetworkManagerQt/Manager>
 #include <NetworkManagerQt/Utils>
 
+static QString bluetoothKey(const QByteArray &bdAddr, NetworkManager::BluetoothSetting::ProfileType profile)
+{
+    return NetworkManager::macAddressAsString(bdAddr) + QLatin1Char('/') + QString::number(profile);
+}
+
 BluetoothMonitor::BluetoothMonitor(QObject * parent)
     : QObject(parent)
 {
@@ -42,6 +47,78 @@ BluetoothMonitor::~BluetoothMonitor()
 {
 }
 
+void BluetoothMonitor::ensureIndex()
+{
+    if (m_indexed) {
+        return;
+    }
+    m_indexed = true;
+
+    for (const NetworkManager::Connection::Ptr &con : NetworkManager::listConnections()) {
+        indexConnection(con);
+    }
+
+    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionAdded, this, &BluetoothMonitor::connectionAdded);
+    connect(NetworkManager::settingsNotifier(), &NetworkManager::SettingsNotifier::connectionRemoved, this, &BluetoothMonitor::connectionRemoved);
+}
+
+void BluetoothMonitor::indexConnection(const NetworkManager::Connection::Ptr &connection)
+{
+    if (!connection) {
+        return;
+    }
+
+    connect(connection.data(), &NetworkManager::Connection::updated, this, &BluetoothMonitor::connectionUpdated, Qt::UniqueConnection);
+
+    if (!connection->settings() || connection->settings()->connectionType() != NetworkManager::ConnectionSettings::Bluetooth) {
+        return;
+    }
+
+    NetworkManager::BluetoothSetting::Ptr btSetting = connection->settings()->setting(NetworkManager::Setting::Bluetooth).staticCast<NetworkManager::BluetoothSetting>();
+    if (!btSetting) {
+        return;
+    }
+
+    const QString key = bluetoothKey(btSetting->bluetoothAddress(), btSetting->profileType());
+    m_connectionKeys.insert(connection->path(), key);
+    ++m_keyCount[key];
+}
+
+void BluetoothMonitor::unindexConnection(const QString &path)
+{
+    const auto it = m_connectionKeys.find(path);
+    if (it == m_connectionKeys.end()) {
+        return;
+    }
+
+    const auto countIt = m_keyCount.find(it.value());
+    if (countIt != m_keyCount.end() && --countIt.value() <= 0) {
+        m_keyCount.erase(countIt);
+    }
+    m_connectionKeys.erase(it);
+}
+
+void BluetoothMonitor::connectionAdded(const QString &path)
+{
+    indexConnection(NetworkManager::findConnection(path));
+}
+
+void BluetoothMonitor::connectionRemoved(const QString &path)
+{
+    unindexConnection(path);
+}
+
+void BluetoothMonitor::connectionUpdated()
+{
+    NetworkManager::Connection *connection = qobject_cast<NetworkManager::Connection*>(sender());
+    if (!connection) {
+        return;
+    }
+
+    unindexConnection(connection->path());
+    indexConnection(NetworkManager::findConnection(connection->path()));
+}
+
 bool BluetoothMonitor::bluetoothConnectionExists(const QString &bdAddr, const QString &service)
 {
     if (bdAddr.isEmpty() || service.isEmpty()) {
@@ -58,16 +135,9 @@ bool BluetoothMonitor::bluetoothConnectionExists(const QString &bdAddr, const QS
         return false;
     }
 
-    for (const NetworkManager::Connection::Ptr &con : NetworkManager::listConnections()) {
-        if (con && con->settings() && con->settings()->connectionType() == NetworkManager::ConnectionSettings::Bluetooth) {
-            NetworkManager::BluetoothSetting::Ptr btSetting = con->settings()->setting(NetworkManager::Setting::Bluetooth).staticCast<NetworkManager::BluetoothSetting>();
-            if (btSetting->profileType() == profile && btSetting->bluetoothAddress() == NetworkManager::macAddressFromString(bdAddr)) {
-                return true;
-            }
-        }
-    }
+    ensureIndex();
 
-    return false;
+    return m_keyCount.contains(bluetoothKey(NetworkManager::macAddressFromString(bdAddr), profile));
 }
 
 void BluetoothMonitor::addBluetoothConnection(const QString &bdAddr, const QString &service, const QString &connectionName)
@@ -103,7 +173,7 @@ void BluetoothMonitor::addBluetoothConnection(const QString &bdAddr, const QStri
 #if WITH_MODEMMANAGER_SUPPORT
     else if (service == QLatin1String("dun")) {
         QPointer<MobileConnectionWizard> mobileConnectionWizard = new MobileConnectionWizard(NetworkManager::ConnectionSettings::Bluetooth);
-        connect(mobileConnectionWizard.data(), &MobileConnectionWizard::accepted,
+        connect(mobileConnectionWizard.data(), &MobileConnectionWizard::accepted, this,
                 [bdAddr, connectionName, mobileConnectionWizard, this] () {
                     if (mobileConnectionWizard->getError() == MobileProviders::Success) {
                         qCDebug(PLASMA_NM) << "Mobile broadband wizard finished:" << mobileConnectionWizard->type() << mobileConnectionWizard->args();
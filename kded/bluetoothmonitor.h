@@ -28,8 +28,11 @@
 #include <ModemManagerQt/manager.h>
 #endif
 
+#include <QHash>
 #include <QObject>
 
+#include <NetworkManagerQt/Connection>
+
 class BluetoothMonitor: public QObject
 {
 Q_OBJECT
@@ -39,5 +42,20 @@ public:
 
     bool bluetoothConnectionExists(const QString &bdAddr, const QString &service);
     void addBluetoothConnection(const QString &bdAddr, const QString &service, const QString &connectionName);
+
+private Q_SLOTS:
+    void connectionAdded(const QString &path);
+    void connectionRemoved(const QString &path);
+    void connectionUpdated();
+
+private:
+    void ensureIndex();
+    void indexConnection(const NetworkManager::Connection::Ptr &connection);
+    void unindexConnection(const QString &path);
+
+    // Bluetooth connections indexed by "<bdaddr>/<profile>", filled on first use
+    bool m_indexed = false;
+    QHash<QString, QString> m_connectionKeys; // connection path -> key
+    QHash<QString, int> m_keyCount;
 };
 #endif
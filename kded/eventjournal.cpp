@@ -0,0 +1,354 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "eventjournal.h"
+#include "debug.h"
+
+#include <KConfigGroup>
+#include <KSharedConfig>
+
+#include <QDateTime>
+#include <QDBusConnection>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <cstring>
+
+static_assert(sizeof(EventJournal::Record) == 64, "EventJournal::Record must stay 64 bytes large");
+
+namespace
+{
+const char journalMagic[4] = {'P', 'N', 'M', 'J'};
+const quint32 journalVersion = 1;
+const quint32 defaultCapacity = 65536; // 4 MiB worth of records
+
+struct Header {
+    char magic[4];
+    quint32 version;
+    quint32 capacity;
+    quint32 head;
+    quint32 count;
+    quint8 reserved[44];
+};
+static_assert(sizeof(Header) == 64, "Journal header must stay 64 bytes large");
+}
+
+class EventJournalWriter : public QObject
+{
+    Q_OBJECT
+public:
+    EventJournalWriter(const QString &fileName, quint32 capacity)
+        : m_file(fileName)
+        , m_capacity(capacity)
+    {
+    }
+
+    void open()
+    {
+        QDir().mkpath(QFileInfo(m_file).absolutePath());
+
+        if (!m_file.open(QIODevice::ReadWrite)) {
+            qCWarning(PLASMA_NM) << "Failed to open event journal" << m_file.fileName() << m_file.errorString();
+            return;
+        }
+
+        const qint64 expectedSize = sizeof(Header) + qint64(m_capacity) * sizeof(EventJournal::Record);
+        bool valid = m_file.size() == expectedSize;
+        if (valid) {
+            Header header;
+            valid = m_file.read(reinterpret_cast<char *>(&header), sizeof(Header)) == sizeof(Header) &&
+                    memcmp(header.magic, journalMagic, sizeof(journalMagic)) == 0 &&
+                    header.version == journalVersion &&
+                    header.capacity == m_capacity &&
+                    header.head < m_capacity &&
+                    header.count <= m_capacity;
+        }
+
+        if (!valid) {
+            qCDebug(PLASMA_NM) << "Creating new event journal" << m_file.fileName() << "with capacity" << m_capacity;
+            if (!m_file.resize(0) || !m_file.resize(expectedSize)) {
+                qCWarning(PLASMA_NM) << "Failed to resize event journal" << m_file.errorString();
+                m_file.close();
+                return;
+            }
+        }
+
+        uchar *map = m_file.map(0, expectedSize);
+        if (!map) {
+            qCWarning(PLASMA_NM) << "Failed to map event journal" << m_file.errorString();
+            m_file.close();
+            return;
+        }
+
+        m_header = reinterpret_cast<Header *>(map);
+        m_records = reinterpret_cast<EventJournal::Record *>(map + sizeof(Header));
+
+        if (!valid) {
+            memset(m_header, 0, sizeof(Header));
+            memcpy(m_header->magic, journalMagic, sizeof(journalMagic));
+            m_header->version = journalVersion;
+            m_header->capacity = m_capacity;
+        } else {
+            // Events recorded while the clock was ahead would keep later ones from sorting after them
+            discardNewerThan(QDateTime::currentMSecsSinceEpoch());
+        }
+    }
+
+    void append(const EventJournal::Record &record)
+    {
+        if (!m_header) {
+            return;
+        }
+
+        // Keep the journal sorted if the wall clock went backwards, without
+        // stamping every following event with the time of the clock that was ahead
+        discardNewerThan(record.timestamp);
+
+        // Write the record before publishing it in the header so an interrupted
+        // write never exposes a half written slot
+        m_records[m_header->head] = record;
+        m_header->head = (m_header->head + 1) % m_capacity;
+        m_header->count = qMin(m_header->count + 1, m_capacity);
+    }
+
+    QByteArray query(qint64 from, qint64 to, const QByteArray &device, const QByteArray &uuid) const
+    {
+        QByteArray result;
+        if (!m_header || !m_header->count || from > to) {
+            return result;
+        }
+
+        const quint32 count = m_header->count;
+        const quint32 first = (m_header->head + m_capacity - count) % m_capacity;
+        auto recordAt = [this, first] (quint32 index) -> const EventJournal::Record & {
+            return m_records[(first + index) % m_capacity];
+        };
+
+        // Timestamps are kept monotonic on insertion, so the ring is sorted
+        quint32 low = 0;
+        quint32 high = count;
+        while (low < high) {
+            const quint32 middle = low + (high - low) / 2;
+            if (recordAt(middle).timestamp < from) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        for (quint32 i = low; i < count; ++i) {
+            const EventJournal::Record &record = recordAt(i);
+            if (record.timestamp > to) {
+                break;
+            }
+            if (!device.isEmpty() && strncmp(record.device, device.constData(), sizeof(record.device)) != 0) {
+                continue;
+            }
+            if (!uuid.isEmpty() && memcmp(record.uuid, uuid.constData(), sizeof(record.uuid)) != 0) {
+                continue;
+            }
+            result.append(reinterpret_cast<const char *>(&record), sizeof(EventJournal::Record));
+        }
+
+        return result;
+    }
+
+private:
+    void discardNewerThan(qint64 timestamp)
+    {
+        quint32 discarded = 0;
+        while (m_header->count && m_records[(m_header->head + m_capacity - 1) % m_capacity].timestamp > timestamp) {
+            m_header->head = (m_header->head + m_capacity - 1) % m_capacity;
+            m_header->count--;
+            discarded++;
+        }
+
+        if (discarded) {
+            qCDebug(PLASMA_NM) << "Discarded" << discarded << "events of the event journal recorded after" << QDateTime::fromMSecsSinceEpoch(timestamp);
+        }
+    }
+
+    QFile m_file;
+    const quint32 m_capacity;
+    Header *m_header = nullptr;
+    EventJournal::Record *m_records = nullptr;
+};
+
+EventJournal::EventJournal(QObject *parent)
+    : QObject(parent)
+{
+    KSharedConfigPtr config = KSharedConfig::openConfig(QLatin1String("plasma-nm"));
+    KConfigGroup grp(config, QLatin1String("General"));
+    const quint32 capacity = qMax(1u, grp.readEntry(QLatin1String("EventJournalCapacity"), defaultCapacity));
+
+    m_fileName = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1String("/plasma-nm/eventjournal");
+    m_capacity = capacity;
+
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        addDevice(device);
+    }
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::deviceAdded, this, [this] (const QString &uni) {
+        NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(uni);
+        if (device) {
+            addDevice(device);
+        }
+    });
+
+    for (const NetworkManager::ActiveConnection::Ptr &ac : NetworkManager::activeConnections()) {
+        addActiveConnection(ac);
+    }
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionAdded, this, [this] (const QString &path) {
+        NetworkManager::ActiveConnection::Ptr ac = NetworkManager::findActiveConnection(path);
+        if (ac && ac->isValid()) {
+            addActiveConnection(ac);
+            append(ac->vpn() ? VpnConnectionStateChanged : ActiveConnectionStateChanged,
+                   QString(), ac->uuid(), ac->state());
+        }
+    });
+
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::connectivityChanged, this, [this] (NetworkManager::Connectivity connectivity) {
+        append(ConnectivityChanged, QString(), QString(), connectivity);
+    });
+
+    QDBusConnection::systemBus().connect(QStringLiteral("org.freedesktop.login1"),
+                                         QStringLiteral("/org/freedesktop/login1"),
+                                         QStringLiteral("org.freedesktop.login1.Manager"),
+                                         QStringLiteral("PrepareForSleep"),
+                                         this,
+                                         SLOT(onPrepareForSleep(bool)));
+}
+
+EventJournal::EventJournal(const QString &fileName, quint32 capacity, QObject *parent)
+    : QObject(parent)
+    , m_fileName(fileName)
+    , m_capacity(qMax(1u, capacity))
+{
+}
+
+EventJournalWriter *EventJournal::writer() const
+{
+    // The file is only mapped once there is something to record or to look up
+    if (!m_writer) {
+        m_writer = new EventJournalWriter(m_fileName, m_capacity);
+        m_writer->moveToThread(&m_writerThread);
+        connect(&m_writerThread, &QThread::finished, m_writer, &QObject::deleteLater);
+        m_writerThread.setObjectName(QStringLiteral("EventJournalWriter"));
+        m_writerThread.start(QThread::LowPriority);
+
+        EventJournalWriter *writer = m_writer;
+        QMetaObject::invokeMethod(m_writer, [writer] () { writer->open(); }, Qt::QueuedConnection);
+    }
+
+    return m_writer;
+}
+
+EventJournal::~EventJournal()
+{
+    m_writerThread.quit();
+    m_writerThread.wait();
+}
+
+QByteArray EventJournal::events(qint64 from, qint64 to, const QString &device, const QString &uuid) const
+{
+    const QByteArray deviceFilter = device.toUtf8().left(sizeof(Record::device) - 1);
+    const QUuid uuidFilter(uuid);
+    // An invalid UUID would otherwise match every record without one
+    if (!uuid.isEmpty() && uuidFilter.isNull()) {
+        qCWarning(PLASMA_NM) << "Invalid UUID to filter the event journal by" << uuid;
+        return QByteArray();
+    }
+    const QByteArray rawUuidFilter = uuid.isEmpty() ? QByteArray() : uuidFilter.toRfc4122();
+
+    QByteArray result;
+    EventJournalWriter *writer = this->writer();
+    // Run on the writer thread so the query sees every event appended before it
+    QMetaObject::invokeMethod(writer, [=] () {
+        return writer->query(from, to, deviceFilter, rawUuidFilter);
+    }, Qt::BlockingQueuedConnection, &result);
+
+    return result;
+}
+
+void EventJournal::addDevice(const NetworkManager::Device::Ptr &device)
+{
+    NetworkManager::Device *dev = device.data();
+    connect(dev, &NetworkManager::Device::stateChanged, this, [this, dev] (NetworkManager::Device::State newstate, NetworkManager::Device::State oldstate, NetworkManager::Device::StateChangeReason reason) {
+        const NetworkManager::ActiveConnection::Ptr ac = dev->activeConnection();
+        append(DeviceStateChanged, dev->interfaceName(), ac ? ac->uuid() : QString(), newstate, oldstate, reason);
+    });
+}
+
+void EventJournal::addActiveConnection(const NetworkManager::ActiveConnection::Ptr &ac)
+{
+    QString device;
+    const QStringList devices = ac->devices();
+    if (!devices.isEmpty()) {
+        const NetworkManager::Device::Ptr dev = NetworkManager::findNetworkInterface(devices.first());
+        if (dev) {
+            device = dev->interfaceName();
+        }
+    }
+    const QString uuid = ac->uuid();
+
+    if (ac->vpn()) {
+        NetworkManager::VpnConnection::Ptr vpnConnection = ac.objectCast<NetworkManager::VpnConnection>();
+        connect(vpnConnection.data(), &NetworkManager::VpnConnection::stateChanged, this, [this, device, uuid] (NetworkManager::VpnConnection::State state, NetworkManager::VpnConnection::StateChangeReason reason) {
+            append(VpnConnectionStateChanged, device, uuid, state, 0, reason);
+        });
+    } else {
+        connect(ac.data(), &NetworkManager::ActiveConnection::stateChanged, this, [this, device, uuid] (NetworkManager::ActiveConnection::State state) {
+            append(ActiveConnectionStateChanged, device, uuid, state);
+        });
+    }
+}
+
+void EventJournal::onPrepareForSleep(bool sleep)
+{
+    append(sleep ? PrepareForSleep : Resumed, QString(), QString(), sleep);
+}
+
+void EventJournal::append(EventType type, const QString &device, const QString &uuid, uint newState, uint oldState, uint reason)
+{
+    Record record;
+    memset(&record, 0, sizeof(Record));
+
+    // If the clock went backwards, the writer drops the events recorded after this time
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.type = type;
+    record.newState = newState;
+    record.oldState = oldState;
+    record.reason = reason;
+
+    const QByteArray deviceName = device.toUtf8().left(sizeof(record.device) - 1);
+    memcpy(record.device, deviceName.constData(), deviceName.size());
+
+    if (!uuid.isEmpty()) {
+        const QByteArray rawUuid = QUuid(uuid).toRfc4122();
+        memcpy(record.uuid, rawUuid.constData(), qMin<int>(rawUuid.size(), sizeof(record.uuid)));
+    }
+
+    EventJournalWriter *writer = this->writer();
+    QMetaObject::invokeMethod(writer, [writer, record] () { writer->append(record); }, Qt::QueuedConnection);
+}
+
+#include "eventjournal.moc"
@@ -0,0 +1,105 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_EVENT_JOURNAL_H
+#define PLASMA_NM_EVENT_JOURNAL_H
+
+#include <QObject>
+#include <QThread>
+
+#include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/Manager>
+#include <NetworkManagerQt/VpnConnection>
+
+class EventJournalWriter;
+
+/**
+ * Append-only journal of network events kept in a size-capped ring file.
+ *
+ * Every record has a fixed size (see EventJournal::Record), so the file can be
+ * searched by time with a binary search and filtered ranges are returned as a
+ * packed array of records without any further serialization. The file is
+ * opened with the first event or query.
+ */
+class EventJournal : public QObject
+{
+    Q_OBJECT
+public:
+    enum EventType {
+        DeviceStateChanged = 1,
+        ActiveConnectionStateChanged,
+        VpnConnectionStateChanged,
+        ConnectivityChanged,
+        PrepareForSleep,
+        Resumed
+    };
+    Q_ENUM(EventType)
+
+    /**
+     * On-disk layout of a single event, in host byte order.
+     * @p device is the NUL padded interface name, @p uuid the RFC 4122
+     * representation of the connection UUID (all zeros when not applicable).
+     */
+    struct Record {
+        qint64 timestamp;
+        quint8 type;
+        quint8 reserved[3];
+        quint32 newState;
+        quint32 oldState;
+        quint32 reason;
+        char device[16];
+        uchar uuid[16];
+        quint8 padding[8];
+    };
+
+    explicit EventJournal(QObject *parent = nullptr);
+    /**
+     * Uses the journal in @p fileName without recording any events on its own,
+     * only what is passed to append().
+     */
+    EventJournal(const QString &fileName, quint32 capacity, QObject *parent = nullptr);
+    ~EventJournal() override;
+
+    /**
+     * Returns packed Records with @p from <= timestamp <= @p to (milliseconds since epoch),
+     * optionally restricted to the given interface name and/or connection UUID.
+     * Nothing is returned for a @p uuid which is not a valid UUID.
+     */
+    QByteArray events(qint64 from, qint64 to, const QString &device, const QString &uuid) const;
+
+    void append(EventType type, const QString &device, const QString &uuid, uint newState, uint oldState = 0, uint reason = 0);
+
+private Q_SLOTS:
+    void addDevice(const NetworkManager::Device::Ptr &device);
+    void addActiveConnection(const NetworkManager::ActiveConnection::Ptr &ac);
+    void onPrepareForSleep(bool sleep);
+
+private:
+    EventJournalWriter *writer() const;
+
+    QString m_fileName;
+    quint32 m_capacity = 0;
+    mutable QThread m_writerThread;
+    mutable EventJournalWriter *m_writer = nullptr;
+};
+
+Q_DECLARE_TYPEINFO(EventJournal::Record, Q_PRIMITIVE_TYPE);
+
+#endif // PLASMA_NM_EVENT_JOURNAL_H
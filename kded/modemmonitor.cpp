@@ -24,6 +24,7 @@
 #include "modemmonitor.h"
 
 #include <QDBusPendingReply>
+#include <QPointer>
 
 #include <KConfigGroup>
 #include <KLocalizedString>
@@ -71,6 +72,20 @@ ModemMonitor::~ModemMonitor()
     delete d_ptr;
 }
 
+bool ModemMonitor::isUnlocking() const
+{
+    Q_D(const ModemMonitor);
+    return d->dialog;
+}
+
+void ModemMonitor::cancelUnlock()
+{
+    Q_D(ModemMonitor);
+    if (d->dialog) {
+        d->dialog->reject();
+    }
+}
+
 void ModemMonitor::unlockModem(const QString &modemUni)
 {
     Q_D(ModemMonitor);
@@ -105,7 +120,8 @@ void ModemMonitor::requestPin(MMModemLock lock)
         return;
     }
 
-    ModemManager::Modem *modem = qobject_cast<ModemManager::Modem *>(sender());
+    // The modem may go away while the dialog is open
+    QPointer<ModemManager::Modem> modem = qobject_cast<ModemManager::Modem *>(sender());
     if (!modem) {
         return;
     }
@@ -147,7 +163,7 @@ void ModemMonitor::requestPin(MMModemLock lock)
         d->dialog = QPointer<PinDialog>(new PinDialog(modem, PinDialog::ModemNetworkSubsetPuk));
     }
 
-    if (d->dialog.data()->exec() != QDialog::Accepted) {
+    if (d->dialog.data()->exec() != QDialog::Accepted || !d->dialog || !modem) {
         goto OUT;
     }
 
@@ -161,7 +177,7 @@ void ModemMonitor::requestPin(MMModemLock lock)
         }
 
         if (!sim) {
-            return;
+            goto OUT;
         }
 
         QDBusPendingCallWatcher *watcher = nullptr;
@@ -190,6 +206,8 @@ OUT:
         d->dialog.data()->deleteLater();
     }
     d->dialog.clear();
+
+    Q_EMIT unlockFinished();
 }
 
 void ModemMonitor::onSendPinArrived(QDBusPendingCallWatcher * watcher)
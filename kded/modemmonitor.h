@@ -42,8 +42,20 @@ public:
     explicit ModemMonitor(QObject * parent);
     ~ModemMonitor() override;
 
+    /**
+     * Whether a PIN dialog is open. The monitor must not be destroyed then,
+     * wait for unlockFinished() instead.
+     */
+    bool isUnlocking() const;
+    /**
+     * Rejects the open PIN dialog, if any.
+     */
+    void cancelUnlock();
+
 public Q_SLOTS:
     void unlockModem(const QString &modemUni);
+Q_SIGNALS:
+    void unlockFinished();
 private Q_SLOTS:
     void requestPin(MMModemLock lock);
     void onSendPinArrived(QDBusPendingCallWatcher *);
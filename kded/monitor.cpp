@@ -20,16 +20,25 @@
 
 
 #include "monitor.h"
+#include "debug.h"
 
 #include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+
+#if WITH_MODEMMANAGER_SUPPORT
+#include <ModemManagerQt/Manager>
+#endif
 
 Monitor::Monitor(QObject* parent)
     : QObject(parent)
 {
+    watchService(QStringLiteral("org.bluez"), &Monitor::bluetoothServiceRegistered, &Monitor::bluetoothServiceUnregistered);
 #if WITH_MODEMMANAGER_SUPPORT
-    m_modemMonitor = new ModemMonitor(this);
+    watchService(QStringLiteral("org.freedesktop.ModemManager1"), &Monitor::modemManagerServiceRegistered, &Monitor::modemManagerServiceUnregistered);
 #endif
-    m_bluetoothMonitor = new BluetoothMonitor(this);
 
     QDBusConnection::sessionBus().registerService("org.kde.plasmanetworkmanagement");
     QDBusConnection::sessionBus().registerObject("/org/kde/plasmanetworkmanagement", this, QDBusConnection::ExportScriptableContents);
@@ -43,20 +52,121 @@ Monitor::~Monitor()
 #endif
 }
 
+void Monitor::watchService(const QString &service, void (Monitor::*registered)(), void (Monitor::*unregistered)())
+{
+    QDBusServiceWatcher *watcher = new QDBusServiceWatcher(service, QDBusConnection::systemBus(),
+                                                           QDBusServiceWatcher::WatchForRegistration | QDBusServiceWatcher::WatchForUnregistration, this);
+    connect(watcher, &QDBusServiceWatcher::serviceRegistered, this, registered);
+    connect(watcher, &QDBusServiceWatcher::serviceUnregistered, this, unregistered);
+
+    // Don't block the session startup on the bus, ask asynchronously whether the service is already running
+    QDBusPendingCall call = QDBusConnection::systemBus().interface()->asyncCall(QStringLiteral("NameHasOwner"), service);
+    QDBusPendingCallWatcher *callWatcher = new QDBusPendingCallWatcher(call, this);
+    connect(callWatcher, &QDBusPendingCallWatcher::finished, this, [this, registered] (QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<bool> reply = *watcher;
+        if (reply.isValid() && reply.value()) {
+            (this->*registered)();
+        }
+        watcher->deleteLater();
+    });
+}
+
+BluetoothMonitor *Monitor::bluetoothMonitor()
+{
+    if (!m_bluetoothMonitor) {
+        m_bluetoothMonitor = new BluetoothMonitor(this);
+    }
+
+    return m_bluetoothMonitor;
+}
+
+void Monitor::bluetoothServiceRegistered()
+{
+    qCDebug(PLASMA_NM) << "BlueZ appeared, creating Bluetooth monitor";
+    bluetoothMonitor();
+}
+
+void Monitor::bluetoothServiceUnregistered()
+{
+    qCDebug(PLASMA_NM) << "BlueZ disappeared, destroying Bluetooth monitor";
+    delete m_bluetoothMonitor;
+    m_bluetoothMonitor = nullptr;
+}
+
 bool Monitor::bluetoothConnectionExists(const QString &bdAddr, const QString &service)
 {
-    return m_bluetoothMonitor->bluetoothConnectionExists(bdAddr, service);
+    return bluetoothMonitor()->bluetoothConnectionExists(bdAddr, service);
 }
 
 void Monitor::addBluetoothConnection(const QString &bdAddr, const QString &service, const QString &connectionName)
 {
-    m_bluetoothMonitor->addBluetoothConnection(bdAddr, service, connectionName);
+    bluetoothMonitor()->addBluetoothConnection(bdAddr, service, connectionName);
 }
 
 #if WITH_MODEMMANAGER_SUPPORT
+ModemMonitor *Monitor::modemMonitor()
+{
+    if (!m_modemMonitor) {
+        m_modemMonitor = new ModemMonitor(this);
+    }
+
+    return m_modemMonitor;
+}
+
+void Monitor::modemManagerServiceRegistered()
+{
+    connect(ModemManager::notifier(), &ModemManager::Notifier::modemAdded, this, &Monitor::modemAdded, Qt::UniqueConnection);
+    connect(ModemManager::notifier(), &ModemManager::Notifier::modemRemoved, this, &Monitor::modemRemoved, Qt::UniqueConnection);
+
+    if (!ModemManager::modemDevices().isEmpty()) {
+        modemAdded();
+    }
+}
+
+void Monitor::modemManagerServiceUnregistered()
+{
+    if (m_modemMonitor) {
+        qCDebug(PLASMA_NM) << "ModemManager disappeared, destroying modem monitor";
+        releaseModemMonitor();
+    }
+}
+
+void Monitor::modemAdded()
+{
+    if (!m_modemMonitor) {
+        qCDebug(PLASMA_NM) << "Modem appeared, creating modem monitor";
+        modemMonitor();
+    }
+}
+
+void Monitor::modemRemoved()
+{
+    if (m_modemMonitor && ModemManager::modemDevices().isEmpty()) {
+        qCDebug(PLASMA_NM) << "No modem left, destroying modem monitor";
+        releaseModemMonitor();
+    }
+}
+
+void Monitor::releaseModemMonitor()
+{
+    ModemMonitor *modemMonitor = m_modemMonitor;
+    m_modemMonitor = nullptr;
+
+    // A new monitor takes over if a modem appears again
+    disconnect(ModemManager::notifier(), nullptr, modemMonitor, nullptr);
+
+    // requestPin() still runs the nested event loop of an open PIN dialog, only delete once it returned
+    if (modemMonitor->isUnlocking()) {
+        connect(modemMonitor, &ModemMonitor::unlockFinished, modemMonitor, &QObject::deleteLater);
+        modemMonitor->cancelUnlock();
+    } else {
+        modemMonitor->deleteLater();
+    }
+}
+
 void Monitor::unlockModem(const QString& modem)
 {
     qDebug() << "unlocking " << modem;
-    m_modemMonitor->unlockModem(modem);
+    modemMonitor()->unlockModem(modem);
 }
 #endif
@@ -43,10 +43,27 @@ public Q_SLOTS:
 #if WITH_MODEMMANAGER_SUPPORT
     Q_SCRIPTABLE void unlockModem(const QString &modem);
 #endif
+
+private Q_SLOTS:
+    void bluetoothServiceRegistered();
+    void bluetoothServiceUnregistered();
+#if WITH_MODEMMANAGER_SUPPORT
+    void modemManagerServiceRegistered();
+    void modemManagerServiceUnregistered();
+    void modemAdded();
+    void modemRemoved();
+#endif
+
 private:
-    BluetoothMonitor * m_bluetoothMonitor;
+    // Submonitors only exist while BlueZ / a modem is around
+    BluetoothMonitor *bluetoothMonitor();
+    void watchService(const QString &service, void (Monitor::*registered)(), void (Monitor::*unregistered)());
+
+    BluetoothMonitor * m_bluetoothMonitor = nullptr;
 #if WITH_MODEMMANAGER_SUPPORT
-    ModemMonitor * m_modemMonitor;
+    ModemMonitor *modemMonitor();
+    void releaseModemMonitor();
+    ModemMonitor * m_modemMonitor = nullptr;
 #endif
 };
 
@@ -379,8 +379,8 @@ void Notification::onActiveConnectionStateChanged(NetworkManager::ActiveConnecti
     if (state == NetworkManager::ActiveConnection::Activated) {
         auto foundConnection = std::find_if(m_activeConnectionsBeforeSleep.constBegin(),
                                             m_activeConnectionsBeforeSleep.constEnd(),
-                                            [ac](const QString &uuid) {
-            return uuid == ac->uuid();
+                                            [ac](const NetworkManager::ActiveConnection::Ptr &connection) {
+            return connection->uuid() == ac->uuid();
         });
 
         if (foundConnection != m_activeConnectionsBeforeSleep.constEnd()) {
@@ -552,7 +552,7 @@ void Notification::onPrepareForSleep(bool sleep)
         const auto &connections = NetworkManager::activeConnections();
         for (const auto &connection : connections) {
             if (!connection->vpn() && connection->state() == NetworkManager::ActiveConnection::State::Activated) {
-                m_activeConnectionsBeforeSleep << connection->uuid();
+                m_activeConnectionsBeforeSleep << connection;
             }
         }
     } else {
@@ -565,6 +565,8 @@ void Notification::onPrepareForSleep(bool sleep)
 
         m_checkActiveConnectionOnResumeTimer->start();
     }
+
+    Q_EMIT prepareForSleep(sleep, m_activeConnectionsBeforeSleep);
 }
 
 void Notification::onCheckActiveConnectionOnResume()
@@ -38,6 +38,13 @@ class Notification : public QObject
 public:
     explicit Notification(QObject *parent = nullptr);
 
+Q_SIGNALS:
+    /**
+     * Forwards logind's PrepareForSleep, @p sleep is false on resume.
+     * @p activeConnections are the activated non-VPN connections before the suspend.
+     */
+    void prepareForSleep(bool sleep, const NetworkManager::ActiveConnection::List &activeConnections);
+
 private Q_SLOTS:
     void deviceAdded(const QString &uni);
     void addDevice(const NetworkManager::Device::Ptr &device);
@@ -57,7 +64,7 @@ private:
     QHash<QString, KNotification*> m_notifications;
 
     bool m_preparingForSleep = false;
-    QStringList m_activeConnectionsBeforeSleep;
+    NetworkManager::ActiveConnection::List m_activeConnectionsBeforeSleep;
     QTimer *m_checkActiveConnectionOnResumeTimer = nullptr;
 
 };
@@ -25,12 +25,12 @@
 #include "uiutils.h"
 
 #include <vpnuiplugin.h>
+#include <vpnuipluginregistry.h>
 
 #include <NetworkManagerQt/WirelessSetting>
 #include <NetworkManagerQt/VpnSetting>
 #include <NetworkManagerQt/Utils>
 
-#include <KServiceTypeTrader>
 #include <KLocalizedString>
 
 #include <QIcon>
@@ -130,10 +130,8 @@ void PasswordDialog::initializeUi()
             VpnUiPlugin *vpnUiPlugin;
             QString error;
             const QString serviceType = vpnSetting->serviceType();
-            vpnUiPlugin = KServiceTypeTrader::createInstanceFromQuery<VpnUiPlugin>(QLatin1String("PlasmaNetworkManagement/VpnUiPlugin"),
-                                                                                   QString::fromLatin1("[X-NetworkManager-Services]=='%1'").arg(serviceType),
-                                                                                   this, QVariantList(), &error);
-            if (vpnUiPlugin && error.isEmpty()) {
+            vpnUiPlugin = VpnUiPluginRegistry::self()->plugin(serviceType, &error);
+            if (vpnUiPlugin) {
                 const QString shortName = serviceType.section('.', -1);
                 NMStringMap data = vpnSetting->data();
                 // If we have hints, make the user have them through the widget
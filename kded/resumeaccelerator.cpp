@@ -0,0 +1,236 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "resumeaccelerator.h"
+#include "debug.h"
+
+#include <KConfigGroup>
+#include <KSharedConfig>
+
+#include <NetworkManagerQt/ActiveConnection>
+#include <NetworkManagerQt/Manager>
+#include <NetworkManagerQt/WirelessSetting>
+
+// Leave it to NetworkManager if the network did not show up by then
+static const int giveUpTimeout = 30000;
+
+ResumeAccelerator::ResumeAccelerator(QObject *parent)
+    : QObject(parent)
+{
+    m_giveUpTimer.setSingleShot(true);
+    m_giveUpTimer.setInterval(giveUpTimeout);
+    connect(&m_giveUpTimer, &QTimer::timeout, this, &ResumeAccelerator::finish);
+}
+
+void ResumeAccelerator::onPrepareForSleep(bool sleep, const NetworkManager::ActiveConnection::List &activeConnections)
+{
+    if (sleep) {
+        finish();
+
+        // Already restricted to activated connections other than VPNs
+        for (const NetworkManager::ActiveConnection::Ptr &ac : activeConnections) {
+            if (ac->type() != NetworkManager::ConnectionSettings::Wireless || ac->devices().isEmpty()) {
+                continue;
+            }
+
+            // The connection is gone while the active connection is being torn down
+            const NetworkManager::Connection::Ptr connection = ac->connection();
+            if (!connection) {
+                continue;
+            }
+
+            NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->settings()->setting(NetworkManager::Setting::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
+            if (!wirelessSetting || wirelessSetting->ssid().isEmpty()) {
+                continue;
+            }
+
+            PendingReconnect pending;
+            pending.uuid = ac->uuid();
+            pending.connectionPath = connection->path();
+            pending.deviceUni = ac->devices().first();
+            pending.ssid = wirelessSetting->ssid();
+            m_pending << pending;
+        }
+        return;
+    }
+
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    // Keep measuring with the accelerator disabled, that gives the autoconnect baseline
+    KSharedConfigPtr config = KSharedConfig::openConfig(QLatin1String("plasma-nm"));
+    KConfigGroup grp(config, QLatin1String("General"));
+    m_accelerate = grp.readEntry(QLatin1String("FastReconnectOnResume"), true);
+
+    m_sinceResume.start();
+    m_giveUpTimer.start();
+
+    QStringList devices;
+    for (const PendingReconnect &pending : qAsConst(m_pending)) {
+        if (!devices.contains(pending.deviceUni)) {
+            devices << pending.deviceUni;
+        }
+    }
+
+    for (const QString &uni : qAsConst(devices)) {
+        NetworkManager::WirelessDevice::Ptr device = NetworkManager::findNetworkInterface(uni).objectCast<NetworkManager::WirelessDevice>();
+        if (!device) {
+            continue;
+        }
+
+        m_devices << uni;
+        connect(device.data(), &NetworkManager::Device::stateChanged, this, &ResumeAccelerator::onDeviceStateChanged, Qt::UniqueConnection);
+        if (m_accelerate) {
+            connect(device.data(), &NetworkManager::WirelessDevice::accessPointAppeared, this, &ResumeAccelerator::onAccessPointAppeared, Qt::UniqueConnection);
+            requestScan(device);
+        }
+    }
+}
+
+void ResumeAccelerator::requestScan(const NetworkManager::WirelessDevice::Ptr &device)
+{
+    // NetworkManager may still be waking up, scan once the device becomes available
+    if (device->state() < NetworkManager::Device::Disconnected) {
+        return;
+    }
+
+    QList<QByteArray> ssids;
+    for (const PendingReconnect &pending : qAsConst(m_pending)) {
+        if (pending.deviceUni == device->uni() && !ssids.contains(pending.ssid)) {
+            ssids << pending.ssid;
+        }
+    }
+
+    if (ssids.isEmpty()) {
+        return;
+    }
+
+    qCDebug(PLASMA_NM) << "Requesting targeted scan on resume for" << ssids;
+    device->requestScan({{QStringLiteral("ssids"), QVariant::fromValue(ssids)}});
+
+    // Access points may still be known from before the suspend
+    tryActivate(device);
+}
+
+void ResumeAccelerator::tryActivate(const NetworkManager::WirelessDevice::Ptr &device)
+{
+    // NetworkManager is already connecting this device, let it finish
+    if (device->state() >= NetworkManager::Device::Preparing && device->state() <= NetworkManager::Device::Activated) {
+        return;
+    }
+
+    for (PendingReconnect &pending : m_pending) {
+        if (pending.deviceUni != device->uni() || pending.activationRequested) {
+            continue;
+        }
+
+        const NetworkManager::WirelessNetwork::Ptr network = device->findNetwork(QString::fromUtf8(pending.ssid));
+        if (!network || !network->referenceAccessPoint()) {
+            continue;
+        }
+
+        qCDebug(PLASMA_NM) << "Reactivating" << pending.uuid << "after" << m_sinceResume.elapsed() << "ms since resume";
+        pending.activationRequested = true;
+        NetworkManager::activateConnection(pending.connectionPath, device->uni(), network->referenceAccessPoint()->uni());
+        // Only one connection per device can be active
+        return;
+    }
+}
+
+void ResumeAccelerator::onAccessPointAppeared()
+{
+    NetworkManager::WirelessDevice *device = qobject_cast<NetworkManager::WirelessDevice*>(sender());
+    if (!device) {
+        return;
+    }
+
+    tryActivate(NetworkManager::findNetworkInterface(device->uni()).objectCast<NetworkManager::WirelessDevice>());
+}
+
+void ResumeAccelerator::onDeviceStateChanged(NetworkManager::Device::State newstate, NetworkManager::Device::State oldstate, NetworkManager::Device::StateChangeReason reason)
+{
+    Q_UNUSED(oldstate);
+    Q_UNUSED(reason);
+
+    NetworkManager::Device *dev = qobject_cast<NetworkManager::Device*>(sender());
+    if (!dev) {
+        return;
+    }
+    const NetworkManager::WirelessDevice::Ptr device = NetworkManager::findNetworkInterface(dev->uni()).objectCast<NetworkManager::WirelessDevice>();
+    if (!device) {
+        return;
+    }
+
+    if (newstate == NetworkManager::Device::Activated) {
+        const NetworkManager::ActiveConnection::Ptr ac = device->activeConnection();
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+            if (ac && it->deviceUni == device->uni() && it->uuid == ac->uuid()) {
+                qCInfo(PLASMA_NM) << "Connection" << ac->id() << "reactivated" << m_sinceResume.elapsed() << "ms after resume"
+                                  << (it->activationRequested ? "(fast reconnect)" : m_accelerate ? "(NetworkManager autoconnect won)" : "(baseline, fast reconnect disabled)");
+                m_pending.erase(it);
+                break;
+            }
+        }
+
+        // Anything else pending for this device lost to another connection
+        for (auto it = m_pending.begin(); it != m_pending.end();) {
+            if (it->deviceUni == device->uni()) {
+                it = m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (m_pending.isEmpty()) {
+            finish();
+        }
+    } else if (m_accelerate && newstate == NetworkManager::Device::Disconnected) {
+        requestScan(device);
+    } else if (newstate == NetworkManager::Device::Failed) {
+        for (PendingReconnect &pending : m_pending) {
+            if (pending.deviceUni == device->uni()) {
+                pending.activationRequested = false;
+            }
+        }
+    }
+}
+
+void ResumeAccelerator::finish()
+{
+    m_giveUpTimer.stop();
+
+    for (const QString &uni : qAsConst(m_devices)) {
+        NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(uni);
+        if (device) {
+            disconnect(device.data(), nullptr, this, nullptr);
+        }
+    }
+
+    if (m_sinceResume.isValid()) {
+        for (const PendingReconnect &pending : qAsConst(m_pending)) {
+            qCDebug(PLASMA_NM) << "Gave up reactivating" << pending.uuid << "after" << m_sinceResume.elapsed() << "ms";
+        }
+    }
+
+    m_devices.clear();
+    m_pending.clear();
+    m_sinceResume.invalidate();
+}
@@ -0,0 +1,74 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_RESUME_ACCELERATOR_H
+#define PLASMA_NM_RESUME_ACCELERATOR_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <NetworkManagerQt/ActiveConnection>
+#include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/WirelessDevice>
+
+/**
+ * Reconnects the wireless connections that were active before suspend as soon
+ * as their network shows up again after resume, instead of waiting for the
+ * next NetworkManager autoconnect cycle.
+ */
+class ResumeAccelerator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ResumeAccelerator(QObject *parent = nullptr);
+
+public Q_SLOTS:
+    /**
+     * To be connected to Notification::prepareForSleep(), which also
+     * provides the connections to reconnect.
+     */
+    void onPrepareForSleep(bool sleep, const NetworkManager::ActiveConnection::List &activeConnections);
+
+private Q_SLOTS:
+    void onDeviceStateChanged(NetworkManager::Device::State newstate, NetworkManager::Device::State oldstate, NetworkManager::Device::StateChangeReason reason);
+    void onAccessPointAppeared();
+    void finish();
+
+private:
+    struct PendingReconnect {
+        QString uuid;
+        QString connectionPath;
+        QString deviceUni;
+        QByteArray ssid;
+        bool activationRequested = false;
+    };
+
+    void requestScan(const NetworkManager::WirelessDevice::Ptr &device);
+    void tryActivate(const NetworkManager::WirelessDevice::Ptr &device);
+
+    QList<PendingReconnect> m_pending;
+    QStringList m_devices;
+    bool m_accelerate = true;
+    QElapsedTimer m_sinceResume;
+    QTimer m_giveUpTimer;
+};
+
+#endif // PLASMA_NM_RESUME_ACCELERATOR_H
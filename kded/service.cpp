@@ -22,19 +22,25 @@
 */
 
 #include "service.h"
+#include "debug.h"
 
 #include <KPluginFactory>
 
 #include "connectivitymonitor.h"
+#include "eventjournal.h"
 #include "secretagent.h"
 #include "notification.h"
 #include "monitor.h"
+#include "resumeaccelerator.h"
 
 #include <QDBusMetaType>
 #include <QDBusServiceWatcher>
 #include <QDBusConnection>
 #include <QDBusConnectionInterface>
 #include <QDBusReply>
+#include <QElapsedTimer>
+
+#include <NetworkManagerQt/Manager>
 
 K_PLUGIN_CLASS_WITH_JSON(NetworkManagementService, "networkmanagement.json")
 
@@ -45,6 +51,10 @@ class NetworkManagementServicePrivate
     Notification *notification = nullptr;
     Monitor *monitor = nullptr;
     ConnectivityMonitor *connectivityMonitor = nullptr;
+    EventJournal *journal = nullptr;
+    ResumeAccelerator *resumeAccelerator = nullptr;
+    QMetaObject::Connection connectivityMonitorTrigger;
+    QMetaObject::Connection resumeAcceleratorTrigger;
 };
 
 NetworkManagementService::NetworkManagementService(QObject * parent, const QVariantList&)
@@ -63,21 +73,80 @@ NetworkManagementService::~NetworkManagementService()
     delete d_ptr;
 }
 
+// For the submodules which are not needed at login
+template<typename Module, typename Factory>
+static void createOnDemand(Module *&module, const char *name, Factory factory)
+{
+    if (!module) {
+        QElapsedTimer timer;
+        timer.start();
+        module = factory();
+        qCDebug(PLASMA_NM) << "Created" << name << "on demand in" << timer.elapsed() << "ms";
+    }
+}
+
 void NetworkManagementService::init()
 {
     Q_D(NetworkManagementService);
 
-    if (!d->notification) {
-        d->notification = new Notification(this);
+    // Report what network management costs during login, per submodule
+    QElapsedTimer total;
+    total.start();
+    QElapsedTimer step;
+    QStringList timings;
+    auto create = [&step, &timings] (auto *&module, const char *name, auto factory) {
+        if (!module) {
+            step.start();
+            module = factory();
+            timings << QStringLiteral("%1: %2 ms").arg(QLatin1String(name)).arg(step.elapsed());
+        }
+    };
+
+    // The journal and the notifications have to see the first events, the journal
+    // only maps its file once there is one though
+    create(d->journal, "journal", [this] { return new EventJournal(this); });
+    create(d->notification, "notification", [this] { return new Notification(this); });
+    // Bluetooth and modem monitors are created by Monitor once BlueZ or a modem shows up
+    create(d->monitor, "monitor", [this] { return new Monitor(this); });
+
+    // Connectivity is only checked once a connection is activated
+    if (!NetworkManager::activeConnections().isEmpty()) {
+        create(d->connectivityMonitor, "connectivity", [this] { return new ConnectivityMonitor(this); });
+    } else if (!d->connectivityMonitor && !d->connectivityMonitorTrigger) {
+        d->connectivityMonitorTrigger = connect(NetworkManager::notifier(), &NetworkManager::Notifier::activeConnectionAdded, this, [this] {
+            Q_D(NetworkManagementService);
+            disconnect(d->connectivityMonitorTrigger);
+            createOnDemand(d->connectivityMonitor, "connectivity", [this] { return new ConnectivityMonitor(this); });
+        });
+    }
+
+    // Nothing is to be accelerated before the first suspend, Notification already follows logind's sleep signal
+    if (!d->resumeAcceleratorTrigger) {
+        d->resumeAcceleratorTrigger = connect(d->notification, &Notification::prepareForSleep, this, [this] (bool sleep, const NetworkManager::ActiveConnection::List &activeConnections) {
+            Q_D(NetworkManagementService);
+            if (sleep) {
+                createOnDemand(d->resumeAccelerator, "resume", [this] { return new ResumeAccelerator(this); });
+            }
+            if (d->resumeAccelerator) {
+                d->resumeAccelerator->onPrepareForSleep(sleep, activeConnections);
+            }
+        });
     }
 
-    if (!d->monitor) {
-        d->monitor = new Monitor(this);
+    if (!timings.isEmpty()) {
+        qCInfo(PLASMA_NM) << "Network management initialized in" << total.elapsed() << "ms" << timings;
     }
+}
+
+QByteArray NetworkManagementService::journalEvents(qlonglong from, qlonglong to, const QString &device, const QString &uuid)
+{
+    Q_D(NetworkManagementService);
 
-    if (!d->connectivityMonitor) {
-        d->connectivityMonitor = new ConnectivityMonitor(this);
+    if (!d->journal) {
+        return QByteArray();
     }
+
+    return d->journal->events(from, to, device, uuid);
 }
 
 #include "service.moc"
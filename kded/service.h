@@ -43,6 +43,12 @@ public:
 public Q_SLOTS:
     Q_SCRIPTABLE void init();
 
+    /**
+     * Returns packed EventJournal::Record entries logged between @p from and @p to
+     * (milliseconds since epoch), optionally filtered by interface name and connection UUID.
+     */
+    Q_SCRIPTABLE QByteArray journalEvents(qlonglong from, qlonglong to, const QString &device, const QString &uuid);
+
 Q_SIGNALS:
     Q_SCRIPTABLE
     void secretsError(const QString &connectionPath, const QString &message);
@@ -0,0 +1,167 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cidraggregator.h"
+
+#include <QHostAddress>
+
+#include <algorithm>
+
+bool CidrAggregator::addPrefix(const QString &prefix)
+{
+    const int slash = prefix.indexOf(QLatin1Char('/'));
+    QHostAddress address;
+    if (!address.setAddress((slash < 0 ? prefix : prefix.left(slash)).trimmed())) {
+        return false;
+    }
+
+    const bool ipv4 = address.protocol() == QAbstractSocket::IPv4Protocol;
+    const int maxLength = ipv4 ? 32 : 128;
+
+    Prefix result;
+    result.length = maxLength;
+    if (slash >= 0) {
+        bool ok = false;
+        result.length = prefix.midRef(slash + 1).trimmed().toInt(&ok);
+        if (!ok || result.length < 0 || result.length > maxLength) {
+            return false;
+        }
+    }
+
+    if (ipv4) {
+        result.high = quint64(address.toIPv4Address()) << 32;
+        m_ipv4 << result;
+    } else {
+        const Q_IPV6ADDR raw = address.toIPv6Address();
+        for (int i = 0; i < 8; ++i) {
+            result.high = result.high << 8 | raw[i];
+            result.low = result.low << 8 | raw[i + 8];
+        }
+        m_ipv6 << result;
+    }
+
+    return true;
+}
+
+void CidrAggregator::addPrefixes(const QStringList &prefixes, QStringList *invalid)
+{
+    for (const QString &prefix : prefixes) {
+        if (!addPrefix(prefix) && invalid) {
+            invalid->append(prefix);
+        }
+    }
+}
+
+int CidrAggregator::inputCount() const
+{
+    return m_ipv4.size() + m_ipv6.size();
+}
+
+QVector<CidrAggregator::Prefix> CidrAggregator::merge(QVector<Prefix> prefixes)
+{
+    // The network of @p prefix with only the first @p length bits
+    auto network = [] (const Prefix &prefix, int length) {
+        Prefix result = prefix;
+        result.length = length;
+        if (length <= 64) {
+            result.high &= length ? ~quint64(0) << (64 - length) : 0;
+            result.low = 0;
+        } else {
+            result.low &= ~quint64(0) << (128 - length);
+        }
+        return result;
+    };
+    auto sameAddress = [] (const Prefix &a, const Prefix &b) {
+        return a.high == b.high && a.low == b.low;
+    };
+
+    for (Prefix &prefix : prefixes) {
+        prefix = network(prefix, prefix.length);
+    }
+
+    // A prefix sorts right after the prefixes containing it
+    std::sort(prefixes.begin(), prefixes.end(), [] (const Prefix &a, const Prefix &b) {
+        if (a.high != b.high) {
+            return a.high < b.high;
+        }
+        if (a.low != b.low) {
+            return a.low < b.low;
+        }
+        return a.length < b.length;
+    });
+
+    QVector<Prefix> result;
+    result.reserve(prefixes.size());
+    for (Prefix prefix : qAsConst(prefixes)) {
+        // Duplicates and prefixes within the previous one add nothing. Anything
+        // containing the prefix would have been the previous one, or merged into it.
+        if (!result.isEmpty()) {
+            const Prefix &last = result.constLast();
+            if (prefix.length >= last.length && sameAddress(network(prefix, last.length), last)) {
+                continue;
+            }
+        }
+
+        // Replace the prefix and its lower sibling by their parent, which may in turn
+        // complete the next level
+        while (prefix.length > 0 && !result.isEmpty()) {
+            const Prefix &last = result.constLast();
+            const Prefix parent = network(prefix, prefix.length - 1);
+            if (last.length != prefix.length || !sameAddress(last, parent)) {
+                break;
+            }
+            result.removeLast();
+            prefix = parent;
+        }
+
+        result << prefix;
+    }
+
+    return result;
+}
+
+QStringList CidrAggregator::aggregate() const
+{
+    const QVector<Prefix> ipv4 = merge(m_ipv4);
+    const QVector<Prefix> ipv6 = merge(m_ipv6);
+
+    QStringList result;
+    result.reserve(ipv4.size() + ipv6.size());
+    for (const Prefix &prefix : ipv4) {
+        result << QHostAddress(quint32(prefix.high >> 32)).toString() + QLatin1Char('/') + QString::number(prefix.length);
+    }
+    for (const Prefix &prefix : ipv6) {
+        Q_IPV6ADDR raw;
+        for (int i = 0; i < 8; ++i) {
+            raw[i] = quint8(prefix.high >> (56 - 8 * i));
+            raw[i + 8] = quint8(prefix.low >> (56 - 8 * i));
+        }
+        result << QHostAddress(raw).toString() + QLatin1Char('/') + QString::number(prefix.length);
+    }
+
+    return result;
+}
+
+QStringList CidrAggregator::aggregate(const QStringList &prefixes, QStringList *invalid)
+{
+    CidrAggregator aggregator;
+    aggregator.addPrefixes(prefixes, invalid);
+    return aggregator.aggregate();
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_CIDR_AGGREGATOR_H
+#define PLASMA_NM_CIDR_AGGREGATOR_H
+
+#include <QStringList>
+#include <QVector>
+
+/**
+ * Reduces a list of IPv4 and IPv6 prefixes to the smallest list covering the
+ * same addresses: host bits are cleared, duplicates and prefixes within
+ * another one are dropped, and adjacent prefixes are merged into their
+ * common parent.
+ *
+ * The prefixes of each family are sorted once and then merged in a single
+ * pass over a stack, so large lists like country ranges aggregate in
+ * O(n log n).
+ */
+class Q_DECL_EXPORT CidrAggregator
+{
+public:
+    /**
+     * Adds "address/prefix length" or a plain address, which stands for a
+     * single host.
+     *
+     * @return false if @p prefix is not valid, it is not added then
+     */
+    bool addPrefix(const QString &prefix);
+    void addPrefixes(const QStringList &prefixes, QStringList *invalid = nullptr);
+
+    /**
+     * The number of prefixes added so far.
+     */
+    int inputCount() const;
+
+    /**
+     * Returns the aggregated prefixes, IPv4 first and each family in address
+     * order.
+     */
+    QStringList aggregate() const;
+
+    /**
+     * Convenience function for aggregating a whole list at once.
+     */
+    static QStringList aggregate(const QStringList &prefixes, QStringList *invalid = nullptr);
+
+private:
+    struct Prefix {
+        quint64 high = 0;   // the address, IPv4 addresses in the upper 32 bits
+        quint64 low = 0;
+        int length = 0;
+    };
+
+    static QVector<Prefix> merge(QVector<Prefix> prefixes);
+
+    QVector<Prefix> m_ipv4;
+    QVector<Prefix> m_ipv6;
+};
+
+#endif // PLASMA_NM_CIDR_AGGREGATOR_H
@@ -41,26 +41,250 @@
 #include "settings/wiredsecurity.h"
 #include "settings/wireguardinterfacewidget.h"
 #include "vpnuiplugin.h"
+#include "vpnuipluginregistry.h"
+#include "wireguardkeyvalidator.h"
 
 #include <NetworkManagerQt/ActiveConnection>
-#include <NetworkManagerQt/AdslSetting>
-#include <NetworkManagerQt/Connection>
+#include <NetworkManagerQt/BondSetting>
 #include <NetworkManagerQt/CdmaSetting>
+#include <NetworkManagerQt/Connection>
 #include <NetworkManagerQt/GenericTypes>
 #include <NetworkManagerQt/GsmSetting>
+#include <NetworkManagerQt/Ipv4Setting>
+#include <NetworkManagerQt/Ipv6Setting>
 #include <NetworkManagerQt/PppoeSetting>
+#include <NetworkManagerQt/Security8021xSetting>
 #include <NetworkManagerQt/Settings>
+#include <NetworkManagerQt/VlanSetting>
 #include <NetworkManagerQt/VpnSetting>
 #include <NetworkManagerQt/Utils>
+#include <NetworkManagerQt/WiredSetting>
+#include <NetworkManagerQt/WireGuardSetting>
 #include <NetworkManagerQt/WirelessSetting>
 #include <NetworkManagerQt/WirelessSecuritySetting>
 #include <NetworkManagerQt/WirelessDevice>
 
 #include <KLocalizedString>
 #include <KNotification>
-#include <KServiceTypeTrader>
 #include <KUser>
 
+#include <QEvent>
+#include <QHostAddress>
+#include <QVBoxLayout>
+#include <QtCrypto>
+
+#include <algorithm>
+
+// Do not keep the editor locked if the secret agent does not answer
+static const int secretsTimeoutInterval = 10000;
+
+// Secrets which are stored need a value, like in PasswordField
+static bool secretStored(NetworkManager::Setting::SecretFlags flags)
+{
+    return flags.testFlag(NetworkManager::Setting::None) || flags.testFlag(NetworkManager::Setting::AgentOwned);
+}
+
+static bool credentialsValid(NetworkManager::Setting::SecretFlags flags, const QString &username, const QString &password)
+{
+    if (secretStored(flags)) {
+        return !username.isEmpty() && !password.isEmpty();
+    } else if (flags.testFlag(NetworkManager::Setting::NotSaved)) {
+        return !username.isEmpty();
+    }
+    return true;
+}
+
+// Like HwAddrComboBox and BssidComboBox, an empty address means any
+static bool macAddressValid(const QByteArray &address)
+{
+    return address.isEmpty() || NetworkManager::macAddressIsValid(NetworkManager::macAddressAsString(address));
+}
+
+// The checks of Security8021x::isValid(), which shows the first of the stored EAP methods and PEAP by default
+static bool security8021xValid(const NetworkManager::Security8021xSetting::Ptr &security)
+{
+    const QList<NetworkManager::Security8021xSetting::EapMethod> eapMethods = security->eapMethods();
+    const bool passwordValid = !security->password().isEmpty() || !secretStored(security->passwordFlags());
+
+    if (eapMethods.contains(NetworkManager::Security8021xSetting::EapMethodMd5)) {
+        return !security->identity().isEmpty() && passwordValid;
+    } else if (eapMethods.contains(NetworkManager::Security8021xSetting::EapMethodTls)) {
+        if (security->identity().isEmpty() || security->privateKey().isEmpty()) {
+            return false;
+        }
+
+        // The widget takes the password option of the private key from the password flags
+        if (!secretStored(security->passwordFlags())) {
+            return true;
+        }
+
+        if (security->privateKeyPassword().isEmpty()) {
+            return false;
+        }
+
+        const QString privateKey = QString::fromUtf8(security->privateKey());
+        QCA::Initializer init;
+        QCA::ConvertResult convRes;
+
+        if (QCA::isSupported("pkcs12")) {
+            QCA::KeyBundle keyBundle = QCA::KeyBundle::fromFile(privateKey, security->privateKeyPassword().toUtf8(), &convRes);
+            if (convRes == QCA::ConvertGood) {
+                return keyBundle.privateKey().canDecrypt();
+            }
+        }
+
+        if (security->clientCertificate().isEmpty()) {
+            return false;
+        }
+
+        QCA::PrivateKey key = QCA::PrivateKey::fromPEMFile(privateKey, security->privateKeyPassword().toUtf8(), &convRes);
+        if (convRes == QCA::ConvertGood) {
+            return key.canDecrypt();
+        }
+        return true;
+    } else if (eapMethods.contains(NetworkManager::Security8021xSetting::EapMethodFast)) {
+        if (static_cast<int>(security->phase1FastProvisioning()) <= 0 && security->pacFile().isEmpty()) {
+            return false;
+        }
+    }
+
+    return !security->identity().isEmpty() && passwordValid;
+}
+
+// The checks of the setting widgets, applied to a stored setting whose tab was not constructed yet
+static bool storedSettingValid(const NetworkManager::ConnectionSettings::Ptr &connection, NetworkManager::Setting::SettingType type)
+{
+    const NetworkManager::Setting::Ptr setting = connection->setting(type);
+    if (!setting) {
+        return true;
+    }
+
+    switch (type) {
+    case NetworkManager::Setting::Wired: {
+        const NetworkManager::WiredSetting::Ptr wired = setting.staticCast<NetworkManager::WiredSetting>();
+        return macAddressValid(wired->macAddress()) && macAddressValid(wired->clonedMacAddress());
+    }
+    case NetworkManager::Setting::Wireless: {
+        const NetworkManager::WirelessSetting::Ptr wireless = setting.staticCast<NetworkManager::WirelessSetting>();
+        return !wireless->ssid().isEmpty() && macAddressValid(wireless->macAddress()) && macAddressValid(wireless->bssid());
+    }
+    case NetworkManager::Setting::WirelessSecurity: {
+        const NetworkManager::WirelessSecuritySetting::Ptr security = setting.staticCast<NetworkManager::WirelessSecuritySetting>();
+        switch (security->keyMgmt()) {
+        case NetworkManager::WirelessSecuritySetting::Wep: {
+            const QStringList keys = {security->wepKey0(), security->wepKey1(), security->wepKey2(), security->wepKey3()};
+            const QString key = keys.value(security->wepTxKeyindex());
+            return NetworkManager::wepKeyIsValid(key, security->wepKeyType()) || !secretStored(security->wepKeyFlags());
+        }
+        case NetworkManager::WirelessSecuritySetting::Ieee8021x:
+            if (security->authAlg() == NetworkManager::WirelessSecuritySetting::Leap) {
+                return !security->leapUsername().isEmpty() &&
+                       (!security->leapPassword().isEmpty() || !secretStored(security->leapPasswordFlags()));
+            }
+            // Dynamic WEP
+            return security8021xValid(connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>());
+        case NetworkManager::WirelessSecuritySetting::WpaEap:
+            return security8021xValid(connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>());
+        case NetworkManager::WirelessSecuritySetting::WpaPsk:
+            return NetworkManager::wpaPskIsValid(security->psk()) || !secretStored(security->pskFlags());
+        case NetworkManager::WirelessSecuritySetting::SAE:
+            return !security->psk().isEmpty() || !secretStored(security->pskFlags());
+        default:
+            return true;
+        }
+    }
+    case NetworkManager::Setting::Security8021x:
+        // On Wi-Fi it is checked along with the key management of the wireless security,
+        // on a wired connection it is only used when it was set up
+        if (connection->connectionType() != NetworkManager::ConnectionSettings::Wired || setting->isNull()) {
+            return true;
+        }
+        return security8021xValid(setting.staticCast<NetworkManager::Security8021xSetting>());
+    case NetworkManager::Setting::Ipv4: {
+        const NetworkManager::Ipv4Setting::Ptr ipv4 = setting.staticCast<NetworkManager::Ipv4Setting>();
+        if (ipv4->method() != NetworkManager::Ipv4Setting::Manual) {
+            return true;
+        }
+        const QList<NetworkManager::IpAddress> addresses = ipv4->addresses();
+        return !addresses.isEmpty() && std::none_of(addresses.constBegin(), addresses.constEnd(), [] (const NetworkManager::IpAddress &address) {
+            return address.ip().isNull();
+        });
+    }
+    case NetworkManager::Setting::Ipv6: {
+        const NetworkManager::Ipv6Setting::Ptr ipv6 = setting.staticCast<NetworkManager::Ipv6Setting>();
+        if (ipv6->method() != NetworkManager::Ipv6Setting::Manual) {
+            return true;
+        }
+        const QList<NetworkManager::IpAddress> addresses = ipv6->addresses();
+        return !addresses.isEmpty() && std::none_of(addresses.constBegin(), addresses.constEnd(), [] (const NetworkManager::IpAddress &address) {
+            return address.ip().isNull() || address.prefixLength() < 1 || address.prefixLength() > 128;
+        });
+    }
+    case NetworkManager::Setting::Gsm: {
+        const NetworkManager::GsmSetting::Ptr gsm = setting.staticCast<NetworkManager::GsmSetting>();
+        return !gsm->apn().isEmpty() && credentialsValid(gsm->passwordFlags(), gsm->username(), gsm->password()) &&
+               (!secretStored(gsm->pinFlags()) || !gsm->pin().isEmpty());
+    }
+    case NetworkManager::Setting::Cdma: {
+        const NetworkManager::CdmaSetting::Ptr cdma = setting.staticCast<NetworkManager::CdmaSetting>();
+        return !cdma->number().isEmpty() && credentialsValid(cdma->passwordFlags(), cdma->username(), cdma->password());
+    }
+    case NetworkManager::Setting::Pppoe: {
+        const NetworkManager::PppoeSetting::Ptr pppoe = setting.staticCast<NetworkManager::PppoeSetting>();
+        return credentialsValid(pppoe->passwordFlags(), pppoe->username(), pppoe->password());
+    }
+    case NetworkManager::Setting::Vlan: {
+        const NetworkManager::VlanSetting::Ptr vlan = setting.staticCast<NetworkManager::VlanSetting>();
+        return !vlan->parent().isEmpty() || !vlan->interfaceName().isEmpty();
+    }
+    case NetworkManager::Setting::Bond: {
+        const NetworkManager::BondSetting::Ptr bond = setting.staticCast<NetworkManager::BondSetting>();
+        // BondWidget switches to ARP monitoring when targets are stored
+        const QString arpTargets = bond->options().value(QStringLiteral(NM_SETTING_BOND_OPTION_ARP_IP_TARGET));
+        if (!arpTargets.isEmpty()) {
+            const QStringList ipAddresses = arpTargets.split(QLatin1Char(','));
+            for (const QString &ip : ipAddresses) {
+                if (QHostAddress(ip).isNull()) {
+                    return false;
+                }
+            }
+        }
+
+        if (bond->interfaceName().isEmpty()) {
+            return false;
+        }
+
+        // Like BondWidget::populateBonds() the slaves refer to the master by uuid or by name
+        const NetworkManager::Connection::List connections = NetworkManager::listConnections();
+        return std::any_of(connections.constBegin(), connections.constEnd(), [connection] (const NetworkManager::Connection::Ptr &slave) {
+            const NetworkManager::ConnectionSettings::Ptr settings = slave->settings();
+            const QString master = settings->master();
+            return (master == connection->uuid() || (!connection->id().isEmpty() && master == connection->id())) &&
+                   settings->slaveType() == QLatin1String("bond");
+        });
+    }
+    case NetworkManager::Setting::WireGuard: {
+        const NetworkManager::WireGuardSetting::Ptr wireGuard = setting.staticCast<NetworkManager::WireGuardSetting>();
+        WireGuardKeyValidator keyValidator;
+        QString privateKey = wireGuard->privateKey();
+        int pos = 0;
+        if (keyValidator.validate(privateKey, pos) != QValidator::Acceptable || wireGuard->listenPort() > 65535) {
+            return false;
+        }
+
+        // The same check as WireGuardInterfaceWidget::loadSecrets() on the peers
+        const NMVariantMapList peers = wireGuard->peers();
+        return std::none_of(peers.constBegin(), peers.constEnd(), [] (const QVariantMap &peer) {
+            return peer.contains(QStringLiteral("preshared-key-flags")) &&
+                   peer.value(QStringLiteral("preshared-key-flags")).toInt() != NetworkManager::Setting::NotRequired &&
+                   peer.value(QStringLiteral("preshared-key")).toString().isEmpty();
+        });
+    }
+    default:
+        return true;
+    }
+}
+
 ConnectionEditorBase::ConnectionEditorBase(const NetworkManager::ConnectionSettings::Ptr &connection,
                                            QWidget *parent, Qt::WindowFlags f)
     : QWidget(parent, f)
@@ -69,11 +293,17 @@ ConnectionEditorBase::ConnectionEditorBase(const NetworkManager::ConnectionSetti
     , m_pendingReplies(0)
     , m_connection(connection)
 {
+    m_secretsTimer.setSingleShot(true);
+    m_secretsTimer.setInterval(secretsTimeoutInterval);
+    connect(&m_secretsTimer, &QTimer::timeout, this, &ConnectionEditorBase::secretsTimeout);
 }
 
 ConnectionEditorBase::ConnectionEditorBase(QWidget *parent, Qt::WindowFlags f)
     : QWidget(parent, f)
 {
+    m_secretsTimer.setSingleShot(true);
+    m_secretsTimer.setInterval(secretsTimeoutInterval);
+    connect(&m_secretsTimer, &QTimer::timeout, this, &ConnectionEditorBase::secretsTimeout);
 }
 
 ConnectionEditorBase::~ConnectionEditorBase()
@@ -87,12 +317,20 @@ void ConnectionEditorBase::setConnection(const NetworkManager::ConnectionSetting
     m_connection.clear();
     m_connection = connection;
     m_initialized = false;
+    m_pendingReplies = 0;
+    m_loadGeneration++;
+    m_secretsTimer.stop();
 
     // Reset UI setting widgets
     delete m_connectionWidget;
     m_connectionWidget = nullptr;
-    qDeleteAll(m_settingWidgets);
+    for (const SettingPage &page : qAsConst(m_settingPages)) {
+        delete page.container;
+    }
+    m_settingPages.clear();
     m_settingWidgets.clear();
+    m_loadedSecrets.clear();
+    m_changedSsid.clear();
 
     initialize();
 }
@@ -101,6 +339,20 @@ NMVariantMapMap ConnectionEditorBase::setting() const
 {
     NMVariantMapMap settings = m_connectionWidget->setting();
 
+    // Tabs which were never shown could not have been changed, take their stored settings
+    const NMVariantMapMap storedSettings = m_connection->toMap();
+    for (const SettingPage &page : m_settingPages) {
+        if (page.widget) {
+            continue;
+        }
+        for (const NetworkManager::Setting::SettingType type : page.settingTypes) {
+            const QString name = NetworkManager::Setting::typeAsString(type);
+            if (storedSettings.contains(name)) {
+                settings.insert(name, storedSettings.value(name));
+            }
+        }
+    }
+
     for (SettingWidget *widget : m_settingWidgets) {
         const QString type = widget->type();
         if (type != NetworkManager::Setting::typeAsString(NetworkManager::Setting::Security8021x) &&
@@ -186,13 +438,64 @@ void ConnectionEditorBase::addConnectionWidget(ConnectionWidget *widget, const Q
     addWidget(widget, text);
 }
 
-void ConnectionEditorBase::addSettingWidget(SettingWidget *widget, const QString &text)
+void ConnectionEditorBase::addSettingWidget(const QString &text, const QList<NetworkManager::Setting::SettingType> &settingTypes,
+                                            const std::function<SettingWidget *(QWidget *parent)> &factory)
+{
+    SettingPage page;
+    page.container = new QWidget(this);
+    page.settingTypes = settingTypes;
+    page.factory = factory;
+
+    QVBoxLayout *layout = new QVBoxLayout(page.container);
+    layout->setContentsMargins(0, 0, 0, 0);
+    page.container->installEventFilter(this);
+
+    m_settingPages << page;
+
+    addWidget(page.container, text);
+}
+
+void ConnectionEditorBase::createSettingWidget(SettingPage &page)
 {
+    SettingWidget *widget = page.factory(page.container);
+    page.factory = nullptr;
+    if (!widget) {
+        return;
+    }
+
+    page.widget = widget;
+    page.container->layout()->addWidget(widget);
     m_settingWidgets << widget;
 
+    for (const QString &settingName : qAsConst(m_loadedSecrets)) {
+        loadSecrets(widget, settingName);
+    }
+
     connect(widget, &SettingWidget::settingChanged, this, &ConnectionEditorBase::settingChanged);
+    connect(widget, &SettingWidget::validChanged, this, &ConnectionEditorBase::validChanged);
 
-    addWidget(widget, text);
+    KAcceleratorManager::manage(widget);
+
+    // The widget takes over from the stored setting it was validated on
+    if (m_pendingReplies == 0) {
+        validChanged(widget->isValid());
+    }
+}
+
+bool ConnectionEditorBase::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Show) {
+        for (SettingPage &page : m_settingPages) {
+            if (page.container == watched) {
+                if (!page.widget && page.factory) {
+                    createSettingWidget(page);
+                }
+                break;
+            }
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
 }
 
 void ConnectionEditorBase::initialize()
@@ -208,60 +511,90 @@ void ConnectionEditorBase::initialize()
     ConnectionWidget *connectionWidget = new ConnectionWidget(m_connection);
     addConnectionWidget(connectionWidget, i18nc("General", "General configuration"));
 
-    // Add the rest of widgets
+    // Add the rest of widgets, they are constructed once their tab is shown
     QString serviceType;
     if (type == NetworkManager::ConnectionSettings::Wired) {
-        WiredConnectionWidget *wiredWidget = new WiredConnectionWidget(m_connection->setting(NetworkManager::Setting::Wired), this);
-        addSettingWidget(wiredWidget, i18n("Wired"));
-        WiredSecurity *wiredSecurity = new WiredSecurity(m_connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>(), this);
-        addSettingWidget(wiredSecurity, i18n("802.1x Security"));
+        addSettingWidget(i18n("Wired"), {NetworkManager::Setting::Wired}, [this] (QWidget *parent) {
+            return new WiredConnectionWidget(m_connection->setting(NetworkManager::Setting::Wired), parent);
+        });
+        addSettingWidget(i18n("802.1x Security"), {NetworkManager::Setting::Security8021x}, [this] (QWidget *parent) {
+            return new WiredSecurity(m_connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>(), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Wireless) {
-        WifiConnectionWidget *wifiWidget = new WifiConnectionWidget(m_connection->setting(NetworkManager::Setting::Wireless), this);
-        addSettingWidget(wifiWidget, i18n("Wi-Fi"));
-        WifiSecurity *wifiSecurity = new WifiSecurity(m_connection->setting(NetworkManager::Setting::WirelessSecurity),
-                m_connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>(),
-                this);
-        addSettingWidget(wifiSecurity, i18n("Wi-Fi Security"));
-        connect(wifiWidget, QOverload<const QString &>::of(&WifiConnectionWidget::ssidChanged), wifiSecurity, &WifiSecurity::onSsidChanged);
+        addSettingWidget(i18n("Wi-Fi"), {NetworkManager::Setting::Wireless}, [this] (QWidget *parent) {
+            WifiConnectionWidget *wifiWidget = new WifiConnectionWidget(m_connection->setting(NetworkManager::Setting::Wireless), parent);
+            connect(wifiWidget, QOverload<const QString &>::of(&WifiConnectionWidget::ssidChanged), this, [this] (const QString &ssid) {
+                m_changedSsid = ssid;
+                for (SettingWidget *widget : qAsConst(m_settingWidgets)) {
+                    if (widget->type() == NetworkManager::Setting::typeAsString(NetworkManager::Setting::WirelessSecurity)) {
+                        static_cast<WifiSecurity *>(widget)->onSsidChanged(ssid);
+                    }
+                }
+            });
+            return wifiWidget;
+        });
+        addSettingWidget(i18n("Wi-Fi Security"), {NetworkManager::Setting::WirelessSecurity, NetworkManager::Setting::Security8021x}, [this] (QWidget *parent) {
+            WifiSecurity *wifiSecurity = new WifiSecurity(m_connection->setting(NetworkManager::Setting::WirelessSecurity),
+                    m_connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>(),
+                    parent);
+            // Pre-configure for an SSID chosen before this tab was first shown
+            if (!m_changedSsid.isEmpty()) {
+                wifiSecurity->onSsidChanged(m_changedSsid);
+            }
+            return wifiSecurity;
+        });
     } else if (type == NetworkManager::ConnectionSettings::Pppoe) { // DSL
-        PppoeWidget *pppoeWidget = new PppoeWidget(m_connection->setting(NetworkManager::Setting::Pppoe), this);
-        addSettingWidget(pppoeWidget, i18n("DSL"));
-        WiredConnectionWidget *wiredWidget = new WiredConnectionWidget(m_connection->setting(NetworkManager::Setting::Wired), this);
-        addSettingWidget(wiredWidget, i18n("Wired"));
+        addSettingWidget(i18n("DSL"), {NetworkManager::Setting::Pppoe}, [this] (QWidget *parent) {
+            return new PppoeWidget(m_connection->setting(NetworkManager::Setting::Pppoe), parent);
+        });
+        addSettingWidget(i18n("Wired"), {NetworkManager::Setting::Wired}, [this] (QWidget *parent) {
+            return new WiredConnectionWidget(m_connection->setting(NetworkManager::Setting::Wired), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Gsm) { // GSM
-        GsmWidget *gsmWidget = new GsmWidget(m_connection->setting(NetworkManager::Setting::Gsm), this);
-        addSettingWidget(gsmWidget, i18n("Mobile Broadband (%1)", m_connection->typeAsString(m_connection->connectionType())));
+        addSettingWidget(i18n("Mobile Broadband (%1)", m_connection->typeAsString(m_connection->connectionType())), {NetworkManager::Setting::Gsm}, [this] (QWidget *parent) {
+            return new GsmWidget(m_connection->setting(NetworkManager::Setting::Gsm), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Cdma) { // CDMA
-        CdmaWidget *cdmaWidget = new CdmaWidget(m_connection->setting(NetworkManager::Setting::Cdma), this);
-        addSettingWidget(cdmaWidget, i18n("Mobile Broadband (%1)", m_connection->typeAsString(m_connection->connectionType())));
+        addSettingWidget(i18n("Mobile Broadband (%1)", m_connection->typeAsString(m_connection->connectionType())), {NetworkManager::Setting::Cdma}, [this] (QWidget *parent) {
+            return new CdmaWidget(m_connection->setting(NetworkManager::Setting::Cdma), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Bluetooth) {  // Bluetooth
-        BtWidget *btWidget = new BtWidget(m_connection->setting(NetworkManager::Setting::Bluetooth), this);
-        addSettingWidget(btWidget, i18n("Bluetooth"));
+        addSettingWidget(i18n("Bluetooth"), {NetworkManager::Setting::Bluetooth}, [this] (QWidget *parent) {
+            return new BtWidget(m_connection->setting(NetworkManager::Setting::Bluetooth), parent);
+        });
         NetworkManager::BluetoothSetting::Ptr btSetting = m_connection->setting(NetworkManager::Setting::Bluetooth).staticCast<NetworkManager::BluetoothSetting>();
         if (btSetting->profileType() == NetworkManager::BluetoothSetting::Dun) {
-            GsmWidget *gsmWidget = new GsmWidget(m_connection->setting(NetworkManager::Setting::Gsm), this);
-            addSettingWidget(gsmWidget, i18n("GSM"));
-            PPPWidget *pppWidget = new PPPWidget(m_connection->setting(NetworkManager::Setting::Ppp), this);
-            addSettingWidget(pppWidget, i18n("PPP"));
+            addSettingWidget(i18n("GSM"), {NetworkManager::Setting::Gsm}, [this] (QWidget *parent) {
+                return new GsmWidget(m_connection->setting(NetworkManager::Setting::Gsm), parent);
+            });
+            addSettingWidget(i18n("PPP"), {NetworkManager::Setting::Ppp}, [this] (QWidget *parent) {
+                return new PPPWidget(m_connection->setting(NetworkManager::Setting::Ppp), parent);
+            });
         }
     } else if (type == NetworkManager::ConnectionSettings::Infiniband) { // Infiniband
-        InfinibandWidget *infinibandWidget = new InfinibandWidget(m_connection->setting(NetworkManager::Setting::Infiniband), this);
-        addSettingWidget(infinibandWidget, i18n("Infiniband"));
+        addSettingWidget(i18n("Infiniband"), {NetworkManager::Setting::Infiniband}, [this] (QWidget *parent) {
+            return new InfinibandWidget(m_connection->setting(NetworkManager::Setting::Infiniband), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Bond) { // Bond
-        BondWidget *bondWidget = new BondWidget(m_connection->uuid(), m_connection->id(), m_connection->setting(NetworkManager::Setting::Bond), this);
-        addSettingWidget(bondWidget, i18n("Bond"));
+        addSettingWidget(i18n("Bond"), {NetworkManager::Setting::Bond}, [this] (QWidget *parent) {
+            return new BondWidget(m_connection->uuid(), m_connection->id(), m_connection->setting(NetworkManager::Setting::Bond), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Bridge) { // Bridge
-        BridgeWidget *bridgeWidget = new BridgeWidget(m_connection->uuid(), m_connection->id(), m_connection->setting(NetworkManager::Setting::Bridge), this);
-        addSettingWidget(bridgeWidget, i18n("Bridge"));
+        addSettingWidget(i18n("Bridge"), {NetworkManager::Setting::Bridge}, [this] (QWidget *parent) {
+            return new BridgeWidget(m_connection->uuid(), m_connection->id(), m_connection->setting(NetworkManager::Setting::Bridge), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Vlan) { // Vlan
-        VlanWidget *vlanWidget = new VlanWidget(m_connection->setting(NetworkManager::Setting::Vlan), this);
-        addSettingWidget(vlanWidget, i18n("Vlan"));
+        addSettingWidget(i18n("Vlan"), {NetworkManager::Setting::Vlan}, [this] (QWidget *parent) {
+            return new VlanWidget(m_connection->setting(NetworkManager::Setting::Vlan), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Team) { // Team
-        TeamWidget *teamWidget = new TeamWidget(m_connection->uuid(), m_connection->id(), m_connection->setting(NetworkManager::Setting::Team), this);
-        addSettingWidget(teamWidget, i18n("Team"));
+        addSettingWidget(i18n("Team"), {NetworkManager::Setting::Team}, [this] (QWidget *parent) {
+            return new TeamWidget(m_connection->uuid(), m_connection->id(), m_connection->setting(NetworkManager::Setting::Team), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::WireGuard) { // WireGuard
-        WireGuardInterfaceWidget *wireGuardInterfaceWidget = new WireGuardInterfaceWidget(m_connection->setting(NetworkManager::Setting::WireGuard), this);
-        addSettingWidget(wireGuardInterfaceWidget, i18n("WireGuard Interface"));
+        addSettingWidget(i18n("WireGuard Interface"), {NetworkManager::Setting::WireGuard}, [this] (QWidget *parent) {
+            return new WireGuardInterfaceWidget(m_connection->setting(NetworkManager::Setting::WireGuard), parent);
+        });
     } else if (type == NetworkManager::ConnectionSettings::Vpn) { // VPN
         QString error;
         VpnUiPlugin *vpnPlugin = nullptr;
@@ -271,13 +604,12 @@ void ConnectionEditorBase::initialize()
             qCWarning(PLASMA_NM) << "Missing VPN setting!";
         } else {
             serviceType = vpnSetting->serviceType();
-            vpnPlugin = KServiceTypeTrader::createInstanceFromQuery<VpnUiPlugin>(QString::fromLatin1("PlasmaNetworkManagement/VpnUiPlugin"),
-                        QString::fromLatin1("[X-NetworkManager-Services]=='%1'").arg(serviceType),
-                        this, QVariantList(), &error);
-            if (vpnPlugin && error.isEmpty()) {
+            vpnPlugin = VpnUiPluginRegistry::self()->plugin(serviceType, &error);
+            if (vpnPlugin) {
                 const QString shortName = serviceType.section('.', -1);
-                SettingWidget *vpnWidget = vpnPlugin->widget(vpnSetting, this);
-                addSettingWidget(vpnWidget, i18n("VPN (%1)", shortName));
+                addSettingWidget(i18n("VPN (%1)", shortName), {NetworkManager::Setting::Vpn}, [vpnPlugin, vpnSetting] (QWidget *parent) {
+                    return vpnPlugin->widget(vpnSetting, parent);
+                });
             } else {
                 qCWarning(PLASMA_NM) << error << ", serviceType == " << serviceType;
             }
@@ -286,14 +618,16 @@ void ConnectionEditorBase::initialize()
 
     // PPP widget
     if (type == NetworkManager::ConnectionSettings::Pppoe || type == NetworkManager::ConnectionSettings::Cdma || type == NetworkManager::ConnectionSettings::Gsm) {
-        PPPWidget *pppWidget = new PPPWidget(m_connection->setting(NetworkManager::Setting::Ppp), this);
-        addSettingWidget(pppWidget, i18n("PPP"));
+        addSettingWidget(i18n("PPP"), {NetworkManager::Setting::Ppp}, [this] (QWidget *parent) {
+            return new PPPWidget(m_connection->setting(NetworkManager::Setting::Ppp), parent);
+        });
     }
 
     // IPv4 widget
     if (!m_connection->isSlave()) {
-        IPv4Widget *ipv4Widget = new IPv4Widget(m_connection->setting(NetworkManager::Setting::Ipv4), this);
-        addSettingWidget(ipv4Widget, i18n("IPv4"));
+        addSettingWidget(i18n("IPv4"), {NetworkManager::Setting::Ipv4}, [this] (QWidget *parent) {
+            return new IPv4Widget(m_connection->setting(NetworkManager::Setting::Ipv4), parent);
+        });
     }
 
     // IPv6 widget
@@ -308,19 +642,20 @@ void ConnectionEditorBase::initialize()
             || type == NetworkManager::ConnectionSettings::Vlan
             || type == NetworkManager::ConnectionSettings::WireGuard
             || (type == NetworkManager::ConnectionSettings::Vpn && serviceType == QLatin1String("org.freedesktop.NetworkManager.openvpn"))) && !m_connection->isSlave()) {
-        IPv6Widget *ipv6Widget = new IPv6Widget(m_connection->setting(NetworkManager::Setting::Ipv6), this);
-        addSettingWidget(ipv6Widget, i18n("IPv6"));
+        addSettingWidget(i18n("IPv6"), {NetworkManager::Setting::Ipv6}, [this] (QWidget *parent) {
+            return new IPv6Widget(m_connection->setting(NetworkManager::Setting::Ipv6), parent);
+        });
     }
 
-    // Re-check validation
-    bool valid = true;
-    for (SettingWidget *widget : m_settingWidgets) {
-        valid = valid && widget->isValid();
-        connect(widget, &SettingWidget::validChanged, this, &ConnectionEditorBase::validChanged);
+    // Only a VPN plugin knows what its settings need, so its tab is constructed right away
+    for (SettingPage &page : m_settingPages) {
+        if (page.settingTypes.contains(NetworkManager::Setting::Vpn)) {
+            createSettingWidget(page);
+        }
     }
 
-    m_valid = valid;
-    Q_EMIT validityChanged(valid);
+    // Tabs which were not constructed yet are validated on their stored settings
+    validChanged(true);
 
     KAcceleratorManager::manage(this);
 
@@ -328,135 +663,117 @@ void ConnectionEditorBase::initialize()
     if (!emptyConnection) {
         NetworkManager::Connection::Ptr connection = NetworkManager::findConnectionByUuid(m_connection->uuid());
         if (connection) {
-            QStringList requiredSecrets;
-            QString settingName;
-            QVariantMap setting;
-            QDBusPendingReply<NMVariantMapMap> reply;
-
-            if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Adsl) {
-                NetworkManager::AdslSetting::Ptr adslSetting = connection->settings()->setting(NetworkManager::Setting::Adsl).staticCast<NetworkManager::AdslSetting>();
-                if (adslSetting && !adslSetting->needSecrets().isEmpty()) {
-                    requiredSecrets = adslSetting->needSecrets();
-                    setting = adslSetting->toMap();
-                    settingName = QLatin1String("adsl");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Bluetooth) {
-                NetworkManager::GsmSetting::Ptr gsmSetting = connection->settings()->setting(NetworkManager::Setting::Gsm).staticCast<NetworkManager::GsmSetting>();
-                if (gsmSetting && !gsmSetting->needSecrets().isEmpty()) {
-                    requiredSecrets = gsmSetting->needSecrets();
-                    setting = gsmSetting->toMap();
-                    settingName = QLatin1String("gsm");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Cdma) {
-                NetworkManager::CdmaSetting::Ptr cdmaSetting = connection->settings()->setting(NetworkManager::Setting::Cdma).staticCast<NetworkManager::CdmaSetting>();
-                if (cdmaSetting && !cdmaSetting->needSecrets().isEmpty()) {
-                    requiredSecrets = cdmaSetting->needSecrets();
-                    setting = cdmaSetting->toMap();
-                    settingName = QLatin1String("cdma");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Gsm) {
-                NetworkManager::GsmSetting::Ptr gsmSetting = connection->settings()->setting(NetworkManager::Setting::Gsm).staticCast<NetworkManager::GsmSetting>();
-                if (gsmSetting && !gsmSetting->needSecrets().isEmpty()) {
-                    requiredSecrets = gsmSetting->needSecrets();
-                    setting = gsmSetting->toMap();
-                    settingName = QLatin1String("gsm");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Pppoe) {
-                NetworkManager::PppoeSetting::Ptr pppoeSetting = connection->settings()->setting(NetworkManager::Setting::Pppoe).staticCast<NetworkManager::PppoeSetting>();
-                if (pppoeSetting && !pppoeSetting->needSecrets().isEmpty()) {
-                    requiredSecrets = pppoeSetting->needSecrets();
-                    setting = pppoeSetting->toMap();
-                    settingName = QLatin1String("pppoe");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Wired) {
-                NetworkManager::Security8021xSetting::Ptr securitySetting = connection->settings()->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>();
-                if (securitySetting && !securitySetting->needSecrets().isEmpty()) {
-                    requiredSecrets = securitySetting->needSecrets();
-                    setting = securitySetting->toMap();
-                    settingName = QLatin1String("802-1x");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::WireGuard) {
-                NetworkManager::WireGuardSetting::Ptr securitySetting = connection->settings()->setting(NetworkManager::Setting::WireGuard).staticCast<NetworkManager::WireGuardSetting>();
-                if (securitySetting && !securitySetting->needSecrets().isEmpty()) {
-                    requiredSecrets = securitySetting->needSecrets();
-                    setting = securitySetting->toMap();
-                    settingName = QLatin1String("wireguard");
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Wireless) {
-                NetworkManager::WirelessSecuritySetting::Ptr wifiSecuritySetting = connection->settings()->setting(NetworkManager::Setting::WirelessSecurity).staticCast<NetworkManager::WirelessSecuritySetting>();
-                if (wifiSecuritySetting &&
-                        (wifiSecuritySetting->keyMgmt() == NetworkManager::WirelessSecuritySetting::WpaEap ||
-                         (wifiSecuritySetting->keyMgmt() == NetworkManager::WirelessSecuritySetting::WirelessSecuritySetting::Ieee8021x &&
-                          wifiSecuritySetting->authAlg() != NetworkManager::WirelessSecuritySetting::Leap))) {
-                    NetworkManager::Security8021xSetting::Ptr securitySetting = connection->settings()->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>();
-                    if (securitySetting && !securitySetting->needSecrets().isEmpty()) {
-                        requiredSecrets = securitySetting->needSecrets();
-                        setting = securitySetting->toMap();
-                        settingName = QLatin1String("802-1x");
-
-                        if (requiredSecrets.contains(NM_SETTING_802_1X_PASSWORD_RAW)) {
-                            requiredSecrets.removeAll(NM_SETTING_802_1X_PASSWORD_RAW);
-                        }
-                    }
-                } else {
-                    if (!wifiSecuritySetting->needSecrets().isEmpty()) {
-                        requiredSecrets = wifiSecuritySetting->needSecrets();
-                        setting = wifiSecuritySetting->toMap();
-                        settingName = QLatin1String("802-11-wireless-security");
-                    }
-                }
-            } else if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Vpn) {
-                settingName = QLatin1String("vpn");
-            }
-
-            if (!requiredSecrets.isEmpty() || m_connection->connectionType() == NetworkManager::ConnectionSettings::Vpn) {
-                bool requestSecrets = false;
-                if (m_connection->connectionType() == NetworkManager::ConnectionSettings::Vpn) {
-                    NetworkManager::VpnSetting::Ptr vpnSetting = connection->settings()->setting(NetworkManager::Setting::Vpn).staticCast<NetworkManager::VpnSetting>();
-                    for (const QString &key : vpnSetting->data().keys()) {
-                        if (key.endsWith(QStringLiteral("-flags"))) {
-                            NetworkManager::Setting::SecretFlagType secretFlag = (NetworkManager::Setting::SecretFlagType)vpnSetting->data().value(key).toInt();
-                            if (secretFlag == NetworkManager::Setting::None || secretFlag == NetworkManager::Setting::AgentOwned) {
-                                requestSecrets = true;
-                            }
-                        }
-                    }
-                } else {
-                    for (const QString &secret : requiredSecrets) {
-                        if (setting.contains(secret + QLatin1String("-flags"))) {
-                            NetworkManager::Setting::SecretFlagType secretFlag = (NetworkManager::Setting::SecretFlagType)setting.value(secret + QLatin1String("-flags")).toInt();
-                            if (secretFlag == NetworkManager::Setting::None || secretFlag == NetworkManager::Setting::AgentOwned) {
-                                requestSecrets = true;
-                            }
-                        } else {
-                            requestSecrets = true;
-                        }
-                    }
-                }
+            const QStringList settingNames = secretSettingNames(connection->settings());
+            if (!settingNames.isEmpty()) {
+                m_valid = false;
+                Q_EMIT validityChanged(false);
 
-                if (requestSecrets) {
+                // Ask for all of them at once, the agent answers each setting separately
+                m_secretsTimer.start();
+                for (const QString &settingName : settingNames) {
                     m_pendingReplies++;
-                    reply = connection->secrets(settingName);
-                    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
+                    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(connection->secrets(settingName), this);
                     watcher->setProperty("connection", connection->name());
+                    watcher->setProperty("generation", m_loadGeneration);
                     watcher->setProperty("settingName", settingName);
                     connect(watcher, &QDBusPendingCallWatcher::finished, this, &ConnectionEditorBase::replyFinished);
-                    m_valid = false;
-                    Q_EMIT validityChanged(false);
-                    return;
                 }
+                return;
             }
         }
     }
 
     // We should be now fully initialized as we don't wait for secrets
-    if (m_pendingReplies == 0) {
-        m_initialized = true;
+    m_initialized = true;
+}
+
+QStringList ConnectionEditorBase::secretSettingNames(const NetworkManager::ConnectionSettings::Ptr &connectionSettings)
+{
+    QList<NetworkManager::Setting::SettingType> settingTypes;
+    switch (connectionSettings->connectionType()) {
+    case NetworkManager::ConnectionSettings::Adsl:
+        settingTypes << NetworkManager::Setting::Adsl;
+        break;
+    case NetworkManager::ConnectionSettings::Bluetooth:
+    case NetworkManager::ConnectionSettings::Gsm:
+        settingTypes << NetworkManager::Setting::Gsm;
+        break;
+    case NetworkManager::ConnectionSettings::Cdma:
+        settingTypes << NetworkManager::Setting::Cdma;
+        break;
+    case NetworkManager::ConnectionSettings::Pppoe:
+        settingTypes << NetworkManager::Setting::Pppoe << NetworkManager::Setting::Security8021x;
+        break;
+    case NetworkManager::ConnectionSettings::Wired:
+        settingTypes << NetworkManager::Setting::Security8021x;
+        break;
+    case NetworkManager::ConnectionSettings::WireGuard:
+        settingTypes << NetworkManager::Setting::WireGuard;
+        break;
+    case NetworkManager::ConnectionSettings::Wireless:
+        settingTypes << NetworkManager::Setting::WirelessSecurity << NetworkManager::Setting::Security8021x;
+        break;
+    case NetworkManager::ConnectionSettings::Vpn:
+        settingTypes << NetworkManager::Setting::Vpn;
+        break;
+    default:
+        break;
+    }
+
+    QStringList settingNames;
+    for (const NetworkManager::Setting::SettingType settingType : qAsConst(settingTypes)) {
+        const NetworkManager::Setting::Ptr setting = connectionSettings->setting(settingType);
+        if (!setting || setting->isNull()) {
+            continue;
+        }
+
+        bool requestSecrets = false;
+        if (settingType == NetworkManager::Setting::Vpn) {
+            const NMStringMap data = setting.staticCast<NetworkManager::VpnSetting>()->data();
+            for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+                if (it.key().endsWith(QStringLiteral("-flags"))) {
+                    NetworkManager::Setting::SecretFlagType secretFlag = (NetworkManager::Setting::SecretFlagType)it.value().toInt();
+                    if (secretFlag == NetworkManager::Setting::None || secretFlag == NetworkManager::Setting::AgentOwned) {
+                        requestSecrets = true;
+                    }
+                }
+            }
+        } else {
+            QStringList requiredSecrets = setting->needSecrets();
+            if (settingType == NetworkManager::Setting::Security8021x) {
+                requiredSecrets.removeAll(NM_SETTING_802_1X_PASSWORD_RAW);
+            }
+
+            const QVariantMap map = setting->toMap();
+            for (const QString &secret : qAsConst(requiredSecrets)) {
+                if (map.contains(secret + QLatin1String("-flags"))) {
+                    NetworkManager::Setting::SecretFlagType secretFlag = (NetworkManager::Setting::SecretFlagType)map.value(secret + QLatin1String("-flags")).toInt();
+                    if (secretFlag == NetworkManager::Setting::None || secretFlag == NetworkManager::Setting::AgentOwned) {
+                        requestSecrets = true;
+                    }
+                } else {
+                    requestSecrets = true;
+                }
+            }
+        }
+
+        if (requestSecrets) {
+            settingNames << setting->name();
+        }
     }
+
+    return settingNames;
 }
 
 void ConnectionEditorBase::replyFinished(QDBusPendingCallWatcher *watcher)
 {
+    watcher->deleteLater();
+
+    // Reply for an earlier load, possibly of the same connection
+    if (watcher->property("generation").toInt() != m_loadGeneration) {
+        return;
+    }
+
     QDBusPendingReply<NMVariantMapMap> reply = *watcher;
     const QString settingName = watcher->property("settingName").toString();
     if (reply.isValid()) {
@@ -466,13 +783,10 @@ void ConnectionEditorBase::replyFinished(QDBusPendingCallWatcher *watcher)
                 NetworkManager::Setting::Ptr setting = m_connection->setting(NetworkManager::Setting::typeFromString(key));
                 if (setting) {
                     setting->secretsFromMap(secrets.value(key));
-                    for (SettingWidget *widget : m_settingWidgets) {
-                        const QString type = widget->type();
-                        if (type == settingName ||
-                                (settingName == NetworkManager::Setting::typeAsString(NetworkManager::Setting::Security8021x) &&
-                                 type == NetworkManager::Setting::typeAsString(NetworkManager::Setting::WirelessSecurity))) {
-                            widget->loadSecrets(setting);
-                        }
+                    // Widgets constructed later pick the secrets up from here
+                    m_loadedSecrets << settingName;
+                    for (SettingWidget *widget : qAsConst(m_settingWidgets)) {
+                        loadSecrets(widget, settingName);
                     }
                 }
             }
@@ -486,12 +800,46 @@ void ConnectionEditorBase::replyFinished(QDBusPendingCallWatcher *watcher)
         notification->sendEvent();
     }
 
-    watcher->deleteLater();
-    validChanged(true);
+    // Late replies after the timeout only fill in the widgets
+    if (m_pendingReplies == 0) {
+        validChanged(true);
+        return;
+    }
 
-    // We should be now fully with secrets
     m_pendingReplies--;
+    if (m_pendingReplies == 0) {
+        secretsLoaded();
+    }
+}
+
+void ConnectionEditorBase::secretsTimeout()
+{
+    if (m_pendingReplies == 0) {
+        return;
+    }
+
+    qCWarning(PLASMA_NM) << "Still waiting for" << m_pendingReplies << "secrets replies after" << m_secretsTimer.interval() << "ms, continuing without them";
+    m_pendingReplies = 0;
+    secretsLoaded();
+}
+
+void ConnectionEditorBase::secretsLoaded()
+{
+    m_secretsTimer.stop();
+
+    // We should be now fully with secrets
     m_initialized = true;
+    validChanged(true);
+}
+
+void ConnectionEditorBase::loadSecrets(SettingWidget *widget, const QString &settingName)
+{
+    const QString type = widget->type();
+    if (type == settingName ||
+            (settingName == NetworkManager::Setting::typeAsString(NetworkManager::Setting::Security8021x) &&
+             type == NetworkManager::Setting::typeAsString(NetworkManager::Setting::WirelessSecurity))) {
+        widget->loadSecrets(m_connection->setting(NetworkManager::Setting::typeFromString(settingName)));
+    }
 }
 
 void ConnectionEditorBase::validChanged(bool valid)
@@ -508,6 +856,19 @@ void ConnectionEditorBase::validChanged(bool valid)
                 return;
             }
         }
+
+        for (const SettingPage &page : qAsConst(m_settingPages)) {
+            if (page.widget) {
+                continue;
+            }
+            for (const NetworkManager::Setting::SettingType type : page.settingTypes) {
+                if (!storedSettingValid(m_connection, type)) {
+                    m_valid = false;
+                    Q_EMIT validityChanged(false);
+                    return;
+                }
+            }
+        }
     }
 
     m_valid = true;
@@ -22,10 +22,13 @@
 #define PLASMA_NM_CONNECTION_EDITOR_BASE_H
 
 #include <QDBusPendingCallWatcher>
+#include <QTimer>
 #include <QWidget>
 
 #include <NetworkManagerQt/ConnectionSettings>
 
+#include <functional>
+
 class ConnectionWidget;
 class SettingWidget;
 
@@ -59,6 +62,7 @@ Q_SIGNALS:
 
 private Q_SLOTS:
     void replyFinished(QDBusPendingCallWatcher *watcher);
+    void secretsTimeout();
     void validChanged(bool valid);
 
 protected:
@@ -71,16 +75,40 @@ protected:
     // Subclassed widget is supposed to call initialization after the UI is initialized
     void initialize();
 
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private:
+    // A tab whose setting widget is only constructed once it is shown for the first time,
+    // until then the stored settings of the connection stand in for it
+    struct SettingPage {
+        QWidget *container = nullptr;
+        SettingWidget *widget = nullptr;
+        QList<NetworkManager::Setting::SettingType> settingTypes;
+        std::function<SettingWidget *(QWidget *parent)> factory;
+    };
+
     bool m_initialized;
     bool m_valid;
     int m_pendingReplies;
+    // Tells the secrets replies of the current load from those of an earlier one
+    int m_loadGeneration = 0;
     NetworkManager::ConnectionSettings::Ptr m_connection;
     ConnectionWidget *m_connectionWidget;
     QList<SettingWidget *> m_settingWidgets;
+    QList<SettingPage> m_settingPages;
+    QStringList m_loadedSecrets;
+    QString m_changedSsid;
+    QTimer m_secretsTimer;
 
     void addConnectionWidget(ConnectionWidget *widget, const QString &text);
-    void addSettingWidget(SettingWidget *widget, const QString &text);
+    void addSettingWidget(const QString &text, const QList<NetworkManager::Setting::SettingType> &settingTypes,
+                          const std::function<SettingWidget *(QWidget *parent)> &factory);
+    void createSettingWidget(SettingPage &page);
+    void loadSecrets(SettingWidget *widget, const QString &settingName);
+    void secretsLoaded();
+
+    // Names of the settings whose secrets have to be requested from the secret agent
+    static QStringList secretSettingNames(const NetworkManager::ConnectionSettings::Ptr &connectionSettings);
 
 };
 
@@ -0,0 +1,85 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "listsegmentcache.h"
+
+void ListSegmentCache::update(const QString &text)
+{
+    if (!m_segments.isEmpty() && text == m_text) {
+        return;
+    }
+
+    // Find the edited range, everything before and after it is unchanged
+    const int oldSize = m_text.size();
+    const int newSize = text.size();
+    const QChar *oldData = m_text.constData();
+    const QChar *newData = text.constData();
+    const int common = qMin(oldSize, newSize);
+
+    int prefix = 0;
+    while (prefix < common && oldData[prefix] == newData[prefix]) {
+        ++prefix;
+    }
+    int suffix = 0;
+    while (suffix < common - prefix && oldData[oldSize - 1 - suffix] == newData[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+
+    QVector<Segment> segments;
+    segments.reserve(m_segments.size() + 1);
+    int start = 0;
+    for (int i = 0; i <= newSize; ++i) {
+        if (i == newSize || newData[i] == QLatin1Char(',')) {
+            Segment segment;
+            segment.start = start;
+            segment.end = i;
+            segments << segment;
+            start = i + 1;
+        }
+    }
+
+    const int oldCount = m_segments.size();
+    const int newCount = segments.size();
+
+    // Segments whose closing comma lies before the edit are the same as before
+    for (int i = 0; i < newCount && i < oldCount && segments.at(i).end < prefix; ++i) {
+        segments[i].validated = m_segments.at(i).validated;
+        segments[i].state = m_segments.at(i).state;
+    }
+
+    // Segments whose opening comma lies after the edit too, counted from the end
+    for (int i = newCount - 1, j = oldCount - 1; i >= 0 && j >= 0 && segments.at(i).start > newSize - suffix; --i, --j) {
+        segments[i].validated = m_segments.at(j).validated;
+        segments[i].state = m_segments.at(j).state;
+    }
+
+    m_text = text;
+    m_segments.swap(segments);
+}
+
+void ListSegmentCache::setText(const QString &text)
+{
+    m_text = text;
+}
+
+QVector<ListSegmentCache::Segment> &ListSegmentCache::segments()
+{
+    return m_segments;
+}
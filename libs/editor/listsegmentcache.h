@@ -0,0 +1,63 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_LIST_SEGMENT_CACHE_H
+#define PLASMA_NM_LIST_SEGMENT_CACHE_H
+
+#include <QString>
+#include <QValidator>
+#include <QVector>
+
+/**
+ * Remembers the comma separated items of the text a list validator saw last,
+ * together with their validation state. After an edit only the items touching
+ * the changed part of the text are marked as not validated, the others keep
+ * their state.
+ */
+class ListSegmentCache
+{
+public:
+    struct Segment {
+        int start = 0;  // position of the first character, after the comma
+        int end = 0;    // position of the next comma or the end of the text
+        bool validated = false;
+        QValidator::State state = QValidator::Intermediate;
+    };
+
+    /**
+     * Splits @p text into segments, carrying over the state of the segments
+     * the edit since the last call did not touch.
+     */
+    void update(const QString &text);
+
+    /**
+     * Records that the validator rewrote the text, the segments have to be
+     * adjusted to it already.
+     */
+    void setText(const QString &text);
+
+    QVector<Segment> &segments();
+
+private:
+    QString m_text;
+    QVector<Segment> m_segments;
+};
+
+#endif // PLASMA_NM_LIST_SEGMENT_CACHE_H
@@ -21,8 +21,6 @@
 
 #include "listvalidator.h"
 
-#include <QStringList>
-
 ListValidator::ListValidator(QObject *parent)
     : QValidator(parent)
     , inner(nullptr)
@@ -38,28 +36,53 @@ QValidator::State ListValidator::validate(QString &text, int &pos) const
     Q_ASSERT(inner);
     Q_UNUSED(pos);
 
-    QStringList strings = text.split(QLatin1Char(','));
+    m_cache.update(text);
+
     int unusedPos;
+    int shift = 0;
+    bool rewritten = false;
+    bool done = false;
     QValidator::State state = Acceptable;
-    for (QStringList::iterator i = strings.begin(); i != strings.end(); ++i) {
-        QString string = i->trimmed();
-        const int position = i->indexOf(string);
-        const int size = string.size();
-        const QValidator::State current = inner->validate(string, unusedPos);
-        i->replace(position, size, string);
-        if (current == Invalid) {
-            state = Invalid;
-            break;
+    for (ListSegmentCache::Segment &segment : m_cache.segments()) {
+        segment.start += shift;
+        segment.end += shift;
+        if (done) {
+            continue;
+        }
+
+        if (!segment.validated) {
+            const QStringRef item = text.midRef(segment.start, segment.end - segment.start);
+            const QStringRef trimmed = item.trimmed();
+            QString string = trimmed.toString();
+            const int position = item.indexOf(string);
+            const int size = string.size();
+            segment.state = inner->validate(string, unusedPos);
+            segment.validated = true;
+            // Only touch the text if the inner validator fixed the item up
+            if (string != trimmed) {
+                text.replace(segment.start + position, size, string);
+                segment.end += string.size() - size;
+                shift += string.size() - size;
+                rewritten = true;
+            }
         }
-        if (current == Intermediate) {
+
+        if (segment.state == Invalid) {
+            state = Invalid;
+            done = true;
+        } else if (segment.state == Intermediate) {
             if (state == Intermediate) {
                 state = Invalid;
-                break;
+                done = true;
+            } else {
+                state = Intermediate;
             }
-            state = Intermediate;
         }
     }
-    text = strings.join(QLatin1Char(','));
+
+    if (rewritten) {
+        m_cache.setText(text);
+    }
     return state;
 }
 
@@ -24,13 +24,16 @@
 
 #include <QValidator>
 
+#include "listsegmentcache.h"
+
 /**
  * This class validates each string item with a validator.
  * String items are separated by comma.
  * The validator should be set with setInnerValidator(..) method.
  * Please note, space characters are allowed only after comma characters.
+ * Only the items touched by the edit since the last call are validated again.
  */
-class ListValidator : public QValidator
+class Q_DECL_EXPORT ListValidator : public QValidator
 {
 public:
     explicit ListValidator(QObject *parent);
@@ -41,6 +44,7 @@ public:
 
 private:
     QValidator *inner;
+    mutable ListSegmentCache m_cache;
 };
 
 #endif // PLASMA_NM_LIST_VALIDATOR_H
@@ -21,17 +21,19 @@
 #include "debug.h"
 #include "mobileproviders.h"
 
-#include <QFile>
-#include <QTextStream>
 #include <QLocale>
 
+#include <ModemManagerQt/modem3gpp.h>
+#include <ModemManagerQt/sim.h>
+
 const QString MobileProviders::ProvidersFile = "/usr/share/mobile-broadband-provider-info/serviceproviders.xml";
 
 bool localeAwareCompare(const QString & one, const QString & two) {
     return one.localeAwareCompare(two) < 0;
 }
 
-MobileProviders::MobileProviders()
+MobileProviders::MobileProviders(const QString &providersFile)
+    : mProvidersFile(providersFile)
 {
     for (int c = 1; c <= QLocale::LastCountry; c++) {
         const auto country = static_cast<QLocale::Country>(c);
@@ -49,36 +51,20 @@ MobileProviders::MobileProviders()
             }
         }
     }
-    mError = Success;
-
-    QFile file2(ProvidersFile);
-
-    if (file2.open(QIODevice::ReadOnly)) {
-        if (mDocProviders.setContent(&file2)) {
-            docElement = mDocProviders.documentElement();
-
-            if (docElement.isNull()) {
-                qCWarning(PLASMA_NM) << ProvidersFile << ": document is null";
-                mError = ProvidersIsNull;
-            } else {
-                if (docElement.isNull() || docElement.tagName() != "serviceproviders") {
-                    qCWarning(PLASMA_NM) << ProvidersFile << ": wrong format";
-                    mError = ProvidersWrongFormat;
-                } else {
-                    if (docElement.attribute("format") != "2.0") {
-                        qCWarning(PLASMA_NM) << ProvidersFile << ": mobile broadband provider database format '" << docElement.attribute("format") << "' not supported.";
-                        mError = ProvidersFormatNotSupported;
-                    } else {
-                        // qCDebug(PLASMA_NM) << "Everything is alright so far";
-                    }
-                }
-            }
-        }
-
-        file2.close();
-    } else {
-        qCWarning(PLASMA_NM) << "Error opening providers file" << ProvidersFile;
+    // The wizard starts with the country of the locale
+    switch (mIndex.open(providersFile, countryFromLocale())) {
+    case MobileProvidersIndex::Ok:
+        mError = Success;
+        break;
+    case MobileProvidersIndex::SourceMissing:
         mError = ProvidersMissing;
+        break;
+    case MobileProvidersIndex::SourceWrongFormat:
+        mError = ProvidersWrongFormat;
+        break;
+    case MobileProvidersIndex::SourceFormatNotSupported:
+        mError = ProvidersFormatNotSupported;
+        break;
     }
 }
 
@@ -88,7 +74,18 @@ MobileProviders::~MobileProviders()
 
 QStringList MobileProviders::getCountryList() const
 {
-    QStringList temp = mCountries.values();
+    if (!mIndex.isValid()) {
+        QStringList temp = mCountries.values();
+        std::sort(temp.begin(), temp.end(), localeAwareCompare);
+        return temp;
+    }
+
+    // Only offer countries with known providers
+    QStringList temp;
+    const QStringList codes = mIndex.countries();
+    for (const QString &code : codes) {
+        temp << mCountries.value(code, code);
+    }
     std::sort(temp.begin(), temp.end(), localeAwareCompare);
     return temp;
 }
@@ -105,72 +102,55 @@ QString MobileProviders::countryFromLocale() const
 
 QStringList MobileProviders::getProvidersList(QString country, NetworkManager::ConnectionSettings::ConnectionType type)
 {
-    mProvidersGsm.clear();
-    mProvidersCdma.clear();
-    QDomNode n = docElement.firstChild();
-
     // country is a country name and we parse country codes.
     if (!mCountries.key(country).isNull()) {
         country = mCountries.key(country);
     }
-    QMap<QString, QString> sortedGsm;
-    QMap<QString, QString> sortedCdma;
-    while (!n.isNull()) {
-        QDomElement e = n.toElement(); // <country ...>
-
-        if (!e.isNull() && e.attribute("code").toUpper() == country) {
-            QDomNode n2 = e.firstChild();
-            while (!n2.isNull()) {
-                QDomElement e2 = n2.toElement(); // <provider ...>
-
-                if (!e2.isNull() && e2.tagName().toLower() == "provider") {
-                    QDomNode n3 = e2.firstChild();
-                    bool hasGsm = false;
-                    bool hasCdma = false;
-                    QMap<QString, QString> localizedProviderNames;
-
-                    while (!n3.isNull()) {
-                        QDomElement e3 = n3.toElement(); // <name | gsm | cdma>
-
-                        if (!e3.isNull()) {
-                            if (e3.tagName().toLower() == "gsm") {
-                                hasGsm = true;
-                            } else if (e3.tagName().toLower() == "cdma") {
-                                hasCdma = true;
-                            } else if (e3.tagName().toLower() == "name") {
-                                QString lang = e3.attribute("xml:lang");
-                                if (lang.isEmpty()) {
-                                    lang = "en";     // English is default
-                                } else {
-                                    lang = lang.toLower();
-                                    lang.remove(QRegExp("\\-.*$"));  // Remove everything after '-' in xml:lang attribute.
-                                }
-                                localizedProviderNames.insert(lang, e3.text());
-                            }
-                        }
-                        n3 = n3.nextSibling();
-                    }
-                    const QString name = getNameByLocale(localizedProviderNames);
-                    if (hasGsm) {
-                        mProvidersGsm.insert(name, e2.firstChild());
-                        sortedGsm.insert(name.toLower(), name);
-                    }
-                    if (hasCdma) {
-                        mProvidersCdma.insert(name, e2.firstChild());
-                        sortedCdma.insert(name.toLower(), name);
-                    }
-                }
-                n2 = n2.nextSibling();
-            }
-            break;
+    if (!mIndex.scope().isEmpty() && mIndex.scope() != country.toUpper()) {
+        mProvidersCountry = country;
+        reopenIndex(country);
+    } else {
+        fillProviders(country);
+    }
+
+    QMap<QString, QString> sortedProviders;
+    const QMap<QString, int> &providers = type == NetworkManager::ConnectionSettings::Gsm ? mProvidersGsm : mProvidersCdma;
+    for (auto it = providers.constBegin(); it != providers.constEnd(); ++it) {
+        sortedProviders.insert(it.key().toLower(), it.key());
+    }
+    return sortedProviders.values();
+}
+
+void MobileProviders::fillProviders(const QString &country)
+{
+    mProvidersGsm.clear();
+    mProvidersCdma.clear();
+    mProvidersCountry = country;
+
+    const QVector<int> providers = mIndex.providers(country);
+    for (int provider : providers) {
+        const int flags = mIndex.providerFlags(provider);
+        const QString name = getNameByLocale(mIndex.providerNames(provider));
+        if (flags & MobileProvidersIndex::Gsm) {
+            mProvidersGsm.insert(name, provider);
+        }
+        if (flags & MobileProvidersIndex::Cdma) {
+            mProvidersCdma.insert(name, provider);
         }
-        n = n.nextSibling();
     }
+}
 
-    if (type == NetworkManager::ConnectionSettings::Gsm) {
-        return sortedGsm.values();
+void MobileProviders::reopenIndex(const QString &scope)
+{
+    // The providers and APNs found so far are positions in the old index
+    mApns.clear();
+    mNetworkIds.clear();
+    mIndex.open(mProvidersFile, scope);
+
+    // Keep the listed providers usable with the new one
+    if (!mProvidersCountry.isEmpty()) {
+        fillProviders(mProvidersCountry);
     }
-    return sortedCdma.values();
 }
 
 QStringList MobileProviders::getApns(const QString & provider)
@@ -181,43 +161,12 @@ QStringList MobileProviders::getApns(const QString & provider)
         return QStringList();
     }
 
-    QDomNode n = mProvidersGsm[provider];
-
-    while (!n.isNull()) {
-        QDomElement e = n.toElement(); // <gsm | cdma>
-
-        if (!e.isNull() && e.tagName().toLower() == "gsm") {
-            QDomNode n2 = e.firstChild();
-            while (!n2.isNull()) {
-                QDomElement e2 = n2.toElement(); // <apn | network-id>
-
-                if (!e2.isNull() && e2.tagName().toLower() == "apn") {
-                    bool isInternet = true;
-                    QDomNode n3 = e2.firstChild();
-                    while (!n3.isNull()) {
-                        QDomElement e3 = n3.toElement(); // <usage>
-                        if (!e3.isNull() &&
-                            e3.tagName().toLower() == "usage" &&
-                            !e3.attribute("type").isNull() &&
-                            e3.attribute("type").toLower() != "internet") {
-                            // qCDebug(PLASMA_NM) << "apn" << e2.attribute("value") << "ignored because of usage" << e3.attribute("type");
-                            isInternet = false;
-                            break;
-                        }
-                        n3 = n3.nextSibling();
-                    }
-                    if (isInternet) {
-                        mApns.insert(e2.attribute("value"), e2.firstChild());
-                    }
-                } else if (!e2.isNull() && e2.tagName().toLower() == "network-id") {
-                    mNetworkIds.append(e2.attribute("mcc") + '-' + e2.attribute("mnc"));
-                }
-
-                n2 = n2.nextSibling();
-            }
-        }
-        n = n.nextSibling();
+    const int index = mProvidersGsm[provider];
+    const QVector<int> apns = mIndex.apns(index);
+    for (int apn : apns) {
+        mApns.insert(mIndex.apnValue(apn), apn);
     }
+    mNetworkIds = mIndex.networkIds(index);
 
     QStringList temp = mApns.keys();
     temp.sort();
@@ -236,42 +185,23 @@ QStringList MobileProviders::getNetworkIds(const QString & provider)
 QVariantMap MobileProviders::getApnInfo(const QString & apn)
 {
     QVariantMap temp;
-    QDomNode n = mApns[apn];
-    QStringList dnsList;
-    QMap<QString, QString> localizedPlanNames;
-
-    while (!n.isNull()) {
-        QDomElement e = n.toElement(); // <name|username|password|dns(*)>
-
-        if (!e.isNull()) {
-            if (e.tagName().toLower() == "name") {
-                QString lang = e.attribute("xml:lang");
-                if (lang.isEmpty()) {
-                    lang = "en";     // English is default
-                } else {
-                    lang = lang.toLower();
-                    lang.remove(QRegExp("\\-.*$"));  // Remove everything after '-' in xml:lang attribute.
-                }
-                localizedPlanNames.insert(lang, e.text());
-            } else if (e.tagName().toLower() == "username") {
-                temp.insert("username", e.text());
-            } else if (e.tagName().toLower() == "password") {
-                temp.insert("password", e.text());
-            } else if (e.tagName().toLower() == "dns") {
-                dnsList.append(e.text());
-            }
-        }
-
-        n = n.nextSibling();
+    const int index = mApns.value(apn, -1);
+    const QString username = mIndex.apnUsername(index);
+    if (!username.isEmpty()) {
+        temp.insert("username", username);
+    }
+    const QString password = mIndex.apnPassword(index);
+    if (!password.isEmpty()) {
+        temp.insert("password", password);
     }
 
-    QString name = getNameByLocale(localizedPlanNames);
+    QString name = getNameByLocale(mIndex.apnNames(index));
     if (!name.isEmpty()) {
         temp.insert("name", QVariant::fromValue(name));
     }
     temp.insert("number", getGsmNumber());
     temp.insert("apn", apn);
-    temp.insert("dnsList", dnsList);
+    temp.insert("dnsList", mIndex.apnDns(index));
 
     return temp;
 }
@@ -283,38 +213,85 @@ QVariantMap MobileProviders::getCdmaInfo(const QString & provider)
     }
 
     QVariantMap temp;
-    QDomNode n = mProvidersCdma[provider];
-    QStringList sidList;
-
-    while (!n.isNull()) {
-        QDomElement e = n.toElement(); // <gsm or cdma ...>
-
-        if (!e.isNull() && e.tagName().toLower() == "cdma") {
-            QDomNode n2 = e.firstChild();
-            while (!n2.isNull()) {
-                QDomElement e2 = n2.toElement(); // <name | username | password | sid>
-
-                if (!e2.isNull()) {
-                    if (e2.tagName().toLower() == "username") {
-                        temp.insert("username", e2.text());
-                    } else if (e2.tagName().toLower() == "password") {
-                        temp.insert("password", e2.text());
-                    } else if (e2.tagName().toLower() == "sid") {
-                        sidList.append(e2.text());
-                    }
-                }
-
-                n2 = n2.nextSibling();
-            }
-        }
-        n = n.nextSibling();
+    const int index = mProvidersCdma[provider];
+    const QString username = mIndex.cdmaUsername(index);
+    if (!username.isEmpty()) {
+        temp.insert("username", username);
+    }
+    const QString password = mIndex.cdmaPassword(index);
+    if (!password.isEmpty()) {
+        temp.insert("password", password);
     }
 
     temp.insert("number", getCdmaNumber());
-    temp.insert("sidList", sidList);
+    temp.insert("sidList", mIndex.sids(index));
     return temp;
 }
 
+bool MobileProviders::findOperator(const QString & operatorCode, QString * country, QString * provider, QString * apn)
+{
+    // The MCC always has three digits, the MNC two or three
+    if (operatorCode.size() < 5 || operatorCode.size() > 6) {
+        return false;
+    }
+    for (const QChar &c : operatorCode) {
+        if (!c.isDigit()) {
+            return false;
+        }
+    }
+
+    const QString networkId = operatorCode.left(3) + '-' + operatorCode.mid(3);
+    QVector<int> providers = mIndex.providersForNetworkId(networkId);
+    if (providers.isEmpty() && !mIndex.scope().isEmpty()) {
+        // The SIM card may come from another country than the locale
+        reopenIndex(QString());
+        providers = mIndex.providersForNetworkId(networkId);
+    }
+    if (providers.isEmpty()) {
+        return false;
+    }
+
+    // Virtual operators share the network of their host, prefer one with APNs
+    int match = providers.first();
+    for (int index : qAsConst(providers)) {
+        if (!mIndex.apns(index).isEmpty()) {
+            match = index;
+            break;
+        }
+    }
+
+    *country = mIndex.providerCountry(match);
+    *provider = getNameByLocale(mIndex.providerNames(match));
+    if (apn) {
+        QStringList apns;
+        for (int index : mIndex.apns(match)) {
+            apns << mIndex.apnValue(index);
+        }
+        apns.sort();
+        *apn = apns.value(0);
+    }
+    return true;
+}
+
+QString MobileProviders::operatorCode(const ModemManager::ModemDevice::Ptr & modem)
+{
+    if (!modem) {
+        return QString();
+    }
+
+    // The home operator, roaming networks do not know the APNs of the SIM card
+    const ModemManager::Sim::Ptr sim = modem->sim();
+    if (sim && !sim->operatorIdentifier().isEmpty()) {
+        return sim->operatorIdentifier();
+    }
+
+    const ModemManager::Modem3gpp::Ptr modem3gpp = modem->interface(ModemManager::ModemDevice::GsmInterface).objectCast<ModemManager::Modem3gpp>();
+    if (modem3gpp) {
+        return modem3gpp->operatorCode();
+    }
+    return QString();
+}
+
 QString MobileProviders::getNameByLocale(const QMap<QString, QString> &localizedNames) const
 {
     QString name;
@@ -23,19 +23,22 @@
 
 #include <QStringList>
 #include <QHash>
-#include <QDomDocument>
 #include <QVariantMap>
 
 #include <NetworkManagerQt/ConnectionSettings>
 
-class MobileProviders
+#include <ModemManagerQt/ModemDevice>
+
+#include "mobileprovidersindex.h"
+
+class Q_DECL_EXPORT MobileProviders
 {
 public:
     static const QString ProvidersFile;
 
     enum ErrorCodes { Success, CountryCodesMissing, ProvidersMissing, ProvidersIsNull, ProvidersWrongFormat, ProvidersFormatNotSupported };
 
-    MobileProviders();
+    explicit MobileProviders(const QString &providersFile = ProvidersFile);
     ~MobileProviders();
 
     QStringList getCountryList() const;
@@ -46,20 +49,37 @@ public:
     QStringList getNetworkIds(const QString & provider);
     QVariantMap getApnInfo(const QString & apn);
     QVariantMap getCdmaInfo(const QString & provider);
+    /*
+     * Looks up the provider of the network with the MCC and MNC in operatorCode, written
+     * together as ModemManager reports them, e.g. "26201". On success country is set to
+     * the country code, provider to the name as listed by getProvidersList() and apn to
+     * the default APN, the one getApns() lists first.
+     */
+    bool findOperator(const QString & operatorCode, QString * country, QString * provider, QString * apn = nullptr);
+    /*
+     * Returns the MCC and MNC of the operator of the SIM card in modem, or of the
+     * network it is registered to when the SIM does not tell.
+     */
+    static QString operatorCode(const ModemManager::ModemDevice::Ptr & modem);
     QString getGsmNumber() const { return QString("*99#"); }
     QString getCdmaNumber() const { return QString("#777"); }
     inline ErrorCodes getError() { return mError; }
 
 private:
+    QString mProvidersFile;
     QHash<QString, QString> mCountries;
-    QMap<QString, QDomNode> mProvidersGsm;
-    QMap<QString, QDomNode> mProvidersCdma;
-    QMap<QString, QDomNode> mApns;
+    // Positions of the providers and APNs in the index
+    QString mProvidersCountry;
+    QMap<QString, int> mProvidersGsm;
+    QMap<QString, int> mProvidersCdma;
+    QMap<QString, int> mApns;
     QStringList mNetworkIds;
-    QDomDocument mDocProviders;
-    QDomElement docElement;
+    MobileProvidersIndex mIndex;
     ErrorCodes mError;
     QString getNameByLocale(const QMap<QString, QString> & names) const;
+    void fillProviders(const QString & country);
+    // Opens the index for scope, an empty one for all countries
+    void reopenIndex(const QString & scope);
 };
 
 #endif // PLASMA_NM_MOBILE_PROVIDERS_H
@@ -0,0 +1,769 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mobileprovidersindex.h"
+#include "debug.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QStringView>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+#include <cstring>
+
+// Bump whenever the layout of the records changes
+static const quint32 indexVersion = 2;
+static const char indexMagic[8] = {'P', 'N', 'M', 'M', 'B', 'P', 'I', '\0'};
+
+enum Section {
+    CountrySection,
+    ProviderSection,
+    NameSection,
+    ApnSection,
+    StringSection,      // lists of strings, e.g. the DNS servers of an APN
+    NetworkIdSection,
+    TextSection,        // the characters of all strings
+    SectionCount
+};
+
+// Position and length in QChars of a string in the text section
+struct MobileProvidersIndex::StringRef
+{
+    quint32 offset = 0;
+    quint32 length = 0;
+};
+
+// Consecutive records of a section
+struct MobileProvidersIndex::Range
+{
+    quint32 first = 0;
+    quint32 count = 0;
+};
+
+struct MobileProvidersIndex::Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 sectionCount;
+    qint64 sourceModified;  // milliseconds since epoch
+    qint64 sourceSize;
+    StringRef sourcePath;   // canonical
+    Range sections[SectionCount]; // byte offset and number of records
+};
+
+// Sorted by code
+struct MobileProvidersIndex::CountryRecord
+{
+    StringRef code;
+    Range providers;
+};
+
+struct MobileProvidersIndex::ProviderRecord
+{
+    Range names;
+    quint32 flags = 0;
+    Range apns;
+    Range networkIds;   // strings
+    StringRef cdmaUsername;
+    StringRef cdmaPassword;
+    Range sids;         // strings
+};
+
+struct MobileProvidersIndex::NameRecord
+{
+    StringRef language;
+    StringRef name;
+};
+
+struct MobileProvidersIndex::ApnRecord
+{
+    StringRef value;
+    Range names;
+    StringRef username;
+    StringRef password;
+    Range dns;          // strings
+};
+
+// Sorted by network id
+struct MobileProvidersIndex::NetworkIdRecord
+{
+    StringRef networkId;
+    quint32 provider = 0;
+};
+
+static bool isElement(const QXmlStreamReader &reader, const char *name)
+{
+    return reader.name().compare(QLatin1String(name), Qt::CaseInsensitive) == 0;
+}
+
+static QString elementText(QXmlStreamReader &reader)
+{
+    return reader.readElementText(QXmlStreamReader::IncludeChildElements);
+}
+
+static QString nameLanguage(const QXmlStreamReader &reader)
+{
+    QString lang = reader.attributes().value(QLatin1String("xml:lang")).toString();
+    if (lang.isEmpty()) {
+        return QStringLiteral("en");     // English is default
+    }
+
+    lang = lang.toLower();
+    const int dash = lang.indexOf(QLatin1Char('-'));
+    if (dash >= 0) {
+        lang.truncate(dash);
+    }
+    return lang;
+}
+
+class MobileProvidersIndex::Builder
+{
+public:
+    Builder(QXmlStreamReader &reader, const QString &scope);
+
+    StringRef addString(const QString &string);
+    Range addStrings(const QStringList &strings);
+    Range addNames(const QMap<QString, QString> &localizedNames);
+    void addCountry();
+    void addProvider();
+    void addApn(QVector<ApnRecord> *providerApns);
+    QByteArray serialize(qint64 sourceModified, qint64 sourceSize, const QString &sourcePath);
+
+    template<typename T> static void appendSection(QByteArray &data, Header *header, int section, const QVector<T> &records);
+
+    QVector<CountryRecord> countries;
+    QVector<ProviderRecord> providers;
+    QVector<NameRecord> names;
+    QVector<ApnRecord> apns;
+    QVector<StringRef> strings;
+    QVector<NetworkIdRecord> networkIds;
+    QString text;
+
+private:
+    QStringView view(const StringRef &ref) const;
+
+    QXmlStreamReader &m_reader;
+    QString m_scope;
+    QHash<QString, StringRef> m_known;
+    QSet<QString> m_countryCodes;
+};
+
+MobileProvidersIndex::Builder::Builder(QXmlStreamReader &reader, const QString &scope)
+    : m_reader(reader)
+    , m_scope(scope.toUpper())
+{
+}
+
+MobileProvidersIndex::StringRef MobileProvidersIndex::Builder::addString(const QString &string)
+{
+    // Languages, user names and many APNs repeat, store them only once
+    auto it = m_known.constFind(string);
+    if (it != m_known.constEnd()) {
+        return it.value();
+    }
+
+    StringRef ref;
+    ref.offset = text.size();
+    ref.length = string.size();
+    text += string;
+    m_known.insert(string, ref);
+    return ref;
+}
+
+MobileProvidersIndex::Range MobileProvidersIndex::Builder::addStrings(const QStringList &list)
+{
+    Range range;
+    range.first = strings.size();
+    range.count = list.size();
+    for (const QString &string : list) {
+        strings << addString(string);
+    }
+    return range;
+}
+
+MobileProvidersIndex::Range MobileProvidersIndex::Builder::addNames(const QMap<QString, QString> &localizedNames)
+{
+    Range range;
+    range.first = names.size();
+    range.count = localizedNames.size();
+    for (auto it = localizedNames.constBegin(); it != localizedNames.constEnd(); ++it) {
+        NameRecord record;
+        record.language = addString(it.key());
+        record.name = addString(it.value());
+        names << record;
+    }
+    return range;
+}
+
+void MobileProvidersIndex::Builder::addCountry()
+{
+    // Only the first entry of a country is used
+    const QString code = m_reader.attributes().value(QLatin1String("code")).toString().toUpper();
+    if (m_countryCodes.contains(code)) {
+        m_reader.skipCurrentElement();
+        return;
+    }
+    m_countryCodes.insert(code);
+
+    CountryRecord record;
+    record.code = addString(code);
+    record.providers.first = providers.size();
+    if (m_scope.isEmpty() || code == m_scope) {
+        while (m_reader.readNextStartElement()) {
+            if (isElement(m_reader, "provider")) {
+                addProvider();
+            } else {
+                m_reader.skipCurrentElement();
+            }
+        }
+    } else {
+        // Outside of the scope only the country itself is listed
+        m_reader.skipCurrentElement();
+    }
+    record.providers.count = providers.size() - record.providers.first;
+    countries << record;
+}
+
+void MobileProvidersIndex::Builder::addProvider()
+{
+    ProviderRecord record;
+    QMap<QString, QString> localizedNames;
+    QVector<ApnRecord> providerApns;
+    QStringList providerNetworkIds;
+    QStringList sidList;
+
+    while (m_reader.readNextStartElement()) {
+        if (isElement(m_reader, "gsm")) {
+            record.flags |= Gsm;
+            while (m_reader.readNextStartElement()) {
+                if (isElement(m_reader, "apn")) {
+                    addApn(&providerApns);
+                } else if (isElement(m_reader, "network-id")) {
+                    const QXmlStreamAttributes attributes = m_reader.attributes();
+                    providerNetworkIds << attributes.value(QLatin1String("mcc")).toString() + QLatin1Char('-') + attributes.value(QLatin1String("mnc")).toString();
+                    m_reader.skipCurrentElement();
+                } else {
+                    m_reader.skipCurrentElement();
+                }
+            }
+        } else if (isElement(m_reader, "cdma")) {
+            record.flags |= Cdma;
+            while (m_reader.readNextStartElement()) {
+                if (isElement(m_reader, "username")) {
+                    record.cdmaUsername = addString(elementText(m_reader));
+                } else if (isElement(m_reader, "password")) {
+                    record.cdmaPassword = addString(elementText(m_reader));
+                } else if (isElement(m_reader, "sid")) {
+                    sidList << elementText(m_reader);
+                } else {
+                    m_reader.skipCurrentElement();
+                }
+            }
+        } else if (isElement(m_reader, "name")) {
+            const QString language = nameLanguage(m_reader);
+            localizedNames.insert(language, elementText(m_reader));
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+
+    record.names = addNames(localizedNames);
+    record.apns.first = apns.size();
+    record.apns.count = providerApns.size();
+    apns << providerApns;
+    record.networkIds = addStrings(providerNetworkIds);
+    record.sids = addStrings(sidList);
+
+    for (const QString &networkId : qAsConst(providerNetworkIds)) {
+        NetworkIdRecord networkIdRecord;
+        networkIdRecord.networkId = addString(networkId);
+        networkIdRecord.provider = providers.size();
+        networkIds << networkIdRecord;
+    }
+    providers << record;
+}
+
+void MobileProvidersIndex::Builder::addApn(QVector<ApnRecord> *providerApns)
+{
+    const QString value = m_reader.attributes().value(QLatin1String("value")).toString();
+    bool isInternet = true;
+    QMap<QString, QString> localizedPlanNames;
+    QString username;
+    QString password;
+    QStringList dnsList;
+
+    while (m_reader.readNextStartElement()) {
+        if (isElement(m_reader, "usage")) {
+            const QXmlStreamAttributes attributes = m_reader.attributes();
+            if (attributes.hasAttribute(QLatin1String("type")) &&
+                attributes.value(QLatin1String("type")).compare(QLatin1String("internet"), Qt::CaseInsensitive) != 0) {
+                isInternet = false;
+            }
+            m_reader.skipCurrentElement();
+        } else if (isElement(m_reader, "name")) {
+            const QString language = nameLanguage(m_reader);
+            localizedPlanNames.insert(language, elementText(m_reader));
+        } else if (isElement(m_reader, "username")) {
+            username = elementText(m_reader);
+        } else if (isElement(m_reader, "password")) {
+            password = elementText(m_reader);
+        } else if (isElement(m_reader, "dns")) {
+            dnsList << elementText(m_reader);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+
+    if (!isInternet) {
+        return;
+    }
+
+    ApnRecord record;
+    record.value = addString(value);
+    record.names = addNames(localizedPlanNames);
+    record.username = addString(username);
+    record.password = addString(password);
+    record.dns = addStrings(dnsList);
+    *providerApns << record;
+}
+
+QStringView MobileProvidersIndex::Builder::view(const StringRef &ref) const
+{
+    return QStringView(text).mid(ref.offset, ref.length);
+}
+
+template<typename T>
+void MobileProvidersIndex::Builder::appendSection(QByteArray &data, Header *header, int section, const QVector<T> &records)
+{
+    // Keep every section aligned for its records
+    data.append(QByteArray((8 - data.size() % 8) % 8, '\0'));
+    header->sections[section].first = data.size();
+    header->sections[section].count = records.size();
+    data.append(reinterpret_cast<const char *>(records.constData()), records.size() * sizeof(T));
+}
+
+QByteArray MobileProvidersIndex::Builder::serialize(qint64 sourceModified, qint64 sourceSize, const QString &sourcePath)
+{
+    std::sort(countries.begin(), countries.end(), [this] (const CountryRecord &a, const CountryRecord &b) {
+        return view(a.code) < view(b.code);
+    });
+    std::stable_sort(networkIds.begin(), networkIds.end(), [this] (const NetworkIdRecord &a, const NetworkIdRecord &b) {
+        return view(a.networkId) < view(b.networkId);
+    });
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, indexMagic, sizeof(header.magic));
+    header.version = indexVersion;
+    header.sectionCount = SectionCount;
+    header.sourceModified = sourceModified;
+    header.sourceSize = sourceSize;
+    header.sourcePath = addString(sourcePath);
+
+    QByteArray data(sizeof(Header), '\0');
+    appendSection(data, &header, CountrySection, countries);
+    appendSection(data, &header, ProviderSection, providers);
+    appendSection(data, &header, NameSection, names);
+    appendSection(data, &header, ApnSection, apns);
+    appendSection(data, &header, StringSection, strings);
+    appendSection(data, &header, NetworkIdSection, networkIds);
+    appendSection(data, &header, TextSection, QVector<QChar>(text.constBegin(), text.constEnd()));
+    memcpy(data.data(), &header, sizeof(header));
+
+    return data;
+}
+
+MobileProvidersIndex::MobileProvidersIndex()
+{
+}
+
+MobileProvidersIndex::~MobileProvidersIndex()
+{
+}
+
+QString MobileProvidersIndex::cacheFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/plasma-nm/serviceproviders.index");
+}
+
+MobileProvidersIndex::Status MobileProvidersIndex::open(const QString &providersFile, const QString &country)
+{
+    close();
+
+    const QFileInfo info(providersFile);
+    if (!info.exists()) {
+        qCWarning(PLASMA_NM) << "Error opening providers file" << providersFile;
+        return SourceMissing;
+    }
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    const QString path = info.canonicalFilePath();
+
+    m_file.setFileName(cacheFileName());
+    if (m_file.open(QIODevice::ReadOnly)) {
+        m_map = m_file.map(0, m_file.size());
+        if (m_map && attach(m_map, m_file.size())) {
+            const Header *header = reinterpret_cast<const Header *>(m_base);
+            if (header->sourceModified == modified && header->sourceSize == info.size() && view(header->sourcePath) == QStringView(path)) {
+                return Ok;
+            }
+        }
+        close();
+    }
+
+    QFile source(providersFile);
+    if (!source.open(QIODevice::ReadOnly)) {
+        qCWarning(PLASMA_NM) << "Error opening providers file" << providersFile;
+        return SourceMissing;
+    }
+
+    // Without a cache the whole database would be indexed again on every run,
+    // only index the country that is asked for then
+    QDir().mkpath(QFileInfo(m_file.fileName()).absolutePath());
+    QSaveFile cache(m_file.fileName());
+    const bool cacheable = cache.open(QIODevice::WriteOnly);
+    if (!cacheable) {
+        qCWarning(PLASMA_NM) << "Cannot store the providers index in" << cache.fileName() << cache.errorString();
+    }
+    const QString scope = cacheable ? QString() : country.toUpper();
+
+    qCDebug(PLASMA_NM) << "Building the index of" << providersFile << scope;
+    const Status status = build(&source, &m_data, modified, info.size(), scope, path);
+    if (status != Ok) {
+        return status;
+    }
+    attach(reinterpret_cast<const uchar *>(m_data.constData()), m_data.size());
+    m_scope = scope;
+
+    if (cacheable && (cache.write(m_data) != m_data.size() || !cache.commit())) {
+        qCWarning(PLASMA_NM) << "Failed to store the providers index in" << cache.fileName() << cache.errorString();
+    }
+
+    return Ok;
+}
+
+void MobileProvidersIndex::close()
+{
+    m_base = nullptr;
+    m_size = 0;
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_file.close();
+    m_data.clear();
+    m_scope.clear();
+}
+
+MobileProvidersIndex::Status MobileProvidersIndex::build(QIODevice *source, QByteArray *index, qint64 sourceModified, qint64 sourceSize,
+                                                         const QString &country, const QString &sourcePath)
+{
+    QXmlStreamReader reader(source);
+    if (!reader.readNextStartElement() || reader.name() != QLatin1String("serviceproviders")) {
+        qCWarning(PLASMA_NM) << "Providers file: wrong format";
+        return SourceWrongFormat;
+    }
+    const QStringRef format = reader.attributes().value(QLatin1String("format"));
+    if (format != QLatin1String("2.0")) {
+        qCWarning(PLASMA_NM) << "Mobile broadband provider database format" << format << "not supported.";
+        return SourceFormatNotSupported;
+    }
+
+    Builder builder(reader, country);
+    while (reader.readNextStartElement()) {
+        builder.addCountry();
+    }
+    if (reader.hasError()) {
+        qCWarning(PLASMA_NM) << "Failed to parse the providers file:" << reader.errorString() << "at line" << reader.lineNumber();
+        return SourceWrongFormat;
+    }
+
+    *index = builder.serialize(sourceModified, sourceSize, sourcePath);
+    return Ok;
+}
+
+bool MobileProvidersIndex::attach(const uchar *data, qint64 size)
+{
+    m_base = nullptr;
+    m_size = 0;
+
+    if (!data || size < qint64(sizeof(Header))) {
+        return false;
+    }
+
+    const Header *header = reinterpret_cast<const Header *>(data);
+    if (memcmp(header->magic, indexMagic, sizeof(indexMagic)) || header->version != indexVersion || header->sectionCount != SectionCount) {
+        return false;
+    }
+
+    for (int section = 0; section < SectionCount; ++section) {
+        const Range &range = header->sections[section];
+        if (range.first % 4 || range.first + range.count * recordSize(section) > size) {
+            return false;
+        }
+    }
+
+    m_base = data;
+    m_size = size;
+    return true;
+}
+
+qint64 MobileProvidersIndex::recordSize(int section)
+{
+    switch (section) {
+    case CountrySection:
+        return sizeof(CountryRecord);
+    case ProviderSection:
+        return sizeof(ProviderRecord);
+    case NameSection:
+        return sizeof(NameRecord);
+    case ApnSection:
+        return sizeof(ApnRecord);
+    case StringSection:
+        return sizeof(StringRef);
+    case NetworkIdSection:
+        return sizeof(NetworkIdRecord);
+    case TextSection:
+        return sizeof(QChar);
+    }
+    return 0;
+}
+
+bool MobileProvidersIndex::isValid() const
+{
+    return m_base;
+}
+
+QString MobileProvidersIndex::scope() const
+{
+    return m_scope;
+}
+
+template<typename T>
+const T *MobileProvidersIndex::records(int section, int *count) const
+{
+    if (!m_base) {
+        *count = 0;
+        return nullptr;
+    }
+
+    const Range &range = reinterpret_cast<const Header *>(m_base)->sections[section];
+    *count = range.count;
+    return reinterpret_cast<const T *>(m_base + range.first);
+}
+
+template<typename T>
+const T *MobileProvidersIndex::record(int section, int index) const
+{
+    int count;
+    const T *first = records<T>(section, &count);
+    if (index < 0 || index >= count) {
+        return nullptr;
+    }
+    return first + index;
+}
+
+QStringView MobileProvidersIndex::view(const StringRef &ref) const
+{
+    int count;
+    const QChar *text = records<QChar>(TextSection, &count);
+    if (ref.offset > quint32(count) || ref.length > count - ref.offset) {
+        return QStringView();
+    }
+    return QStringView(text + ref.offset, ref.length);
+}
+
+QString MobileProvidersIndex::string(const StringRef &ref) const
+{
+    // Copied, the strings must stay valid after the index is gone
+    return view(ref).toString();
+}
+
+QStringList MobileProvidersIndex::stringList(const Range &range) const
+{
+    QStringList result;
+    for (int i : indexes(range, StringSection)) {
+        result << string(*record<StringRef>(StringSection, i));
+    }
+    return result;
+}
+
+QMap<QString, QString> MobileProvidersIndex::names(const Range &range) const
+{
+    QMap<QString, QString> result;
+    for (int i : indexes(range, NameSection)) {
+        const NameRecord *name = record<NameRecord>(NameSection, i);
+        result.insert(string(name->language), string(name->name));
+    }
+    return result;
+}
+
+QVector<int> MobileProvidersIndex::indexes(const Range &range, int section) const
+{
+    int count;
+    records<char>(section, &count);
+
+    QVector<int> result;
+    if (range.first > quint32(count) || range.count > count - range.first) {
+        return result;
+    }
+
+    result.reserve(range.count);
+    for (quint32 i = 0; i < range.count; ++i) {
+        result << range.first + i;
+    }
+    return result;
+}
+
+QStringList MobileProvidersIndex::countries() const
+{
+    int count;
+    const CountryRecord *first = records<CountryRecord>(CountrySection, &count);
+
+    QStringList result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        result << string(first[i].code);
+    }
+    return result;
+}
+
+QVector<int> MobileProvidersIndex::providers(const QString &country) const
+{
+    int count;
+    const CountryRecord *first = records<CountryRecord>(CountrySection, &count);
+    const CountryRecord *last = first + count;
+
+    const CountryRecord *it = std::lower_bound(first, last, country, [this] (const CountryRecord &record, const QString &code) {
+        return view(record.code) < QStringView(code);
+    });
+    if (it == last || view(it->code) != QStringView(country)) {
+        return QVector<int>();
+    }
+
+    return indexes(it->providers, ProviderSection);
+}
+
+QVector<int> MobileProvidersIndex::providersForNetworkId(const QString &networkId) const
+{
+    int count;
+    const NetworkIdRecord *first = records<NetworkIdRecord>(NetworkIdSection, &count);
+    const NetworkIdRecord *last = first + count;
+
+    const NetworkIdRecord *it = std::lower_bound(first, last, networkId, [this] (const NetworkIdRecord &record, const QString &id) {
+        return view(record.networkId) < QStringView(id);
+    });
+
+    QVector<int> result;
+    for (; it != last && view(it->networkId) == QStringView(networkId); ++it) {
+        result << it->provider;
+    }
+    return result;
+}
+
+QMap<QString, QString> MobileProvidersIndex::providerNames(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? names(record->names) : QMap<QString, QString>();
+}
+
+QString MobileProvidersIndex::providerCountry(int provider) const
+{
+    int count;
+    const CountryRecord *countries = records<CountryRecord>(CountrySection, &count);
+    for (int i = 0; i < count; ++i) {
+        const Range &providers = countries[i].providers;
+        if (provider >= 0 && quint32(provider) >= providers.first && quint32(provider) - providers.first < providers.count) {
+            return string(countries[i].code);
+        }
+    }
+    return QString();
+}
+
+int MobileProvidersIndex::providerFlags(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? record->flags : 0;
+}
+
+QStringList MobileProvidersIndex::networkIds(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? stringList(record->networkIds) : QStringList();
+}
+
+QString MobileProvidersIndex::cdmaUsername(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? string(record->cdmaUsername) : QString();
+}
+
+QString MobileProvidersIndex::cdmaPassword(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? string(record->cdmaPassword) : QString();
+}
+
+QStringList MobileProvidersIndex::sids(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? stringList(record->sids) : QStringList();
+}
+
+QVector<int> MobileProvidersIndex::apns(int provider) const
+{
+    const ProviderRecord *record = this->record<ProviderRecord>(ProviderSection, provider);
+    return record ? indexes(record->apns, ApnSection) : QVector<int>();
+}
+
+QString MobileProvidersIndex::apnValue(int apn) const
+{
+    const ApnRecord *record = this->record<ApnRecord>(ApnSection, apn);
+    return record ? string(record->value) : QString();
+}
+
+QMap<QString, QString> MobileProvidersIndex::apnNames(int apn) const
+{
+    const ApnRecord *record = this->record<ApnRecord>(ApnSection, apn);
+    return record ? names(record->names) : QMap<QString, QString>();
+}
+
+QString MobileProvidersIndex::apnUsername(int apn) const
+{
+    const ApnRecord *record = this->record<ApnRecord>(ApnSection, apn);
+    return record ? string(record->username) : QString();
+}
+
+QString MobileProvidersIndex::apnPassword(int apn) const
+{
+    const ApnRecord *record = this->record<ApnRecord>(ApnSection, apn);
+    return record ? string(record->password) : QString();
+}
+
+QStringList MobileProvidersIndex::apnDns(int apn) const
+{
+    const ApnRecord *record = this->record<ApnRecord>(ApnSection, apn);
+    return record ? stringList(record->dns) : QStringList();
+}
@@ -0,0 +1,159 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_MOBILE_PROVIDERS_INDEX_H
+#define PLASMA_NM_MOBILE_PROVIDERS_INDEX_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QMap>
+#include <QStringList>
+#include <QStringView>
+#include <QVector>
+
+class QIODevice;
+
+/**
+ * Compiled form of the mobile broadband provider database.
+ *
+ * The index holds fixed size records for countries, providers and APNs
+ * which refer to each other and to a shared string table by position,
+ * plus the providers sorted by the MCC/MNC of their networks. It is built
+ * once from serviceproviders.xml, stored in the user cache together with
+ * the path and modification time of the XML file and memory-mapped on
+ * later runs, so looking up a country or network needs no XML parsing.
+ *
+ * Providers and APNs are identified by their position in the index.
+ */
+class Q_DECL_EXPORT MobileProvidersIndex
+{
+public:
+    enum Status { Ok, SourceMissing, SourceWrongFormat, SourceFormatNotSupported };
+    enum ProviderFlag { Gsm = 0x1, Cdma = 0x2 };
+
+    MobileProvidersIndex();
+    ~MobileProvidersIndex();
+
+    /**
+     * Opens the index of @p providersFile from the user cache, building and
+     * storing it first if it is missing or does not match the file.
+     *
+     * When the cache cannot be written the index is only kept in memory and
+     * limited to the providers of @p country, if given, see scope().
+     */
+    Status open(const QString &providersFile, const QString &country = QString());
+
+    /**
+     * Builds the index of the database read from @p source into @p index.
+     * The modification time, size and canonical @p sourcePath of the file
+     * are recorded in the index for detecting when it is outdated or was
+     * built from another file.
+     *
+     * The XML is streamed. With a @p country only the providers of that
+     * country are read, the subtrees of all other countries are skipped and
+     * just their codes are indexed.
+     */
+    static Status build(QIODevice *source, QByteArray *index, qint64 sourceModified = 0, qint64 sourceSize = 0,
+                        const QString &country = QString(), const QString &sourcePath = QString());
+
+    /**
+     * Uses the index in @p data, which has to outlive this object.
+     */
+    bool attach(const uchar *data, qint64 size);
+
+    static QString cacheFileName();
+
+    bool isValid() const;
+    /**
+     * The country the providers are limited to, empty if the index covers
+     * the whole database.
+     */
+    QString scope() const;
+
+    /**
+     * The ISO 3166 codes of all countries in the database, sorted.
+     */
+    QStringList countries() const;
+
+    /**
+     * The providers of the country with the ISO 3166 code @p country.
+     */
+    QVector<int> providers(const QString &country) const;
+    /**
+     * The providers operating the network with the MCC and MNC in
+     * @p networkId, written as "mcc-mnc".
+     */
+    QVector<int> providersForNetworkId(const QString &networkId) const;
+
+    /**
+     * Maps the languages to the localized names.
+     */
+    QMap<QString, QString> providerNames(int provider) const;
+    /**
+     * The ISO 3166 code of the country of the provider.
+     */
+    QString providerCountry(int provider) const;
+    int providerFlags(int provider) const;
+    QStringList networkIds(int provider) const;
+    QString cdmaUsername(int provider) const;
+    QString cdmaPassword(int provider) const;
+    QStringList sids(int provider) const;
+
+    /**
+     * The APNs of the provider meant for internet access.
+     */
+    QVector<int> apns(int provider) const;
+    QString apnValue(int apn) const;
+    QMap<QString, QString> apnNames(int apn) const;
+    QString apnUsername(int apn) const;
+    QString apnPassword(int apn) const;
+    QStringList apnDns(int apn) const;
+
+private:
+    // Layout of the index, see the implementation
+    struct Header;
+    struct StringRef;
+    struct Range;
+    struct CountryRecord;
+    struct ProviderRecord;
+    struct NameRecord;
+    struct ApnRecord;
+    struct NetworkIdRecord;
+    class Builder;
+
+    void close();
+    static qint64 recordSize(int section);
+    template<typename T> const T *records(int section, int *count) const;
+    template<typename T> const T *record(int section, int index) const;
+    QStringView view(const StringRef &ref) const;
+    QString string(const StringRef &ref) const;
+    QStringList stringList(const Range &range) const;
+    QMap<QString, QString> names(const Range &range) const;
+    QVector<int> indexes(const Range &range, int section) const;
+
+    QFile m_file;
+    uchar *m_map = nullptr;
+    QByteArray m_data;
+    QString m_scope;
+    const uchar *m_base = nullptr;
+    qint64 m_size = 0;
+};
+
+#endif // PLASMA_NM_MOBILE_PROVIDERS_INDEX_H
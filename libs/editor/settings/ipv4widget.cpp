@@ -257,14 +257,7 @@ QVariantMap IPv4Widget::setting() const
 
     // addresses
     if (m_ui->tableViewAddresses->isEnabled()) {
-        QList<NetworkManager::IpAddress> list;
-        for (int i = 0, rowCount = d->model.rowCount(); i < rowCount; i++) {
-            NetworkManager::IpAddress address;
-            address.setIp(QHostAddress(d->model.item(i, 0)->text()));
-            address.setNetmask(QHostAddress(d->model.item(i, 1)->text()));
-            address.setGateway(QHostAddress(d->model.item(i, 2)->text()));
-            list << address;
-        }
+        const QList<NetworkManager::IpAddress> list = addresses();
         if (!list.isEmpty()) {
             ipv4Setting.setAddresses(list);
         }
@@ -400,6 +393,19 @@ void IPv4Widget::tableViewItemChanged(QStandardItem *item)
     }
 }
 
+QList<NetworkManager::IpAddress> IPv4Widget::addresses() const
+{
+    QList<NetworkManager::IpAddress> list;
+    for (int i = 0, rowCount = d->model.rowCount(); i < rowCount; i++) {
+        NetworkManager::IpAddress address;
+        address.setIp(QHostAddress(d->model.item(i, 0)->text()));
+        address.setNetmask(QHostAddress(d->model.item(i, 1)->text()));
+        address.setGateway(QHostAddress(d->model.item(i, 2)->text()));
+        list << address;
+    }
+    return list;
+}
+
 void IPv4Widget::slotRoutesDialog()
 {
     QPointer<IpV4RoutesWidget> dlg = new IpV4RoutesWidget(this);
@@ -408,6 +414,8 @@ void IPv4Widget::slotRoutesDialog()
     dlg->setNeverDefault(m_tmpIpv4Setting.neverDefault());
     if (m_ui->method->currentIndex() == 2) {  // manual
         dlg->setIgnoreAutoRoutesCheckboxEnabled(false);
+        // Only the manual addresses are known up front
+        dlg->setAddresses(addresses());
     } else {
         dlg->setIgnoreAutoRoutes(m_tmpIpv4Setting.ignoreAutoRoutes());
     }
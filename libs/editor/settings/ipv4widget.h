@@ -62,6 +62,8 @@ private Q_SLOTS:
     void tableViewItemChanged(QStandardItem * item);
 
 private:
+    QList<NetworkManager::IpAddress> addresses() const;
+
     Ui::IPv4Widget * m_ui;
     NetworkManager::Ipv4Setting m_tmpIpv4Setting;
 
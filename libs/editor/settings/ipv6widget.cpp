@@ -233,16 +233,7 @@ QVariantMap IPv6Widget::setting() const
 
     // addresses
     if (m_ui->tableViewAddresses->isEnabled()) {
-        QList<NetworkManager::IpAddress> list;
-        for (int i = 0, rowCount = d->model.rowCount(); i < rowCount; i++) {
-            NetworkManager::IpAddress address;
-            address.setIp(QHostAddress(d->model.item(i, 0)->text()));
-            address.setPrefixLength(d->model.item(i, 1)->text().toInt());
-            address.setGateway(QHostAddress(d->model.item(i, 2)->text()));
-
-            list << address;
-        }
-        ipv6Setting.setAddresses(list);
+        ipv6Setting.setAddresses(addresses());
     }
 
     // may-fail
@@ -379,6 +370,20 @@ void IPv6Widget::tableViewItemChanged(QStandardItem *item)
     }
 }
 
+QList<NetworkManager::IpAddress> IPv6Widget::addresses() const
+{
+    QList<NetworkManager::IpAddress> list;
+    for (int i = 0, rowCount = d->model.rowCount(); i < rowCount; i++) {
+        NetworkManager::IpAddress address;
+        address.setIp(QHostAddress(d->model.item(i, 0)->text()));
+        address.setPrefixLength(d->model.item(i, 1)->text().toInt());
+        address.setGateway(QHostAddress(d->model.item(i, 2)->text()));
+
+        list << address;
+    }
+    return list;
+}
+
 void IPv6Widget::slotRoutesDialog()
 {
     QPointer<IpV6RoutesWidget> dlg = new IpV6RoutesWidget(this);
@@ -387,6 +392,8 @@ void IPv6Widget::slotRoutesDialog()
     dlg->setNeverDefault(m_tmpIpv6Setting.neverDefault());
     if (m_ui->method->currentIndex() == 3) {  // manual
         dlg->setIgnoreAutoRoutesCheckboxEnabled(false);
+        // Only the manual addresses are known up front
+        dlg->setAddresses(addresses());
     } else {
         dlg->setIgnoreAutoRoutes(m_tmpIpv6Setting.ignoreAutoRoutes());
     }
@@ -61,6 +61,8 @@ private Q_SLOTS:
     void tableViewItemChanged(QStandardItem * item);
 
 private:
+    QList<NetworkManager::IpAddress> addresses() const;
+
     Ui::IPv6Widget * m_ui;
     NetworkManager::Ipv6Setting m_tmpIpv6Setting;
 
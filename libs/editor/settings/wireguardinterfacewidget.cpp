@@ -24,6 +24,7 @@
 #include "simpleipv4addressvalidator.h"
 #include "simpleiplistvalidator.h"
 #include "wireguardkeyvalidator.h"
+#include "wireguardpeermodel.h"
 
 #include <QFile>
 #include <QFileInfo>
@@ -399,26 +400,18 @@ NMVariantMapMap WireGuardInterfaceWidget::importConnectionSettings(const QString
     }
 
     const QString connectionName = QFileInfo(fileName).completeBaseName();
-    NMStringMap dataMap;
     NMVariantMapList peers;
-    QVariantMap ipv4Data;
-    QVariantMap *currentPeer = nullptr;
     WireGuardKeyValidator keyValidator;
+    WireGuardPeerReader peerReader([&peers] (const QVariantMap &peer) {
+        peers.append(peer);
+    });
     NetworkManager::Ipv4Setting ipv4Setting;
     NetworkManager::Ipv6Setting ipv6Setting;
     NetworkManager::WireGuardSetting wgSetting;
 
-    QString proxyType;
-    QString proxyUser;
-    QString proxyPasswd;
     bool havePrivateKey = false;
     bool haveIpv4Setting = false;
     bool haveIpv6Setting = false;
-    // Set the "PEER" elements true because they
-    // need to be true to allocate the
-    // first [Peer] section below
-    bool havePublicKey = true;
-    bool haveAllowedIps = true;
     int pos = 0;
 
     QTextStream in(&impFile);
@@ -427,52 +420,32 @@ NMVariantMapMap WireGuardInterfaceWidget::importConnectionSettings(const QString
     ipv4Setting.setMethod(NetworkManager::Ipv4Setting::Disabled);
     ipv6Setting.setMethod(NetworkManager::Ipv6Setting::Ignored);
 
-    while (!in.atEnd()) {
-        QStringList keyValue;
-        QString line = in.readLine();
-
-        // Remove comments starting with '#'
-        if (int index = line.indexOf('#') > 0)
-            line.truncate(index);
-
-        // Ignore blank lines
-        if (line.isEmpty())
-            continue;
-
-        keyValue.clear();
-        keyValue << line.split('=');
-
-        if (keyValue[0] == PNM_WG_CONF_TAG_INTERFACE) {
+    QString key;
+    QString value;
+    while (WireGuardPeerReader::readLine(in, key, value)) {
+        if (key == PNM_WG_CONF_TAG_INTERFACE) {
+            // A peer section ends here, it is an error if it is incomplete
+            if (!peerReader.finish()) {
+                return result;
+            }
             currentState = INTERFACE_SECTION;
             continue;
-        } else if (keyValue[0] == PNM_WG_CONF_TAG_PEER) {
+        } else if (key == PNM_WG_CONF_TAG_PEER) {
             // Check to make sure the previous PEER section has
             // all the required elements. If not it's an error
             // so just return the empty result.
-            if (!havePublicKey || !haveAllowedIps) {
+            if (!peerReader.startPeer()) {
                 return result;
-            } else {
-                havePublicKey = false;
-                haveAllowedIps = false;
-                currentState = PEER_SECTION;
-                peers.append(*(new QVariantMap));
-                currentPeer = &peers[peers.size() - 1];
-                continue;
             }
-        }
-
-        // If we didn't get an '=' sign in the line, it's probably an error but
-        // we're going to treat it as a comment and ignore it
-        if (keyValue.length() < 2)
+            currentState = PEER_SECTION;
             continue;
-
-        QString key = keyValue[0].trimmed();
+        }
 
         // If we are in the [Interface] section look for the possible tags
         if (currentState == INTERFACE_SECTION) {
             // Address
             if (key == PNM_WG_CONF_TAG_ADDRESS) {
-                QStringList valueList = keyValue[1].split(',');
+                QStringList valueList = value.split(',');
                 if (valueList.isEmpty())
                     return result;
 
@@ -503,23 +476,17 @@ NMVariantMapMap WireGuardInterfaceWidget::importConnectionSettings(const QString
 
             // Listen Port
             else if (key == PNM_WG_CONF_TAG_LISTEN_PORT) {
-                uint val = keyValue[1].toUInt();
+                uint val = value.toUInt();
                 if (val <= 65535)
                     wgSetting.setListenPort(val);
             } else if (key == PNM_WG_CONF_TAG_PRIVATE_KEY) {
-                QString val = keyValue[1].trimmed();
-                // WireGuard keys present a slight problem because they
-                // must end in '=' which is removed during the 'split' above
-                // so if there are 3 parts and the 3 is empty, there must
-                // have been an '=' so add it back on
-                if (keyValue.size() == 3 && keyValue[2].isEmpty())
-                    val += "=";
+                QString val = value;
                 if (QValidator::Acceptable == keyValidator.validate(val, pos)) {
                     wgSetting.setPrivateKey(val);
                     havePrivateKey = true;
                 }
             } else if (key == PNM_WG_CONF_TAG_DNS) {
-                QStringList addressList = keyValue[1].split(',');
+                QStringList addressList = value.split(',');
                 QList<QHostAddress> ipv4DnsList;
                 QList<QHostAddress> ipv6DnsList;
                 if (!addressList.isEmpty()) {
@@ -552,15 +519,15 @@ NMVariantMapMap WireGuardInterfaceWidget::importConnectionSettings(const QString
                     haveIpv6Setting = true;
                 }
             } else if (key == PNM_WG_CONF_TAG_MTU) {
-                uint val = keyValue[1].toUInt();
+                uint val = value.toUInt();
                 if (val > 0)
                     wgSetting.setMtu(val);
             } else if (key == PNM_WG_CONF_TAG_FWMARK) {
                 uint val;
-                if (keyValue[1].trimmed().toLower() == QLatin1String("off"))
+                if (value.toLower() == QLatin1String("off"))
                     val = 0;
                 else
-                    val = keyValue[1].toUInt();
+                    val = value.toUInt();
                 wgSetting.setFwmark(val);
             } else if (key == PNM_WG_CONF_TAG_TABLE
                      || key == PNM_WG_CONF_TAG_PRE_UP
@@ -574,52 +541,12 @@ NMVariantMapMap WireGuardInterfaceWidget::importConnectionSettings(const QString
                 break;
             }
         } else if (currentState == PEER_SECTION) {
-            // Public Key
-            if (key == PNM_WG_CONF_TAG_PUBLIC_KEY) {
-                QString val = keyValue[1].trimmed();
-                // WireGuard keys present a slight problem because they
-                // must end in '=' which is removed during the 'split' above
-                // so if there are 3 parts and the 3 is empty, there must
-                // have been an '=' so add it back on
-                if (keyValue.size() == 3 && keyValue[2].isEmpty())
-                    val += "=";
-
-                if (QValidator::Acceptable == keyValidator.validate(val, pos)) {
-                    currentPeer->insert(PNM_WG_PEER_KEY_PUBLIC_KEY, val);
-                    havePublicKey = true;
-                }
-            } else if (key == PNM_WG_CONF_TAG_ALLOWED_IPS) {
-                SimpleIpListValidator validator(SimpleIpListValidator::WithCidr, SimpleIpListValidator::Both);
-                QString val = keyValue[1].trimmed();
-                if (QValidator::Acceptable == validator.validate(val, pos))
-                {
-                    QStringList valList = val.split(',');
-                    for (QString& str : valList)
-                        str = str.trimmed();
-                    currentPeer->insert(PNM_WG_PEER_KEY_ALLOWED_IPS, valList);
-                    haveAllowedIps = true;
-                }
-            } else if (key == PNM_WG_CONF_TAG_ENDPOINT) {
-                if (keyValue[1].length() > 0)
-                    currentPeer->insert(PNM_WG_PEER_KEY_ENDPOINT, keyValue[1].trimmed());
-            } else if (key == PNM_WG_CONF_TAG_PRESHARED_KEY) {
-                QString val = keyValue[1].trimmed();
-                // WireGuard keys present a slight problem because they
-                // must end in '=' which is removed during the 'split' above
-                // so if there are 3 parts and the 3 is empty, there must
-                // have been an '=' so add it back on
-                if (keyValue.size() == 3 && keyValue[2].isEmpty())
-                    val += "=";
-
-                if (QValidator::Acceptable == keyValidator.validate(val, pos)) {
-                    currentPeer->insert(PNM_WG_PEER_KEY_PRESHARED_KEY, val);
-                }
-            }
+            peerReader.readValue(key, value);
         } else {
             return result;
         }
     }
-    if (!havePrivateKey || !haveAllowedIps || !havePublicKey || !haveAllowedIps)
+    if (!havePrivateKey || !peerReader.finish())
         return result;
 
     QVariantMap conn;
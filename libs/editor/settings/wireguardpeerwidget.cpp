@@ -19,6 +19,7 @@
 */
 #include "debug.h"
 #include "wireguardpeerwidget.h"
+#include "cidraggregator.h"
 #include "wireguardtabwidget.h"
 #include "ui_wireguardpeerwidget.h"
 #include "uiutils.h"
@@ -35,6 +36,7 @@
 #include <KColorScheme>
 #include <KConfig>
 #include <KConfigGroup>
+#include <KMessageBox>
 
 // Keys for the NetworkManager configuration
 #define PNM_SETTING_WIREGUARD_SETTING_NAME "wireguard"
@@ -102,6 +104,7 @@ WireGuardPeerWidget::WireGuardPeerWidget(const QVariantMap &peerData, QWidget *p
                          "WireGuard peers properties"));
     connect(d->ui.publicKeyLineEdit, &QLineEdit::textChanged, this, &WireGuardPeerWidget::checkPublicKeyValid);
     connect(d->ui.allowedIPsLineEdit, &QLineEdit::textChanged, this, &WireGuardPeerWidget::checkAllowedIpsValid);
+    connect(d->ui.aggregateButton, &QPushButton::clicked, this, &WireGuardPeerWidget::aggregateAllowedIps);
     connect(d->ui.endpointAddressLineEdit, &QLineEdit::textChanged, this, &WireGuardPeerWidget::checkEndpointValid);
     connect(d->ui.endpointPortLineEdit, &QLineEdit::textChanged, this, &WireGuardPeerWidget::checkEndpointValid);
     connect(d->ui.presharedKeyLineEdit, &PasswordField::textChanged, this, &WireGuardPeerWidget::checkPresharedKeyValid);
@@ -190,6 +193,7 @@ void WireGuardPeerWidget::checkAllowedIpsValid()
 
     bool valid = QValidator::Acceptable == allowedIPsValidator.validate(ipString, pos);
     setBackground(widget, valid);
+    d->ui.aggregateButton->setEnabled(valid);
 
     ipList.reserve(rawIPList.size());
     for (const QString &ip : rawIPList) {
@@ -203,6 +207,24 @@ void WireGuardPeerWidget::checkAllowedIpsValid()
     }
 }
 
+void WireGuardPeerWidget::aggregateAllowedIps()
+{
+    const QStringList ipList = d->peerData[PNM_WG_PEER_KEY_ALLOWED_IPS].toStringList();
+    const QStringList aggregated = CidrAggregator::aggregate(ipList);
+
+    // Even without merging anything, host bits may have been cleared
+    d->ui.allowedIPsLineEdit->setText(aggregated.join(","));
+
+    if (aggregated.size() == ipList.size()) {
+        KMessageBox::information(this, i18n("The allowed IPs cannot be merged any further."),
+                                 i18n("Aggregate Allowed IPs"));
+    } else {
+        KMessageBox::information(this, i18np("Merged %2 allowed IPs into %1 prefix.",
+                                             "Merged %2 allowed IPs into %1 prefixes.", aggregated.size(), ipList.size()),
+                                 i18n("Aggregate Allowed IPs"));
+    }
+}
+
 WireGuardPeerWidget::EndPointValid WireGuardPeerWidget::isEndpointValid(QString &address, QString &port)
 {
     // Create a Reg Expression validator to do a simple check for a valid qualified domain name
@@ -47,6 +47,7 @@ private:
     void checkPublicKeyValid();
     void checkPresharedKeyValid();
     void checkAllowedIpsValid();
+    void aggregateAllowedIps();
     void checkEndpointValid();
     void updatePeerWidgets();
     void saveKeepAlive();
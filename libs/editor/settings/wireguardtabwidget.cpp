@@ -19,6 +19,7 @@
 */
 #include "debug.h"
 #include "wireguardtabwidget.h"
+#include "wireguardinterfacewidget.h"
 #include "wireguardpeerwidget.h"
 #include "ui_wireguardtabwidget.h"
 #include "ui_wireguardpeerwidget.h"
@@ -26,8 +27,13 @@
 #include "simpleipv4addressvalidator.h"
 #include "simpleiplistvalidator.h"
 #include "wireguardkeyvalidator.h"
+#include "wireguardpeermodel.h"
 
-#include <QStandardItemModel>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QStandardPaths>
+#include <QTextStream>
 
 #include <NetworkManagerQt/Utils>
 #include <NetworkManagerQt/Ipv4Setting>
@@ -35,6 +41,9 @@
 #include <KColorScheme>
 #include <KConfig>
 #include <KConfigGroup>
+#include <KMessageBox>
+
+#include <algorithm>
 
 // Keys for the NetworkManager configuration
 #define PNM_SETTING_WIREGUARD_SETTING_NAME "wireguard"
@@ -49,9 +58,6 @@
 #define PNM_WG_PEER_KEY_PRESHARED_KEY_FLAGS  "preshared-key-flags"
 #define PNM_WG_PEER_KEY_PUBLIC_KEY           "public-key"
 
-static WireGuardKeyValidator keyValidator();
-static SimpleIpListValidator allowedIPsValidator(SimpleIpListValidator::WithCidr, SimpleIpListValidator::Both);
-
 class WireGuardTabWidget::Private
 {
 public:
@@ -61,13 +67,17 @@ public:
     Ui_WireGuardTabWidget ui;
     NetworkManager::WireGuardSetting::Ptr setting;
     KSharedConfigPtr config;
-    NMVariantMapList peers;
-    int currentIndex;
-    bool currentPeerValid;
-    bool otherPeersValid;
+    WireGuardPeerModel model;
+    // Only the selected peer gets an editor, the others are plain table rows
+    WireGuardPeerWidget *editor;
+    int editorRow;
+
+    void commitEditor();
 };
 
 WireGuardTabWidget::Private::Private(void)
+    : editor(nullptr)
+    , editorRow(-1)
 {
 }
 
@@ -75,6 +85,13 @@ WireGuardTabWidget::Private::~Private()
 {
 }
 
+void WireGuardTabWidget::Private::commitEditor()
+{
+    if (editor && editorRow >= 0) {
+        model.setPeer(editorRow, editor->setting(), editor->isValid());
+    }
+}
+
 WireGuardTabWidget::WireGuardTabWidget(const NMVariantMapList &peerData, QWidget *parent, Qt::WindowFlags f)
     : QDialog(parent, f)
     , d(new Private)
@@ -84,8 +101,17 @@ WireGuardTabWidget::WireGuardTabWidget(const NMVariantMapList &peerData, QWidget
     d->config = KSharedConfig::openConfig();
     setWindowTitle(i18nc("@title: window wireguard peers properties",
                          "WireGuard peers properties"));
+
+    d->ui.peersView->setModel(&d->model);
+    d->ui.peersView->horizontalHeader()->setSectionResizeMode(WireGuardPeerModel::PublicKeyColumn, QHeaderView::Stretch);
+    d->ui.peersView->horizontalHeader()->setSectionResizeMode(WireGuardPeerModel::EndpointColumn, QHeaderView::Stretch);
+    d->ui.peersView->horizontalHeader()->setSectionResizeMode(WireGuardPeerModel::AllowedIpsColumn, QHeaderView::ResizeToContents);
+    d->ui.peersView->horizontalHeader()->setSectionResizeMode(WireGuardPeerModel::KeepaliveColumn, QHeaderView::ResizeToContents);
+
+    connect(d->ui.peersView->selectionModel(), &QItemSelectionModel::currentRowChanged, this, &WireGuardTabWidget::slotCurrentRowChanged);
     connect(d->ui.btnAdd, &QPushButton::clicked, this, &WireGuardTabWidget::slotAddPeer);
     connect(d->ui.btnRemove, &QPushButton::clicked, this, &WireGuardTabWidget::slotRemovePeer);
+    connect(d->ui.btnImport, &QPushButton::clicked, this, &WireGuardTabWidget::slotImportPeers);
     connect(d->ui.buttonBox, &QDialogButtonBox::accepted, this, &WireGuardTabWidget::accept);
     connect(d->ui.buttonBox, &QDialogButtonBox::rejected, this, &WireGuardTabWidget::reject);
 
@@ -104,73 +130,117 @@ WireGuardTabWidget::~WireGuardTabWidget()
 
 void WireGuardTabWidget::loadConfig(const NMVariantMapList &peerData)
 {
-    d->peers = peerData;
-    int numIncomingPeers = d->peers.size();
-
-    // If there weren't any peers in the incoming setting, create
-    // the required first element
-    if (d->peers.isEmpty())
-        d->peers.append(*(new QVariantMap()));
-
-    for (int i = 0; i < numIncomingPeers; i++) {
-        slotAddPeerWithData(peerData[i]);
-    }
-    d->ui.tabWidget->setCurrentIndex(0);
+    d->model.setPeers(peerData);
+    if (!peerData.isEmpty())
+        selectPeer(0);
 }
 
 NMVariantMapList WireGuardTabWidget::setting() const
 {
-    d->peers.clear();
-    for (int i = 0; i < d->ui.tabWidget->count(); i++)
-        d->peers.append(static_cast<WireGuardPeerWidget*>(d->ui.tabWidget->widget(i))->setting());
-    return d->peers;
+    d->commitEditor();
+    return d->model.peers();
 }
 
 void WireGuardTabWidget::slotAddPeer()
 {
-    QVariantMap *newItem = new QVariantMap; 
-    int numPeers = d->ui.tabWidget->count() + 1;
-    WireGuardPeerWidget *newTab = new WireGuardPeerWidget(*newItem);
-    connect(newTab, &WireGuardPeerWidget::notifyValid, this, &WireGuardTabWidget::slotWidgetChanged);
-    d->ui.tabWidget->addTab(newTab, QString("Peer %1").arg(QString::number(numPeers)));
-    d->peers.append(*newItem);
-    d->ui.tabWidget->setCurrentIndex(numPeers - 1);
-    slotWidgetChanged();
+    // An empty peer lacks the public key and allowed IPs
+    d->model.addPeers({QVariantMap()}, false);
+    selectPeer(d->model.peerCount() - 1);
 }
 
 void WireGuardTabWidget::slotAddPeerWithData(const QVariantMap &peerData)
 {
-    int numPeers = d->ui.tabWidget->count() + 1;
-    WireGuardPeerWidget *newTab = new WireGuardPeerWidget(peerData);
-    d->ui.tabWidget->addTab(newTab, QString("Peer %1").arg(QString::number(numPeers)));
-    connect(newTab, &WireGuardPeerWidget::notifyValid, this, &WireGuardTabWidget::slotWidgetChanged);
-    d->peers.append(peerData);
-    d->ui.tabWidget->setCurrentIndex(numPeers - 1);
-    slotWidgetChanged();
+    d->model.addPeers({peerData});
+    selectPeer(d->model.peerCount() - 1);
 }
 
 void WireGuardTabWidget::slotRemovePeer()
 {
-    int numPeers = d->ui.tabWidget->count() - 1;
-    d->ui.tabWidget->removeTab(d->ui.tabWidget->currentIndex());
-    if (numPeers == 0) {
+    const QModelIndexList selected = d->ui.peersView->selectionModel()->selectedRows();
+    if (selected.isEmpty())
+        return;
+
+    QVector<int> rows;
+    rows.reserve(selected.size());
+    for (const QModelIndex &index : selected)
+        rows.append(index.row());
+    const int current = *std::min_element(rows.constBegin(), rows.constEnd());
+
+    // The editor belongs to one of the rows going away
+    setEditor(-1);
+    d->model.removePeers(rows);
+
+    if (d->model.peerCount() == 0)
         slotAddPeer();
-        numPeers = 1;
+    else
+        selectPeer(qMin(current, d->model.peerCount() - 1));
+}
+
+void WireGuardTabWidget::slotImportPeers()
+{
+    const QString filename = QFileDialog::getOpenFileName(this, i18n("Import Peers"), QStandardPaths::writableLocation(QStandardPaths::HomeLocation),
+                                                          i18n("WireGuard configuration (%1)", WireGuardInterfaceWidget::supportedFileExtensions()));
+    if (filename.isEmpty())
+        return;
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        KMessageBox::error(this, i18n("Failed to open %1: %2", filename, file.errorString()), i18n("Import Peers"));
+        return;
+    }
+
+    d->commitEditor();
+    const int first = d->model.peerCount();
+
+    QTextStream stream(&file);
+    QString error;
+    const int imported = d->model.importPeers(stream, &error);
+    if (!error.isEmpty()) {
+        KMessageBox::error(this, i18np("Imported %1 peer before an error occurred: %2",
+                                       "Imported %1 peers before an error occurred: %2", imported, error),
+                           i18n("Import Peers"));
     }
 
-    // Retitle the tabs to reflect the current numbers
-    for (int i = 0; i < numPeers; i++)
-        d->ui.tabWidget->setTabText(i, QString("Peer %1").arg(QString::number(i + 1)));
+    if (imported)
+        selectPeer(first);
+    slotWidgetChanged();
 }
 
-void WireGuardTabWidget::slotWidgetChanged()
+void WireGuardTabWidget::slotCurrentRowChanged(const QModelIndex &current)
+{
+    setEditor(current.isValid() ? current.row() : -1);
+}
+
+void WireGuardTabWidget::selectPeer(int row)
 {
-    bool valid = true;
-    for (int i = 0; i < d->ui.tabWidget->count(); i++) {
-        if (!static_cast<WireGuardPeerWidget*>(d->ui.tabWidget->widget(i))->isValid()) {
-            valid = false;
-            break;
-        }
+    d->model.fetchRow(row);
+    const QModelIndex index = d->model.index(row, WireGuardPeerModel::PublicKeyColumn);
+    d->ui.peersView->selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+    d->ui.peersView->scrollTo(index);
+    // The current index may not have changed when rows before it were removed
+    setEditor(row);
+}
+
+void WireGuardTabWidget::setEditor(int row)
+{
+    if (row == d->editorRow)
+        return;
+
+    d->commitEditor();
+    delete d->editor;
+    d->editor = nullptr;
+    d->editorRow = row;
+
+    if (row >= 0) {
+        d->editor = new WireGuardPeerWidget(d->model.peer(row), d->ui.editorWidget, Qt::Widget);
+        connect(d->editor, &WireGuardPeerWidget::notifyValid, this, &WireGuardTabWidget::slotWidgetChanged);
+        d->ui.editorLayout->addWidget(d->editor);
     }
-    d->ui.buttonBox->button(QDialogButtonBox::Ok)->setEnabled(valid);
+    slotWidgetChanged();
+}
+
+void WireGuardTabWidget::slotWidgetChanged()
+{
+    d->commitEditor();
+    d->ui.buttonBox->button(QDialogButtonBox::Ok)->setEnabled(d->model.isValid());
 }
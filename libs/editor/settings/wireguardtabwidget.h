@@ -26,6 +26,8 @@
 #include "settingwidget.h"
 #include <NetworkManagerQt/WireguardSetting>
 
+class QModelIndex;
+
 class Q_DECL_EXPORT WireGuardTabWidget : public QDialog
 {
 Q_OBJECT
@@ -43,9 +45,13 @@ public:
     void slotAddPeer();
     void slotAddPeerWithData(const QVariantMap &peerData);
     void slotRemovePeer();
+    void slotImportPeers();
 
 private:
+    void slotCurrentRowChanged(const QModelIndex &current);
     void slotWidgetChanged();
+    void selectPeer(int row);
+    void setEditor(int row);
 
     class Private;
     Private *d;
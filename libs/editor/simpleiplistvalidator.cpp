@@ -20,9 +20,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "simpleiplistvalidator.h"
 
-#include <QStringList>
-#include <QVector>
-
 SimpleIpListValidator::SimpleIpListValidator(AddressStyle style, AddressType type, QObject *parent)
     : QValidator(parent)
     , m_ipv6Validator(nullptr)
@@ -58,49 +55,65 @@ QValidator::State SimpleIpListValidator::validate(QString &address, int &pos) co
 {
     Q_UNUSED(pos)
 
-    // Split the incoming address on commas possibly with spaces on either side
-    QStringList addressList = address.split(",");
+    // Split the incoming address on commas, the addresses outside of the
+    // edited part keep their state from the last time
+    m_cache.update(address);
 
-    // Use a local variable for position in the validators so it doesn't screw
-    // up the position of the cursor when we return
-    int localPos = 0;
     QValidator::State result = QValidator::Acceptable;
 
-    for (QString &rawAddr : addressList) {
-        QValidator::State ipv4Result = QValidator::Acceptable;
-        QValidator::State ipv6Result = QValidator::Acceptable;
-
-        QString addr = rawAddr.trimmed();
-
+    for (ListSegmentCache::Segment &segment : m_cache.segments()) {
         // If we are starting a new address and all the previous addresses
         // are not Acceptable then the previous addresses need to be completed
         // before a new one is started
         if (result != QValidator::Acceptable)
             return QValidator::Invalid;
 
-        // See if it is an IPv4 address. If we are not testing for IPv4
-        // then by definition IPv4 is Invalid
-        if (m_ipv4Validator != nullptr)
-            ipv4Result = m_ipv4Validator->validate(addr, localPos);
-        else
-            ipv4Result = QValidator::Invalid;
-
-        // See if it is an IPv6 address. If we are not testing for IPv6
-        // then by definition IPv6 is Invalid
-        if (m_ipv6Validator != nullptr)
-            ipv6Result = m_ipv6Validator->validate(addr, localPos);
-        else
-            ipv6Result = QValidator::Invalid;
+        if (!segment.validated) {
+            // Possibly with spaces on either side
+            QString addr = address.midRef(segment.start, segment.end - segment.start).trimmed().toString();
+            segment.state = validateAddress(addr);
+            segment.validated = true;
+        }
 
         // If this address is not at least an Intermediate then get out because the list is Invalid
-        if (ipv6Result == QValidator::Invalid && ipv4Result == QValidator::Invalid)
+        if (segment.state == QValidator::Invalid)
             return QValidator::Invalid;
 
-        // If either validator judged this address to be Intermediate then that's the best the
-        // final result can be for the whole list. No need to test for Acceptable because
-        // that's the default set on entry and we only downgrade it from there.
-        if (ipv4Result == QValidator::Intermediate || ipv6Result == QValidator::Intermediate)
+        if (segment.state == QValidator::Intermediate)
             result = QValidator::Intermediate;
     }
     return result;
 }
+
+QValidator::State SimpleIpListValidator::validateAddress(QString &addr) const
+{
+    // Use a local variable for position in the validators so it doesn't screw
+    // up the position of the cursor when we return
+    int localPos = 0;
+    QValidator::State ipv4Result = QValidator::Acceptable;
+    QValidator::State ipv6Result = QValidator::Acceptable;
+
+    // See if it is an IPv4 address. If we are not testing for IPv4
+    // then by definition IPv4 is Invalid
+    if (m_ipv4Validator != nullptr)
+        ipv4Result = m_ipv4Validator->validate(addr, localPos);
+    else
+        ipv4Result = QValidator::Invalid;
+
+    // See if it is an IPv6 address. If we are not testing for IPv6
+    // then by definition IPv6 is Invalid
+    if (m_ipv6Validator != nullptr)
+        ipv6Result = m_ipv6Validator->validate(addr, localPos);
+    else
+        ipv6Result = QValidator::Invalid;
+
+    if (ipv6Result == QValidator::Invalid && ipv4Result == QValidator::Invalid)
+        return QValidator::Invalid;
+
+    // If either validator judged this address to be Intermediate then that's the best the
+    // final result can be for the whole list
+    if (ipv4Result == QValidator::Intermediate || ipv6Result == QValidator::Intermediate)
+        return QValidator::Intermediate;
+
+    return QValidator::Acceptable;
+}
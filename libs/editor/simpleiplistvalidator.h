@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define SIMPLEIPLISTVALIDATOR_H
 
 #include <QValidator>
+#include "listsegmentcache.h"
 #include "simpleipv4addressvalidator.h"
 #include "simpleipv6addressvalidator.h"
 
@@ -35,9 +36,15 @@ public:
                                    AddressType allow = AddressType::Both, QObject *parent = nullptr);
     ~SimpleIpListValidator() override;
 
+    /** Only the addresses touched by the edit since the last call are
+     *  validated again, the state of the others is cached.
+     */
     State validate(QString &, int &) const override;
 
 private:
+    State validateAddress(QString &address) const;
+
+    mutable ListSegmentCache m_cache;
     SimpleIpV6AddressValidator *m_ipv6Validator;
     SimpleIpV4AddressValidator *m_ipv4Validator;
 };
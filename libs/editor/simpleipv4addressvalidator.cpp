@@ -20,24 +20,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "simpleipv4addressvalidator.h"
 
-#include <QStringList>
-#include <QVector>
-
 SimpleIpV4AddressValidator::SimpleIpV4AddressValidator(AddressStyle style, QObject *parent)
     : QValidator(parent)
     , m_addressStyle(style)
 {
-    switch (style) {
-        case Base:
-            m_validator.setRegularExpression(QRegularExpression(QLatin1String("[0-9, ]{1,3}\\.[0-9, ]{1,3}\\.[0-9, ]{1,3}\\.[0-9, ]{1,3}")));
-            break;
-        case WithCidr:
-            m_validator.setRegularExpression(QRegularExpression(QLatin1String("([0-9]{1,3}\\.){3,3}[0-9]{1,3}/[0-9]{1,2}")));
-            break;
-        case WithPort:
-            m_validator.setRegularExpression(QRegularExpression(QLatin1String("([0-9]{1,3}\\.){3,3}[0-9]{1,3}:[0-9]{1,5}")));
-            break;
-    }
 }
 
 SimpleIpV4AddressValidator::~SimpleIpV4AddressValidator()
@@ -46,124 +32,138 @@ SimpleIpV4AddressValidator::~SimpleIpV4AddressValidator()
 
 QValidator::State SimpleIpV4AddressValidator::validate(QString &address, int &pos) const
 {
-    QValidator::State maskResult = checkWithInputMask(address, pos);
-    if (QValidator::Invalid == maskResult) {
-        return QValidator::Invalid;
-    }
-
-    // this list will be filled with tetrad values. It can be used to make
-    // some additional correctness checks on the last validation step.
-    QList<int> tetrads;
-
-    QValidator::State tetradResult = checkTetradsRanges(address, tetrads);
-    if (QValidator::Invalid == tetradResult)
-        return QValidator::Invalid;
-    else if (QValidator::Intermediate == tetradResult || QValidator::Intermediate == maskResult)
-        return QValidator::Intermediate;
-    else
-        return QValidator::Acceptable;
-}
-
-QValidator::State SimpleIpV4AddressValidator::checkWithInputMask(QString &value, int &pos) const
-{
-    return m_validator.validate(value, pos);
-}
-
-QValidator::State SimpleIpV4AddressValidator::checkTetradsRanges(QString &value, QList<int> &tetrads) const
-{
-    QStringList temp;
-    QVector<QStringRef> addrParts;
-    QStringList cidrParts;
-    QStringList portParts;
-
-    switch (m_addressStyle) {
-    case Base:
-        addrParts = value.splitRef(QLatin1Char('.'));
-        break;
-
-    case WithCidr:
-        cidrParts = value.split(QLatin1Char('/'));
-        addrParts = cidrParts[0].splitRef(QLatin1Char('.'));
-        break;
-
-    case WithPort:
-        portParts = value.split(QLatin1Char(':'));
-        addrParts = portParts[0].splitRef(QLatin1Char('.'));
-        break;
-    }
+    Q_UNUSED(pos)
+
+    // The accepted input is
+    //   Base:     [0-9, ]{1,3}\.[0-9, ]{1,3}\.[0-9, ]{1,3}\.[0-9, ]{1,3}
+    //   WithCidr: ([0-9]{1,3}\.){3}[0-9]{1,3}/[0-9]{1,2}
+    //   WithPort: ([0-9]{1,3}\.){3}[0-9]{1,3}:[0-9]{1,5}
+    // and anything which is a prefix of it is Intermediate. Tetrads take the value
+    // QString::toInt() gives them, which is 0 for anything else than digits
+    // surrounded by spaces.
+    const bool hasSuffix = m_addressStyle != Base;
+    const QChar suffixSeparator = m_addressStyle == WithCidr ? QLatin1Char('/') : QLatin1Char(':');
+    const int suffixMaxLength = m_addressStyle == WithCidr ? 2 : 5;
+    const int suffixMaxValue = m_addressStyle == WithCidr ? 32 : 65535;
+
+    int tetrads[4] = {0, 0, 0, 0};
+    int tetrad = 0;
+    bool canonical = true;
+
+    // State of the current tetrad
+    int length = 0;
+    int digits = 0;
+    int value = 0;
+    bool leadingZero = false;
+    bool trailingSpace = false;
+    bool garbage = false;
+
+    // State of the CIDR or port suffix
+    int suffixStart = -1;
+    int suffixLength = 0;
+    int suffixValue = 0;
+
+    auto finishTetrad = [&] () {
+        const int tetradValue = (garbage || !digits) ? 0 : value;
+        if (digits != length || garbage || (digits > 1 && leadingZero)) {
+            canonical = false;
+        }
+        tetrads[tetrad] = tetradValue;
+        return tetradValue <= 255;
+    };
 
-    int i = 0;
-    // fill in the list with invalid values
-    tetrads << -1 << -1 << -1 << -1;
+    const int size = address.size();
+    const QChar *data = address.constData();
+    for (int i = 0; i < size; ++i) {
+        const ushort c = data[i].unicode();
 
-    // lets check address parts
-    for (const QStringRef &part : addrParts) {
-        if (part.isEmpty()) {
-            if (i != (addrParts.size() - 1)) {
-                // qCDebug(PLASMA_NM) << "part.isEmpty()";
+        if (suffixStart != -1) {
+            if (c < '0' || c > '9' || suffixLength == suffixMaxLength) {
                 return QValidator::Invalid;
             }
-            // the last tetrad can be empty, continue...
-            return QValidator::Intermediate;
+            suffixValue = suffixValue * 10 + (c - '0');
+            ++suffixLength;
+        } else if (c == '.') {
+            if (!length || tetrad == 3) {
+                return QValidator::Invalid;
+            }
+            if (!finishTetrad()) {
+                return QValidator::Invalid;
+            }
+            ++tetrad;
+            length = digits = value = 0;
+            leadingZero = trailingSpace = garbage = false;
+        } else if (hasSuffix && c == suffixSeparator.unicode()) {
+            if (!length || tetrad != 3) {
+                return QValidator::Invalid;
+            }
+            if (!finishTetrad()) {
+                return QValidator::Invalid;
+            }
+            suffixStart = i + 1;
+        } else {
+            if (length == 3) {
+                return QValidator::Invalid;
+            }
+            if (c >= '0' && c <= '9') {
+                if (trailingSpace) {
+                    garbage = true;
+                }
+                if (!digits && c == '0') {
+                    leadingZero = true;
+                }
+                value = value * 10 + (c - '0');
+                ++digits;
+            } else if (!hasSuffix && c == ' ') {
+                if (digits) {
+                    trailingSpace = true;
+                }
+            } else if (!hasSuffix && c == ',') {
+                garbage = true;
+            } else {
+                return QValidator::Invalid;
+            }
+            ++length;
         }
+    }
 
-        tetrads[i] = part.toInt();
-
-        if (tetrads[i] > 255) {
-            // qCDebug(PLASMA_NM) << "tetrads[i] > 255";
+    if (suffixStart == -1) {
+        // The last tetrad can be empty, continue...
+        if (!length) {
+            return QValidator::Intermediate;
+        }
+        if (!finishTetrad()) {
             return QValidator::Invalid;
         }
+    }
 
-        // correct tetrad value: for example, 001 -> 1
-        temp.append(QString::number(tetrads[i]));
-
-        i++;
+    if (suffixLength && suffixValue > suffixMaxValue) {
+        return QValidator::Invalid;
     }
 
-    // replace input string with the corrected version
-    value = temp.join(QLatin1String("."));
+    // Correct the tetrad values, for example 001 -> 1
+    if (!canonical) {
+        QString corrected;
+        for (int i = 0; i <= tetrad; ++i) {
+            if (i) {
+                corrected += QLatin1Char('.');
+            }
+            corrected += QString::number(tetrads[i]);
+        }
+        if (suffixStart != -1) {
+            corrected += address.midRef(suffixStart - 1);
+        }
+        address = corrected;
+    }
 
-    if (i < 4) {
+    if (tetrad < 3) {
         // not all tetrads are filled... continue
-        // qCDebug(PLASMA_NM) << "QValidator::Intermediate";
         return QValidator::Intermediate;
     }
-    else {
-        if (m_addressStyle == WithCidr) {
-            if (cidrParts.size() > 1) {
-                value += QLatin1String("/");
-                if (!cidrParts[1].isEmpty()) {
-                    int cidrValue = cidrParts[1].toInt();
-                    if (cidrValue > 32) {
-                        return QValidator::Invalid;
-                    } else {
-                        value += cidrParts[1];
-                        return QValidator::Acceptable;
-                    }
-                }
-                else {
-                    return QValidator::Intermediate;
-                }
-            }
-        } else if (m_addressStyle == WithPort) {
-            if (portParts.size() > 1) {
-                value += QLatin1String(":");
-                if (!portParts[1].isEmpty()) {
-                    int portValue = portParts[1].toInt();
-                    if (portValue > 65535) {
-                        return QValidator::Invalid;
-                    } else {
-                        value += portParts[1];
-                        return QValidator::Acceptable;
-                    }
-                }
-                else {
-                    return QValidator::Intermediate;
-                }
-            }
-        }
 
-        // qCDebug(PLASMA_NM) << "QValidator::Acceptable";
-        return QValidator::Acceptable;
+    if (hasSuffix && !suffixLength) {
+        return QValidator::Intermediate;
     }
+
+    return QValidator::Acceptable;
 }
@@ -20,168 +20,216 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "simpleipv6addressvalidator.h"
 
-#include <QStringList>
-#include <QVector>
-
-SimpleIpV6AddressValidator::SimpleIpV6AddressValidator(AddressStyle style, QObject *parent)
-    : QValidator(parent)
-    , m_addressStyle(style)
+static inline int hexValue(ushort c)
 {
-    switch (style) {
-        case Base:
-            m_validator.setRegularExpression(QRegularExpression(QLatin1String("([0-9a-fA-F]{1,4}|:)+")));
-            break;
-        case WithCidr:
-            m_validator.setRegularExpression(QRegularExpression(QLatin1String("([0-9a-fA-F]{1,4}|:){2,15}/[0-9]{1,3}")));
-            break;
-        case WithPort:
-            m_validator.setRegularExpression(QRegularExpression(QLatin1String("\\[([0-9a-fA-F]{1,4}|:)+\\]:[0-9]{1,5}")));
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
     }
+    return -1;
 }
 
-SimpleIpV6AddressValidator::~SimpleIpV6AddressValidator()
+// Validates the address starting at @p it. Stops at the first character which
+// cannot be part of an address and leaves @p it pointing there.
+static QValidator::State validateAddress(const QChar *&it, const QChar *end)
 {
-}
+    const QChar *begin = it;
 
-QValidator::State SimpleIpV6AddressValidator::validate(QString &address, int &pos) const
-{
-    if (QValidator::Invalid == checkWithInputMask(address, pos)) {
-        return QValidator::Invalid;
-    }
+    int groups = 0;             // finished 16 bit groups, a dotted quad counts as two
+    int colons = 0;             // colons right before the current position
+    bool compressed = false;    // "::" was seen
 
-    return checkTetradsRanges(address);
-}
+    // The current hex group, or octet once in the dotted quad
+    int digits = 0;
+    int decimalValue = 0;
+    bool decimal = true;
+    int octets = 0;             // finished octets of the dotted quad
 
-QValidator::State SimpleIpV6AddressValidator::checkWithInputMask(QString &value, int &pos) const
-{
-    return  m_validator.validate(value, pos);
-}
+    for (; it != end; ++it) {
+        const ushort c = it->unicode();
 
-QValidator::State SimpleIpV6AddressValidator::checkTetradsRanges(QString &value) const
-{
-    QStringList addrParts;
-    QStringList cidrParts;
-    QStringList portParts;
-    bool foundBracket = false;
-    QValidator::State result = QValidator::Acceptable;
+        if (c == ':') {
+            if (octets) {
+                return QValidator::Invalid;
+            }
 
-    switch (m_addressStyle) {
-    case Base:
-        addrParts = value.split(QLatin1Char(':'));
-        break;
-
-    case WithCidr:
-        cidrParts = value.split(QLatin1Char('/'));
-        addrParts = cidrParts[0].split(QLatin1Char(':'));
-        break;
-
-    case WithPort:
-      if (value.isEmpty())
-          return QValidator::Intermediate;
-      if (value[0] != '[') {
-          return QValidator::Invalid;
-      } else {
-          // Input: "[1:2:3:4:5:6:7:8]:123"
-          // bracketParts: "[1:2:3:4:5:6:7:8" , ":123"
-          // addrParts: "" , "1:2:3:4:5:6:7:8"
-          // portParts: "", "123"
-          QStringList bracketParts = value.split(QLatin1Char(']'));
-          if (bracketParts.size() < 2)
-              portParts = QStringList();
-          else {
-              foundBracket = true;
-              if (!bracketParts[1].isEmpty() && bracketParts[1][0] != ':')
-                  return QValidator::Invalid;
-              else
-                  portParts = bracketParts[1].split(QLatin1Char(':'));
-          }
-          addrParts = bracketParts[0].split(QLatin1Char('['))[1].split(QLatin1Char(':'));
-      }
-    }
+            if (digits) {
+                ++groups;
+                digits = 0;
+                decimalValue = 0;
+                decimal = true;
+                colons = 1;
+                // Another group has to follow, "::" stands for at least one
+                if (groups >= (compressed ? 7 : 8)) {
+                    return QValidator::Invalid;
+                }
+            } else if (colons == 1) {
+                if (compressed) {
+                    return QValidator::Invalid;
+                }
+                compressed = true;
+                colons = 2;
+            } else if (colons == 2) {
+                return QValidator::Invalid;
+            } else {
+                // Leading colon, has to be followed by another one
+                colons = 1;
+            }
+        } else if (c == '.') {
+            if (!digits || digits > 3 || !decimal || decimalValue > 255) {
+                return QValidator::Invalid;
+            }
 
-    int number = addrParts.size();
-    // There is no case where can be more than 8 colons (9 parts)
-    // and only one unusual case where there are 8 colons (1:2:3:4:5:6:7::)
-    if (number > 9)
-        return QValidator::Invalid;
-    else if (number == 9 && (!addrParts[7].isEmpty() || !addrParts[8].isEmpty()))
-        return QValidator::Invalid;
+            if (octets) {
+                if (++octets > 3) {
+                    return QValidator::Invalid;
+                }
+            } else {
+                // The dotted quad takes the place of the last two groups
+                if (groups + 2 > (compressed ? 7 : 8)) {
+                    return QValidator::Invalid;
+                }
+                octets = 1;
+            }
+            digits = 0;
+            decimalValue = 0;
+        } else {
+            const int value = hexValue(c);
+            if (value < 0) {
+                break;
+            }
 
-    // lets check address parts
-    bool emptypresent = false;
-    int i = 1;
-    for (QString part : addrParts) {
-        if (part.isEmpty() && i < number) {
-            // There is only one case where you can have 3 empty parts
-            // and that is when you have the string: "::" which is valid
-            // and useful and of course it can also be extended to ::123 for
-            // instance. Anywhere other than the beginning though, having 3 empty
-            // parts indicates either a run of 3 colons ("1:::6")" or two sets of
-            // 2 colons ("1:2::3:4::") which are always invalid
-            if (emptypresent && i != 2) {
-                // qCDebug(PLASMA_NM) << "part.isEmpty()";
-                return QValidator::Invalid;
+            if (octets) {
+                if (value > 9 || ++digits > 3) {
+                    return QValidator::Invalid;
+                }
+                decimalValue = decimalValue * 10 + value;
+                if (decimalValue > 255) {
+                    return QValidator::Invalid;
+                }
             } else {
-                // If this is an empty part then set it to zero to not fail
-                // the next test
-                part.setNum(0,16);
-                emptypresent = true;
+                if (!digits) {
+                    // ":1" or a group more than there is room for
+                    if ((colons == 1 && !groups) || groups >= (compressed ? 7 : 8)) {
+                        return QValidator::Invalid;
+                    }
+                }
+                if (++digits > 4) {
+                    return QValidator::Invalid;
+                }
+                if (value > 9) {
+                    decimal = false;
+                } else if (decimal) {
+                    decimalValue = decimalValue * 10 + value;
+                }
             }
+            colons = 0;
         }
-        i++;
+    }
+
+    if (it == begin || colons == 1) {
+        return QValidator::Intermediate;
+    }
+
+    if (octets) {
+        if (octets < 3 || !digits) {
+            return QValidator::Intermediate;
+        }
+        groups += 2;
+    } else if (digits) {
+        ++groups;
+    }
 
-        bool ok;
-        if (part.toInt(&ok, 16) > 65535) {
+    return (compressed || groups == 8) ? QValidator::Acceptable : QValidator::Intermediate;
+}
+
+// Validates a decimal CIDR prefix or port number filling the range [it, end)
+static QValidator::State validateNumber(const QChar *it, const QChar *end, int maxDigits, int maxValue)
+{
+    if (it == end) {
+        return QValidator::Intermediate;
+    }
+
+    if (end - it > maxDigits) {
+        return QValidator::Invalid;
+    }
+
+    int value = 0;
+    for (; it != end; ++it) {
+        const ushort c = it->unicode();
+        if (c < '0' || c > '9') {
             return QValidator::Invalid;
         }
+        value = value * 10 + (c - '0');
     }
 
-    // A special case: a single colon needs to be  Intermediate not Acceptable
-    if (number == 2 && addrParts[0].isEmpty() && addrParts[1].isEmpty())
-        result = QValidator::Intermediate;
+    return value > maxValue ? QValidator::Invalid : QValidator::Acceptable;
+}
 
-    // Another special case: a single colon followed by something (i.e. ":123"
-    // is invalid
-    else if (number > 1 && addrParts[0].isEmpty() && !addrParts[1].isEmpty())
-        result =  QValidator::Invalid;
+SimpleIpV6AddressValidator::SimpleIpV6AddressValidator(AddressStyle style, QObject *parent)
+    : QValidator(parent)
+    , m_addressStyle(style)
+{
+}
 
-    // If we don't have 8 parts yet and none of them are empty we aren't done yet
-    else if (number < 8 && !emptypresent)
-        result = QValidator::Intermediate;
+SimpleIpV6AddressValidator::~SimpleIpV6AddressValidator()
+{
+}
 
-    // If we have 8 parts but the last one is empty we aren't done yet
-    else if (number == 8 && addrParts[7].isEmpty())
-        result =  QValidator::Intermediate;
+QValidator::State SimpleIpV6AddressValidator::validate(QString &address, int &pos) const
+{
+    Q_UNUSED(pos)
 
-    if (m_addressStyle == WithCidr) {
-        int cidrSize = cidrParts.size();
+    const QChar *it = address.constData();
+    const QChar *end = it + address.size();
 
-        // If we have a '/' and the basic address portion is not
-        // yet complete (i.e. Intermediate) then the whole thing  is Invalid
-        if (cidrSize == 2 && result == QValidator::Intermediate)
+    switch (m_addressStyle) {
+    case Base: {
+        const QValidator::State result = validateAddress(it, end);
+        return it == end ? result : QValidator::Invalid;
+    }
+
+    case WithCidr: {
+        // The address has to be complete before the '/'
+        const QValidator::State result = validateAddress(it, end);
+        if (it == end) {
+            return result == QValidator::Invalid ? QValidator::Invalid : QValidator::Intermediate;
+        }
+        if (result != QValidator::Acceptable || *it != QLatin1Char('/')) {
             return QValidator::Invalid;
+        }
+        return validateNumber(it + 1, end, 3, 128);
+    }
 
-        if (cidrSize == 1 || (cidrSize == 2 && cidrParts[1].isEmpty()))
+    case WithPort: {
+        // "[address]:port", the address has to be complete before the ']'
+        if (it == end) {
             return QValidator::Intermediate;
-
-        int cidrValue = cidrParts[1].toInt();
-        if (cidrValue > 128)
+        }
+        if (*it != QLatin1Char('[')) {
             return QValidator::Invalid;
-    } else if (m_addressStyle == WithPort) {
-        int portSize = portParts.size();
+        }
 
-        // If we have a ']' and the basic address portion is not
-        // yet complete (i.e. Intermediate) then the whole thing  is Invalid
-        if (foundBracket && result == QValidator::Intermediate)
+        ++it;
+        const QValidator::State result = validateAddress(it, end);
+        if (it == end) {
+            return result == QValidator::Invalid ? QValidator::Invalid : QValidator::Intermediate;
+        }
+        if (result != QValidator::Acceptable || *it != QLatin1Char(']')) {
             return QValidator::Invalid;
-
-        if (portSize < 2 || (portSize == 2 && portParts[1].isEmpty())) {
+        }
+        if (++it == end) {
             return QValidator::Intermediate;
-        } else {
-            int portValue = portParts[1].toInt();
-            if (portValue > 65535)
-                return QValidator::Invalid;
         }
+        if (*it != QLatin1Char(':')) {
+            return QValidator::Invalid;
+        }
+        return validateNumber(it + 1, end, 5, 65535);
     }
-    return result;
+    }
+
+    return QValidator::Invalid;
 }
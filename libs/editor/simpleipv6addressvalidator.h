@@ -31,18 +31,14 @@ public:
     explicit SimpleIpV6AddressValidator(AddressStyle style = AddressStyle::Base, QObject *parent = nullptr);
     ~SimpleIpV6AddressValidator() override;
 
+    /** Validates the input in a single pass over its characters, without
+     *  allocating. Supports "::" compression and a trailing dotted quad
+     *  ("::ffff:192.168.1.1"). The input string is never changed.
+     */
     State validate(QString &, int &) const override;
 
-    /** Check input value with a regular expression describing simple input mask.
-     */
-    QValidator::State checkWithInputMask(QString &, int &) const;
-    /** Function split input string into tetrads and check them for valid values.
-     *  In the tetrads are placed into QList. Input string may be changed.
-     */
-    QValidator::State checkTetradsRanges(QString &) const;
 private:
     AddressStyle m_addressStyle;
-    QRegularExpressionValidator m_validator;
 };
 
 #endif // SIMPLEIPV6ADDRESSVALIDATOR_H
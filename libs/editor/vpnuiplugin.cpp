@@ -23,6 +23,8 @@
 
 #include <KLocalizedString>
 
+#include <QFileInfo>
+
 VpnUiPlugin::VpnUiPlugin(QObject * parent, const QVariantList & /*args*/):
     QObject(parent)
 {
@@ -33,6 +35,30 @@ VpnUiPlugin::~VpnUiPlugin()
 {
 }
 
+QList<NMVariantMapMap> VpnUiPlugin::importConnections(const QStringList &fileNames, QStringList *messages)
+{
+    QList<NMVariantMapMap> result;
+    for (const QString &fileName : fileNames) {
+        mError = NoError;
+        const NMVariantMapMap connection = importConnectionSettings(fileName);
+        if (!connection.isEmpty()) {
+            result << connection;
+        } else if (messages) {
+            const QString error = mError == NoError ? i18n("Could not import file") : lastErrorMessage();
+            *messages << i18nc("@item file name and problem", "%1: %2", QFileInfo(fileName).fileName(), error);
+        }
+    }
+
+    const int failed = fileNames.size() - result.size();
+    if (failed) {
+        mError = Error;
+        mErrorMessage = i18np("%1 file could not be imported.", "%1 files could not be imported.", failed);
+    } else {
+        mError = NoError;
+    }
+    return result;
+}
+
 QMessageBox::StandardButtons VpnUiPlugin::suggestedAuthDialogButtons() const
 {
     return QMessageBox::Ok | QMessageBox::Cancel;
@@ -52,11 +52,8 @@ public:
      * Try not to use space, parenthesis, or any other Unix unfriendly file name character.
      */
     virtual QString suggestedFileName(const NetworkManager::ConnectionSettings::Ptr &connection) const = 0;
-    /**
-     * File extension to be used in QFileDialog when selecting the file to import.
-     * The format is: *.<extension> [*.<extension> ...]. For instance: '*.pcf'
-     */
-    virtual QString supportedFileExtensions() const = 0;
+    // The importable file extensions are declared by X-NetworkManager-FileExtensions in the plugin's
+    // desktop file, see VpnUiPluginRegistry::supportedFileExtensions()
 
     /**
      * If the plugin does not support fileName's extension it must just return an empty QVariantList.
@@ -64,6 +61,13 @@ public:
      * and mErrorMessage with a custom error message before returning an empty QVariantList.
      */
     virtual NMVariantMapMap importConnectionSettings(const QString &fileName) = 0;
+    /**
+     * Imports several files at once and returns the connections that could be imported.
+     * A failing file does not stop the import, its error message and any other problem
+     * worth reporting are appended to @p messages, so the caller can show them all together.
+     * The default implementation calls importConnectionSettings() for one file after the other.
+     */
+    virtual QList<NMVariantMapMap> importConnections(const QStringList &fileNames, QStringList *messages);
     virtual bool exportConnectionSettings(const NetworkManager::ConnectionSettings::Ptr &connection, const QString &fileName) = 0;
 
     virtual QMessageBox::StandardButtons suggestedAuthDialogButtons() const;
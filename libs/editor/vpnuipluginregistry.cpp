@@ -0,0 +1,125 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vpnuipluginregistry.h"
+#include "vpnuiplugin.h"
+#include "debug.h"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QPointer>
+
+#include <KServiceTypeTrader>
+
+VpnUiPluginRegistry *VpnUiPluginRegistry::self()
+{
+    static QPointer<VpnUiPluginRegistry> registry;
+
+    if (!registry) {
+        registry = new VpnUiPluginRegistry(QCoreApplication::instance());
+    }
+
+    return registry;
+}
+
+VpnUiPluginRegistry::VpnUiPluginRegistry(QObject *parent)
+    : QObject(parent)
+{
+    // Only reads the metadata from the sycoca database, no plugin is loaded here
+    const KService::List services = KServiceTypeTrader::self()->query(QStringLiteral("PlasmaNetworkManagement/VpnUiPlugin"));
+    for (const KService::Ptr &service : services) {
+        const QString serviceType = service->property(QStringLiteral("X-NetworkManager-Services"), QVariant::String).toString();
+        if (serviceType.isEmpty() || m_services.contains(serviceType)) {
+            continue;
+        }
+        m_services.insert(serviceType, service);
+
+        const QStringList extensions = service->property(QStringLiteral("X-NetworkManager-FileExtensions"), QVariant::StringList).toStringList();
+        for (const QString &extension : extensions) {
+            // Stored as "*.ovpn", the format of QFileDialog name filters
+            const QString suffix = extension.section(QLatin1Char('.'), -1).trimmed().toLower();
+            if (suffix.isEmpty() || m_extensions.contains(suffix)) {
+                continue;
+            }
+            m_extensions.insert(suffix, serviceType);
+            m_fileExtensions << QStringLiteral("*.") + suffix;
+            m_serviceFileExtensions[serviceType] << QStringLiteral("*.") + suffix;
+        }
+    }
+}
+
+QStringList VpnUiPluginRegistry::serviceTypes() const
+{
+    return m_services.keys();
+}
+
+bool VpnUiPluginRegistry::contains(const QString &serviceType) const
+{
+    return m_services.contains(serviceType);
+}
+
+KService::Ptr VpnUiPluginRegistry::service(const QString &serviceType) const
+{
+    return m_services.value(serviceType);
+}
+
+QString VpnUiPluginRegistry::supportedFileExtensions() const
+{
+    return m_fileExtensions.join(QLatin1Char(' '));
+}
+
+QString VpnUiPluginRegistry::supportedFileExtensions(const QString &serviceType) const
+{
+    return m_serviceFileExtensions.value(serviceType).join(QLatin1Char(' '));
+}
+
+QString VpnUiPluginRegistry::serviceTypeForFile(const QString &fileName) const
+{
+    return m_extensions.value(QFileInfo(fileName).suffix().toLower());
+}
+
+VpnUiPlugin *VpnUiPluginRegistry::plugin(const QString &serviceType, QString *error)
+{
+    VpnUiPlugin *plugin = m_plugins.value(serviceType);
+    if (plugin) {
+        return plugin;
+    }
+
+    const KService::Ptr service = m_services.value(serviceType);
+    if (!service) {
+        if (error) {
+            *error = QStringLiteral("No VPN UI plugin for %1").arg(serviceType);
+        }
+        return nullptr;
+    }
+
+    QString loadError;
+    plugin = service->createInstance<VpnUiPlugin>(this, QVariantList(), &loadError);
+    if (!plugin) {
+        qCWarning(PLASMA_NM) << "Failed to load VPN UI plugin" << service->library() << loadError;
+        if (error) {
+            *error = loadError;
+        }
+        return nullptr;
+    }
+
+    m_plugins.insert(serviceType, plugin);
+    return plugin;
+}
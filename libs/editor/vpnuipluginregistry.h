@@ -0,0 +1,82 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_VPN_UI_PLUGIN_REGISTRY_H
+#define PLASMA_NM_VPN_UI_PLUGIN_REGISTRY_H
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+#include <KService>
+
+class VpnUiPlugin;
+
+/**
+ * Process wide registry of the installed VPN UI plugins.
+ *
+ * Service types and importable file extensions are read from the plugin
+ * metadata ("X-NetworkManager-Services" and "X-NetworkManager-FileExtensions"),
+ * so no plugin library is loaded until an instance is actually requested.
+ * Loaded instances are owned by the registry and kept for the life of the process,
+ * callers must not delete them.
+ */
+class Q_DECL_EXPORT VpnUiPluginRegistry : public QObject
+{
+Q_OBJECT
+public:
+    static VpnUiPluginRegistry *self();
+
+    QStringList serviceTypes() const;
+    bool contains(const QString &serviceType) const;
+    KService::Ptr service(const QString &serviceType) const;
+
+    /**
+     * Extensions of all importable files in the QFileDialog filter format,
+     * for instance "*.ovpn *.conf *.pcf".
+     */
+    QString supportedFileExtensions() const;
+    /**
+     * Extensions of the files handled by the plugin for @p serviceType in the
+     * same format, empty if the plugin imports no files.
+     */
+    QString supportedFileExtensions(const QString &serviceType) const;
+    /**
+     * Returns the service type of the plugin importing @p fileName based on its
+     * extension, or an empty string if no plugin handles it.
+     */
+    QString serviceTypeForFile(const QString &fileName) const;
+
+    /**
+     * Returns the cached plugin instance for @p serviceType, loading it on first use.
+     */
+    VpnUiPlugin *plugin(const QString &serviceType, QString *error = nullptr);
+
+private:
+    explicit VpnUiPluginRegistry(QObject *parent = nullptr);
+
+    QHash<QString, KService::Ptr> m_services;
+    QHash<QString, QString> m_extensions;
+    QHash<QString, QStringList> m_serviceFileExtensions;
+    QStringList m_fileExtensions;
+    QHash<QString, VpnUiPlugin *> m_plugins;
+};
+
+#endif // PLASMA_NM_VPN_UI_PLUGIN_REGISTRY_H
@@ -20,32 +20,36 @@
 */
 
 #include "bssidcombobox.h"
+#include "bssidmodel.h"
 
-#include <NetworkManagerQt/Manager>
 #include <NetworkManagerQt/Utils>
-#include <NetworkManagerQt/WirelessDevice>
-
-#include <KLocalizedString>
-
-bool signalCompare(const NetworkManager::AccessPoint::Ptr & one, const NetworkManager::AccessPoint::Ptr & two) {
-    return one->signalStrength() > two->signalStrength();
-}
 
 BssidComboBox::BssidComboBox(QWidget *parent) :
-    QComboBox(parent), m_dirty(false)
+    QComboBox(parent), m_model(new BssidModel(this)), m_dirty(false)
 {
     setEditable(true);
     setInsertPolicy(QComboBox::NoInsert);
+    setModel(m_model);
 
     connect(this, &BssidComboBox::editTextChanged, this, &BssidComboBox::slotEditTextChanged);
     connect(this, QOverload<int>::of(&BssidComboBox::activated), this, &BssidComboBox::slotCurrentIndexChanged);
+
+    // Live updates must neither replace what is in the line edit nor the selected BSSID
+    connect(m_model, &BssidModel::aboutToUpdate, this, [this] () {
+        m_editText = currentText();
+        m_signalsBlocked = blockSignals(true);
+    });
+    connect(m_model, &BssidModel::updated, this, [this] () {
+        setEditText(m_editText);
+        blockSignals(m_signalsBlocked);
+    });
 }
 
 QString BssidComboBox::bssid() const
 {
     QString result;
     if (!m_dirty)
-        result = itemData(currentIndex()).toString();
+        result = m_selectedBssid;
     else
         result = currentText();
 
@@ -72,76 +76,19 @@ void BssidComboBox::slotEditTextChanged(const QString &)
 void BssidComboBox::slotCurrentIndexChanged(int)
 {
     m_dirty = false;
+    m_selectedBssid = itemData(currentIndex(), BssidModel::BssidRole).toString();
     setEditText(bssid());
     Q_EMIT bssidChanged();
 }
 
 void BssidComboBox::init(const QString & bssid, const QString &ssid)
 {
-    m_initialBssid = bssid;
-
-    // qCDebug(PLASMA_NM) << "Initial ssid:" << m_initialBssid;
-
-    QList<NetworkManager::AccessPoint::Ptr> aps;
-
-    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
-        if (device->type() == NetworkManager::Device::Wifi) {
-            NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
-            NetworkManager::WirelessNetwork::Ptr wifiNetwork = wifiDevice->findNetwork(ssid);
-
-            if (!wifiNetwork) {
-                continue;
-            }
-
-            for (const NetworkManager::AccessPoint::Ptr &newAp : wifiNetwork->accessPoints()) {
-                bool found = false;;
-                for (const NetworkManager::AccessPoint::Ptr &existingAp : aps) {
-                    if (newAp->hardwareAddress() == existingAp->hardwareAddress()) {
-                        if (newAp->signalStrength() > existingAp->signalStrength()) {
-                            aps.removeOne(existingAp);
-                            break;
-                        } else {
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (!found) {
-                    aps << newAp;
-                }
-            }
-        }
-    }
-
-    std::sort(aps.begin(), aps.end(), signalCompare);
-    addBssidsToCombo(aps);
-
-    const int index = findData(m_initialBssid);
-    if (index == -1) {
-        insertItem(0, m_initialBssid, m_initialBssid);
-        setCurrentIndex(0);
-    } else {
-        setCurrentIndex(index);
-    }
-    setEditText(m_initialBssid);
-}
-
-void BssidComboBox::addBssidsToCombo(const QList<NetworkManager::AccessPoint::Ptr> & aps)
-{
-    clear();
+    // qCDebug(PLASMA_NM) << "Initial ssid:" << bssid;
 
-    if (aps.isEmpty()) {
-        addItem(i18n("First select the SSID"));
-        return;
-    }
-
-    for (const NetworkManager::AccessPoint::Ptr &ap : aps) {
-        if (!ap) {
-            continue;
-        }
+    // The initial BSSID is always the first entry
+    m_model->setSsid(ssid, bssid);
+    m_selectedBssid = bssid;
 
-        const QString text = i18n("%1 (%2%)\nFrequency: %3 Mhz\nChannel: %4", ap->hardwareAddress(), ap->signalStrength(), ap->frequency(), QString::number(NetworkManager::findChannel(ap->frequency())));
-        addItem(text, QVariant::fromValue(ap->hardwareAddress()));
-    }
+    setCurrentIndex(0);
+    setEditText(bssid);
 }
@@ -24,8 +24,7 @@
 
 #include <QComboBox>
 
-#include <NetworkManagerQt/Device>
-#include <NetworkManagerQt/AccessPoint>
+class BssidModel;
 
 class Q_DECL_EXPORT BssidComboBox : public QComboBox
 {
@@ -47,10 +46,13 @@ private Q_SLOTS:
     void slotCurrentIndexChanged(int);
 
 private:
-    void addBssidsToCombo(const QList<NetworkManager::AccessPoint::Ptr> & aps);
-
-    QString m_initialBssid;
+    BssidModel *m_model;
+    QString m_selectedBssid;
     bool m_dirty;
+
+    // Kept while the model applies live updates
+    QString m_editText;
+    bool m_signalsBlocked = false;
 };
 
 #endif // PLASMA_NM_BSSIDCOMBOBOX_H
@@ -0,0 +1,303 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bssidmodel.h"
+
+#include <NetworkManagerQt/Manager>
+#include <NetworkManagerQt/Utils>
+#include <NetworkManagerQt/WirelessDevice>
+
+#include <KLocalizedString>
+
+// Changes are applied at most this often
+static const int updateInterval = 1000;
+// Signal strength (in percent) an access point has to gain or lose before it moves in the list
+static const int signalHysteresis = 5;
+
+BssidModel::BssidModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(updateInterval);
+    connect(&m_updateTimer, &QTimer::timeout, this, &BssidModel::update);
+
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        if (device->type() == NetworkManager::Device::Wifi) {
+            NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
+            connect(wifiDevice.data(), &NetworkManager::WirelessDevice::accessPointAppeared, this, &BssidModel::scheduleUpdate);
+            connect(wifiDevice.data(), &NetworkManager::WirelessDevice::accessPointDisappeared, this, &BssidModel::scheduleUpdate);
+        }
+    }
+}
+
+void BssidModel::setSsid(const QString &ssid, const QString &pinnedBssid)
+{
+    beginResetModel();
+
+    m_updateTimer.stop();
+    for (const Entry &entry : qAsConst(m_entries)) {
+        disconnect(entry.accessPoint.data(), nullptr, this, nullptr);
+    }
+    if (m_pinnedAccessPoint) {
+        disconnect(m_pinnedAccessPoint.data(), nullptr, this, nullptr);
+    }
+    m_entries.clear();
+
+    m_ssid = ssid;
+    m_pinnedBssid = pinnedBssid;
+    m_hasPinnedRow = true;
+
+    QHash<QString, NetworkManager::AccessPoint::Ptr> accessPoints = findAccessPoints();
+    m_pinnedAccessPoint = accessPoints.take(m_pinnedBssid);
+    if (m_pinnedAccessPoint) {
+        watchAccessPoint(m_pinnedAccessPoint);
+    }
+
+    for (auto it = accessPoints.constBegin(); it != accessPoints.constEnd(); ++it) {
+        Entry entry;
+        entry.bssid = it.key();
+        entry.accessPoint = it.value();
+        entry.sortSignal = it.value()->signalStrength();
+        m_entries.insert(insertPosition(entry.sortSignal), entry);
+        watchAccessPoint(it.value());
+    }
+
+    m_placeholder = m_entries.isEmpty() && !m_pinnedAccessPoint;
+
+    endResetModel();
+}
+
+int BssidModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return pinnedRows() + m_entries.size() + (m_placeholder ? 1 : 0);
+}
+
+QVariant BssidModel::data(const QModelIndex &index, int role) const
+{
+    const int row = index.row() - pinnedRows();
+    if (!index.isValid() || row >= m_entries.size() + (m_placeholder ? 1 : 0)) {
+        return QVariant();
+    }
+
+    NetworkManager::AccessPoint::Ptr accessPoint;
+    QString bssid;
+    if (row < 0) {
+        accessPoint = m_pinnedAccessPoint;
+        bssid = m_pinnedBssid;
+    } else if (row < m_entries.size()) {
+        accessPoint = m_entries.at(row).accessPoint;
+        bssid = m_entries.at(row).bssid;
+    } else {
+        if (role == Qt::DisplayRole) {
+            return i18n("First select the SSID");
+        }
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return accessPoint ? description(accessPoint) : bssid;
+    case BssidRole:
+        return bssid;
+    case SignalRole:
+        return accessPoint ? accessPoint->signalStrength() : QVariant();
+    case FrequencyRole:
+        return accessPoint ? accessPoint->frequency() : QVariant();
+    case ChannelRole:
+        return accessPoint ? NetworkManager::findChannel(accessPoint->frequency()) : QVariant();
+    }
+
+    return QVariant();
+}
+
+void BssidModel::scheduleUpdate()
+{
+    if (!m_updateTimer.isActive()) {
+        m_updateTimer.start();
+    }
+}
+
+void BssidModel::update()
+{
+    QHash<QString, NetworkManager::AccessPoint::Ptr> accessPoints = findAccessPoints();
+
+    Q_EMIT aboutToUpdate();
+
+    // Pinned row, it stays even when its access point is gone
+    if (m_hasPinnedRow) {
+        const NetworkManager::AccessPoint::Ptr accessPoint = accessPoints.take(m_pinnedBssid);
+        if (accessPoint != m_pinnedAccessPoint) {
+            if (m_pinnedAccessPoint) {
+                disconnect(m_pinnedAccessPoint.data(), nullptr, this, nullptr);
+            }
+            m_pinnedAccessPoint = accessPoint;
+            if (accessPoint) {
+                watchAccessPoint(accessPoint);
+            }
+        }
+        Q_EMIT dataChanged(index(0), index(0));
+    }
+
+    // Access points which are gone
+    for (int i = m_entries.size() - 1; i >= 0; --i) {
+        if (!accessPoints.contains(m_entries.at(i).bssid)) {
+            beginRemoveRows(QModelIndex(), pinnedRows() + i, pinnedRows() + i);
+            disconnect(m_entries.at(i).accessPoint.data(), nullptr, this, nullptr);
+            m_entries.removeAt(i);
+            endRemoveRows();
+        }
+    }
+
+    // Changed signal strength
+    bool resort = false;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        Entry &entry = m_entries[i];
+        const NetworkManager::AccessPoint::Ptr accessPoint = accessPoints.take(entry.bssid);
+        if (accessPoint != entry.accessPoint) {
+            // Now seen stronger through another device
+            disconnect(entry.accessPoint.data(), nullptr, this, nullptr);
+            entry.accessPoint = accessPoint;
+            watchAccessPoint(accessPoint);
+        }
+        if (qAbs(accessPoint->signalStrength() - entry.sortSignal) >= signalHysteresis) {
+            entry.sortSignal = accessPoint->signalStrength();
+            resort = true;
+        }
+    }
+    if (!m_entries.isEmpty()) {
+        Q_EMIT dataChanged(index(pinnedRows()), index(pinnedRows() + m_entries.size() - 1));
+    }
+
+    const bool placeholder = m_entries.isEmpty() && accessPoints.isEmpty() && !m_pinnedAccessPoint;
+    if (m_placeholder && !placeholder) {
+        beginRemoveRows(QModelIndex(), pinnedRows() + m_entries.size(), pinnedRows() + m_entries.size());
+        m_placeholder = false;
+        endRemoveRows();
+    }
+
+    // Access points which showed up, placed at their sorted position
+    for (auto it = accessPoints.constBegin(); it != accessPoints.constEnd(); ++it) {
+        Entry entry;
+        entry.bssid = it.key();
+        entry.accessPoint = it.value();
+        entry.sortSignal = it.value()->signalStrength();
+
+        const int position = insertPosition(entry.sortSignal);
+        beginInsertRows(QModelIndex(), pinnedRows() + position, pinnedRows() + position);
+        m_entries.insert(position, entry);
+        endInsertRows();
+        watchAccessPoint(it.value());
+    }
+
+    if (resort) {
+        QList<Entry> sorted = m_entries;
+        std::stable_sort(sorted.begin(), sorted.end(), [] (const Entry &left, const Entry &right) {
+            return left.sortSignal > right.sortSignal;
+        });
+
+        for (int i = 0; i < sorted.size(); ++i) {
+            int from = i;
+            while (m_entries.at(from).bssid != sorted.at(i).bssid) {
+                ++from;
+            }
+            if (from != i) {
+                beginMoveRows(QModelIndex(), pinnedRows() + from, pinnedRows() + from, QModelIndex(), pinnedRows() + i);
+                m_entries.move(from, i);
+                endMoveRows();
+            }
+        }
+    }
+
+    if (!m_placeholder && placeholder) {
+        beginInsertRows(QModelIndex(), pinnedRows(), pinnedRows());
+        m_placeholder = true;
+        endInsertRows();
+    }
+
+    Q_EMIT updated();
+}
+
+QHash<QString, NetworkManager::AccessPoint::Ptr> BssidModel::findAccessPoints() const
+{
+    QHash<QString, NetworkManager::AccessPoint::Ptr> accessPoints;
+
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        if (device->type() != NetworkManager::Device::Wifi) {
+            continue;
+        }
+
+        NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
+        NetworkManager::WirelessNetwork::Ptr wifiNetwork = wifiDevice->findNetwork(m_ssid);
+        if (!wifiNetwork) {
+            continue;
+        }
+
+        for (const NetworkManager::AccessPoint::Ptr &accessPoint : wifiNetwork->accessPoints()) {
+            if (!accessPoint) {
+                continue;
+            }
+
+            NetworkManager::AccessPoint::Ptr &existing = accessPoints[accessPoint->hardwareAddress()];
+            if (!existing || accessPoint->signalStrength() > existing->signalStrength()) {
+                existing = accessPoint;
+            }
+        }
+    }
+
+    return accessPoints;
+}
+
+void BssidModel::watchAccessPoint(const NetworkManager::AccessPoint::Ptr &accessPoint)
+{
+    connect(accessPoint.data(), &NetworkManager::AccessPoint::signalStrengthChanged, this, &BssidModel::scheduleUpdate, Qt::UniqueConnection);
+}
+
+int BssidModel::pinnedRows() const
+{
+    return m_hasPinnedRow ? 1 : 0;
+}
+
+int BssidModel::insertPosition(int sortSignal) const
+{
+    int position = 0;
+    while (position < m_entries.size() && m_entries.at(position).sortSignal >= sortSignal) {
+        ++position;
+    }
+    return position;
+}
+
+QString BssidModel::description(const NetworkManager::AccessPoint::Ptr &accessPoint) const
+{
+    const uint frequency = accessPoint->frequency();
+    QString band;
+    if (frequency < 3000) {
+        band = i18n("2.4 GHz");
+    } else if (frequency < 5925) {
+        band = i18n("5 GHz");
+    } else {
+        band = i18n("6 GHz");
+    }
+
+    return i18n("%1 (%2%)\nFrequency: %3 Mhz\nBand: %4, Channel: %5", accessPoint->hardwareAddress(), accessPoint->signalStrength(), frequency, band, QString::number(NetworkManager::findChannel(frequency)));
+}
@@ -0,0 +1,89 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_BSSID_MODEL_H
+#define PLASMA_NM_BSSID_MODEL_H
+
+#include <QAbstractListModel>
+#include <QTimer>
+
+#include <NetworkManagerQt/AccessPoint>
+
+/**
+ * Access points of a single SSID on all Wi-Fi devices, strongest first.
+ *
+ * The list follows the devices live. Changes are collected and applied at most
+ * once per second as row inserts, removals and moves, and an access point only
+ * overtakes another one once its signal changed noticeably, so the list does
+ * not jitter while the user picks from it.
+ *
+ * The BSSID passed to setSsid() is pinned to the first row.
+ */
+class Q_DECL_EXPORT BssidModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        BssidRole = Qt::UserRole,
+        SignalRole,
+        FrequencyRole,
+        ChannelRole
+    };
+
+    explicit BssidModel(QObject *parent = nullptr);
+
+    void setSsid(const QString &ssid, const QString &pinnedBssid);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+Q_SIGNALS:
+    // Emitted around every batch of live updates
+    void aboutToUpdate();
+    void updated();
+
+private Q_SLOTS:
+    void scheduleUpdate();
+    void update();
+
+private:
+    struct Entry {
+        QString bssid;
+        NetworkManager::AccessPoint::Ptr accessPoint;
+        // Signal strength the position in the list is based on
+        int sortSignal = 0;
+    };
+
+    QHash<QString, NetworkManager::AccessPoint::Ptr> findAccessPoints() const;
+    void watchAccessPoint(const NetworkManager::AccessPoint::Ptr &accessPoint);
+    int pinnedRows() const;
+    int insertPosition(int sortSignal) const;
+    QString description(const NetworkManager::AccessPoint::Ptr &accessPoint) const;
+
+    QString m_ssid;
+    QString m_pinnedBssid;
+    NetworkManager::AccessPoint::Ptr m_pinnedAccessPoint;
+    bool m_hasPinnedRow = false;
+    QList<Entry> m_entries;
+    bool m_placeholder = false;
+    QTimer m_updateTimer;
+};
+
+#endif // PLASMA_NM_BSSID_MODEL_H
@@ -18,34 +18,29 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <QStandardItem>
-#include <QStandardItemModel>
-#include <QNetworkAddressEntry>
+#include <QFile>
+#include <QFileDialog>
+#include <QStandardPaths>
+#include <QTextStream>
 
 #include <KAcceleratorManager>
 #include <KLocalizedString>
+#include <KMessageBox>
 
 #include "ui_ipv4routes.h"
 #include "ipv4routeswidget.h"
 #include "ipv4delegate.h"
 #include "intdelegate.h"
+#include "routemodel.h"
 
 class IpV4RoutesWidget::Private
 {
 public:
-    Private() : model(0,4)
+    Private() : model(QAbstractSocket::IPv4Protocol)
     {
-        QStandardItem * headerItem = new QStandardItem(i18nc("Header text for IPv4 address", "Address"));
-        model.setHorizontalHeaderItem(0, headerItem);
-        headerItem = new QStandardItem(i18nc("Header text for IPv4 netmask", "Netmask"));
-        model.setHorizontalHeaderItem(1, headerItem);
-        headerItem = new QStandardItem(i18nc("Header text for IPv4 gateway", "Gateway"));
-        model.setHorizontalHeaderItem(2, headerItem);
-        headerItem = new QStandardItem(i18nc("Header text for IPv4 route metric", "Metric"));
-        model.setHorizontalHeaderItem(3, headerItem);
     }
     Ui_RoutesIp4Config ui;
-    QStandardItemModel model;
+    RouteModel model;
 };
 
 IpV4RoutesWidget::IpV4RoutesWidget(QWidget * parent)
@@ -54,6 +49,8 @@ IpV4RoutesWidget::IpV4RoutesWidget(QWidget * parent)
     d->ui.setupUi(this);
     d->ui.tableViewAddresses->setModel(&d->model);
     d->ui.tableViewAddresses->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    // Rows all have the same height, spare the view from measuring thousands of them
+    d->ui.tableViewAddresses->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 
     IpV4Delegate *ipDelegate = new IpV4Delegate(this);
     IntDelegate *metricDelegate = new IntDelegate(this);
@@ -64,11 +61,11 @@ IpV4RoutesWidget::IpV4RoutesWidget(QWidget * parent)
 
     connect(d->ui.pushButtonAdd, &QPushButton::clicked, this, &IpV4RoutesWidget::addRoute);
     connect(d->ui.pushButtonRemove, &QPushButton::clicked, this, &IpV4RoutesWidget::removeRoute);
+    connect(d->ui.pushButtonImport, &QPushButton::clicked, this, &IpV4RoutesWidget::importRoutes);
+    connect(d->ui.pushButtonExport, &QPushButton::clicked, this, &IpV4RoutesWidget::exportRoutes);
 
     connect(d->ui.tableViewAddresses->selectionModel(), &QItemSelectionModel::selectionChanged, this, &IpV4RoutesWidget::selectionChanged);
 
-    connect(&d->model, &QStandardItemModel::itemChanged, this, &IpV4RoutesWidget::tableViewItemChanged);
-
     connect(d->ui.buttonBox, &QDialogButtonBox::accepted, this, &IpV4RoutesWidget::accept);
     connect(d->ui.buttonBox, &QDialogButtonBox::rejected, this, &IpV4RoutesWidget::reject);
 
@@ -107,53 +104,22 @@ bool IpV4RoutesWidget::ignoreautoroutes() const
 
 void IpV4RoutesWidget::setRoutes(const QList<NetworkManager::IpRoute> &list)
 {
-    d->model.removeRows(0, d->model.rowCount());
-    for (const NetworkManager::IpRoute &route : list) {
-        QList<QStandardItem *> item;
-
-        // qCDebug(PLASMA_NM) << route.ip();
-        item << new QStandardItem(route.ip().toString())
-             << new QStandardItem(route.netmask().toString())
-             << new QStandardItem(route.nextHop().toString())
-             << new QStandardItem(QString::number(route.metric(), 10));
-
-        d->model.appendRow(item);
-    }
+    d->model.setRoutes(list);
 }
 
 QList<NetworkManager::IpRoute> IpV4RoutesWidget::routes()
 {
-    QList<NetworkManager::IpRoute> list;
-
-    for (int i = 0, rowCount = d->model.rowCount(); i < rowCount; i++) {
-        NetworkManager::IpRoute route;
-        QStandardItem *item = d->model.item(i,0);
-        if (item) {
-            route.setIp(QHostAddress(item->text()));
-        }
-        item = d->model.item(i, 1);
-        if (item) {
-            route.setNetmask(QHostAddress(item->text()));
-        }
-        item = d->model.item(i, 2);
-        if (item) {
-            route.setNextHop(QHostAddress(item->text()));
-        }
-        item = d->model.item(i, 3);
-        if (item) {
-            route.setMetric(item->text().toUInt());
-        }
+    return d->model.routes();
+}
 
-        list << route;
-    }
-    return list;
+void IpV4RoutesWidget::setAddresses(const QList<NetworkManager::IpAddress> &list)
+{
+    d->model.setAddresses(list);
 }
 
 void IpV4RoutesWidget::addRoute()
 {
-    QList<QStandardItem *> item;
-    item << new QStandardItem << new QStandardItem << new QStandardItem;
-    d->model.appendRow(item);
+    d->model.insertRow(d->model.rowCount());
 
     const int rowCount = d->model.rowCount();
     if (rowCount > 0) {
@@ -174,37 +140,53 @@ void IpV4RoutesWidget::removeRoute()
     QItemSelectionModel * selectionModel = d->ui.tableViewAddresses->selectionModel();
     if (selectionModel->hasSelection()) {
         QModelIndexList indexes = selectionModel->selectedIndexes();
-        d->model.takeRow(indexes[0].row());
+        d->model.removeRow(indexes[0].row());
     }
     d->ui.pushButtonRemove->setEnabled(d->ui.tableViewAddresses->selectionModel()->hasSelection());
 }
 
-void IpV4RoutesWidget::selectionChanged(const QItemSelection & selected)
+void IpV4RoutesWidget::importRoutes()
 {
-    // qCDebug(PLASMA_NM) << "selectionChanged";
-    d->ui.pushButtonRemove->setEnabled(!selected.isEmpty());
-}
+    const QString filename = QFileDialog::getOpenFileName(this, i18n("Import Routes"), QStandardPaths::writableLocation(QStandardPaths::HomeLocation));
+    if (filename.isEmpty()) {
+        return;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        KMessageBox::error(this, i18n("Failed to open %1: %2", filename, file.errorString()), i18n("Import Routes"));
+        return;
+    }
 
-extern quint32 suggestNetmask(quint32 ip);
+    QTextStream stream(&file);
+    QStringList errors;
+    const int imported = d->model.importRoutes(stream, &errors);
+    if (!errors.isEmpty()) {
+        KMessageBox::informationList(this, i18np("Imported %1 route. The following lines were skipped:",
+                                                 "Imported %1 routes. The following lines were skipped:", imported),
+                                     errors, i18n("Import Routes"));
+    }
+}
 
-void IpV4RoutesWidget::tableViewItemChanged(QStandardItem *item)
+void IpV4RoutesWidget::exportRoutes()
 {
-    if (item->text().isEmpty()) {
+    const QString filename = QFileDialog::getSaveFileName(this, i18n("Export Routes"), QStandardPaths::writableLocation(QStandardPaths::HomeLocation));
+    if (filename.isEmpty()) {
         return;
     }
 
-    const int column = item->column();
-    if (column == 0) { // ip
-        int row = item->row();
-
-        QStandardItem *netmaskItem = d->model.item(row, column + 1); // netmask
-        if (netmaskItem && netmaskItem->text().isEmpty()) {
-            QHostAddress addr(item->text());
-            quint32 netmask = suggestNetmask(addr.toIPv4Address());
-            if (netmask) {
-                QHostAddress v(netmask);
-                netmaskItem->setText(v.toString());
-            }
-        }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        KMessageBox::error(this, i18n("Failed to write %1: %2", filename, file.errorString()), i18n("Export Routes"));
+        return;
     }
+
+    QTextStream stream(&file);
+    d->model.exportRoutes(stream);
+}
+
+void IpV4RoutesWidget::selectionChanged(const QItemSelection & selected)
+{
+    // qCDebug(PLASMA_NM) << "selectionChanged";
+    d->ui.pushButtonRemove->setEnabled(!selected.isEmpty());
 }
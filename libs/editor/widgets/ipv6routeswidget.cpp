@@ -18,35 +18,29 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <QStandardItem>
-#include <QStandardItemModel>
-#include <QNetworkAddressEntry>
+#include <QFile>
+#include <QFileDialog>
+#include <QStandardPaths>
+#include <QTextStream>
 
 #include <KAcceleratorManager>
 #include <KLocalizedString>
+#include <KMessageBox>
 
 #include "ui_ipv6routes.h"
-
+#include "ipv6routeswidget.h"
 #include "ipv6delegate.h"
 #include "intdelegate.h"
-#include "ipv6routeswidget.h"
+#include "routemodel.h"
 
 class IpV6RoutesWidget::Private
 {
 public:
-    Private() : model(0,4)
+    Private() : model(QAbstractSocket::IPv6Protocol)
     {
-        QStandardItem * headerItem = new QStandardItem(i18nc("Header text for IPv6 address", "Address"));
-        model.setHorizontalHeaderItem(0, headerItem);
-        headerItem = new QStandardItem(i18nc("Header text for IPv6 netmask", "Netmask"));
-        model.setHorizontalHeaderItem(1, headerItem);
-        headerItem = new QStandardItem(i18nc("Header text for IPv6 gateway", "Gateway"));
-        model.setHorizontalHeaderItem(2, headerItem);
-        headerItem = new QStandardItem(i18nc("Header text for IPv6 route metric", "Metric"));
-        model.setHorizontalHeaderItem(3, headerItem);
     }
     Ui_RoutesIp6Config ui;
-    QStandardItemModel model;
+    RouteModel model;
 };
 
 IpV6RoutesWidget::IpV6RoutesWidget(QWidget * parent)
@@ -55,6 +49,8 @@ IpV6RoutesWidget::IpV6RoutesWidget(QWidget * parent)
     d->ui.setupUi(this);
     d->ui.tableViewAddresses->setModel(&d->model);
     d->ui.tableViewAddresses->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    // Rows all have the same height, spare the view from measuring thousands of them
+    d->ui.tableViewAddresses->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 
     IpV6Delegate *ipDelegate = new IpV6Delegate(this);
     IntDelegate *netmaskDelegate = new IntDelegate(0,128,this);
@@ -66,12 +62,11 @@ IpV6RoutesWidget::IpV6RoutesWidget(QWidget * parent)
 
     connect(d->ui.pushButtonAdd, &QPushButton::clicked, this, &IpV6RoutesWidget::addRoute);
     connect(d->ui.pushButtonRemove, &QPushButton::clicked, this, &IpV6RoutesWidget::removeRoute);
+    connect(d->ui.pushButtonImport, &QPushButton::clicked, this, &IpV6RoutesWidget::importRoutes);
+    connect(d->ui.pushButtonExport, &QPushButton::clicked, this, &IpV6RoutesWidget::exportRoutes);
 
     connect(d->ui.tableViewAddresses->selectionModel(), &QItemSelectionModel::selectionChanged, this, &IpV6RoutesWidget::selectionChanged);
 
-
-    connect(&d->model, &QStandardItemModel::itemChanged, this, &IpV6RoutesWidget::tableViewItemChanged);
-
     connect(d->ui.buttonBox, &QDialogButtonBox::accepted, this, &IpV6RoutesWidget::accept);
     connect(d->ui.buttonBox, &QDialogButtonBox::rejected, this, &IpV6RoutesWidget::reject);
 
@@ -110,52 +105,22 @@ bool IpV6RoutesWidget::ignoreautoroutes() const
 
 void IpV6RoutesWidget::setRoutes(const QList<NetworkManager::IpRoute> &list)
 {
-    d->model.removeRows(0, d->model.rowCount());
-    for (const NetworkManager::IpRoute &route : list) {
-        QList<QStandardItem *> item;
-        // qCDebug(PLASMA_NM) << route.ip();
-        item << new QStandardItem(route.ip().toString())
-             << new QStandardItem(QString::number(route.prefixLength(), 10))
-             << new QStandardItem(route.nextHop().toString())
-             << new QStandardItem(QString::number(route.metric(), 10));
-
-        d->model.appendRow(item);
-    }
+    d->model.setRoutes(list);
 }
 
 QList<NetworkManager::IpRoute> IpV6RoutesWidget::routes()
 {
-    QList<NetworkManager::IpRoute> list;
-
-    for (int i = 0, rowCount = d->model.rowCount(); i < rowCount; i++) {
-        NetworkManager::IpRoute route;
-        QStandardItem *item = d->model.item(i,0);
-        if (item) {
-            route.setIp(QHostAddress(item->text()));
-        }
-        item = d->model.item(i, 2);
-        if (item) {
-            route.setNextHop(QHostAddress(item->text()));
-        }
-        item = d->model.item(i, 1);
-        if (item) {
-            route.setPrefixLength(item->text().toInt());
-        }
-        item = d->model.item(i, 3);
-        if (item) {
-            route.setMetric(item->text().toUInt());
-        }
+    return d->model.routes();
+}
 
-        list << route;
-    }
-    return list;
+void IpV6RoutesWidget::setAddresses(const QList<NetworkManager::IpAddress> &list)
+{
+    d->model.setAddresses(list);
 }
 
 void IpV6RoutesWidget::addRoute()
 {
-    QList<QStandardItem *> item;
-    item << new QStandardItem << new QStandardItem << new QStandardItem;
-    d->model.appendRow(item);
+    d->model.insertRow(d->model.rowCount());
 
     const int rowCount = d->model.rowCount();
     if (rowCount > 0) {
@@ -176,36 +141,53 @@ void IpV6RoutesWidget::removeRoute()
     QItemSelectionModel * selectionModel = d->ui.tableViewAddresses->selectionModel();
     if (selectionModel->hasSelection()) {
         QModelIndexList indexes = selectionModel->selectedIndexes();
-        d->model.takeRow(indexes[0].row());
+        d->model.removeRow(indexes[0].row());
     }
     d->ui.pushButtonRemove->setEnabled(false);
 }
 
-void IpV6RoutesWidget::selectionChanged(const QItemSelection & selected)
+void IpV6RoutesWidget::importRoutes()
 {
-    // qCDebug(PLASMA_NM) << "selectionChanged";
-    d->ui.pushButtonRemove->setEnabled(!selected.isEmpty());
-}
+    const QString filename = QFileDialog::getOpenFileName(this, i18n("Import Routes"), QStandardPaths::writableLocation(QStandardPaths::HomeLocation));
+    if (filename.isEmpty()) {
+        return;
+    }
 
-extern quint32 suggestNetmask(Q_IPV6ADDR ip);
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        KMessageBox::error(this, i18n("Failed to open %1: %2", filename, file.errorString()), i18n("Import Routes"));
+        return;
+    }
 
-void IpV6RoutesWidget::tableViewItemChanged(QStandardItem *item)
+    QTextStream stream(&file);
+    QStringList errors;
+    const int imported = d->model.importRoutes(stream, &errors);
+    if (!errors.isEmpty()) {
+        KMessageBox::informationList(this, i18np("Imported %1 route. The following lines were skipped:",
+                                                 "Imported %1 routes. The following lines were skipped:", imported),
+                                     errors, i18n("Import Routes"));
+    }
+}
+
+void IpV6RoutesWidget::exportRoutes()
 {
-    if (item->text().isEmpty()) {
+    const QString filename = QFileDialog::getSaveFileName(this, i18n("Export Routes"), QStandardPaths::writableLocation(QStandardPaths::HomeLocation));
+    if (filename.isEmpty()) {
         return;
     }
 
-    const int column = item->column();
-    if (column == 0) { // ip
-        int row = item->row();
-
-        QStandardItem *netmaskItem = d->model.item(row, column + 1); // netmask
-        if (netmaskItem && netmaskItem->text().isEmpty()) {
-            QHostAddress addr(item->text());
-            quint32 netmask = suggestNetmask(addr.toIPv6Address());
-            if (netmask) {
-                netmaskItem->setText(QString::number(netmask,10));
-            }
-        }
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        KMessageBox::error(this, i18n("Failed to write %1: %2", filename, file.errorString()), i18n("Export Routes"));
+        return;
     }
+
+    QTextStream stream(&file);
+    d->model.exportRoutes(stream);
+}
+
+void IpV6RoutesWidget::selectionChanged(const QItemSelection & selected)
+{
+    // qCDebug(PLASMA_NM) << "selectionChanged";
+    d->ui.pushButtonRemove->setEnabled(!selected.isEmpty());
 }
@@ -26,7 +26,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <NetworkManagerQt/IpConfig>
 
-class QStandardItem;
 class QItemSelection;
 
 class IpV6RoutesWidget : public QDialog
@@ -38,6 +37,10 @@ public:
 
     void setRoutes(const QList<NetworkManager::IpRoute> &list);
     QList<NetworkManager::IpRoute> routes();
+    /**
+     * Addresses of the connection, enables checking the gateways of the routes
+     */
+    void setAddresses(const QList<NetworkManager::IpAddress> &list);
     void setNeverDefault(bool checked);
     bool neverDefault() const;
     void setIgnoreAutoRoutes(bool checked);
@@ -51,7 +54,11 @@ private Q_SLOTS:
      * Update remove IP button depending on if there is a selection
      */
     void selectionChanged(const QItemSelection &);
-    void tableViewItemChanged(QStandardItem *);
+    /**
+     * Append routes from a file in "ip route" format
+     */
+    void importRoutes();
+    void exportRoutes();
 
 private:
     class Private;
@@ -86,6 +86,8 @@ void MobileConnectionWizard::initializePage(int id)
             QList<QListWidgetItem *> items = mCountryList->findItems(mProviders->getCountryName(country), Qt::MatchExactly);
             if (!items.empty()) {
                 mCountryList->setCurrentItem(items.first());
+            } else if (!mCountryList->currentItem()) {
+                mCountryList->setCurrentRow(0);
             }
         }
 
@@ -126,6 +128,12 @@ void MobileConnectionWizard::initializePage(int id)
             break;
         }
         mProvidersList->setCurrentRow(0);
+        if (!mOperatorProvider.isEmpty()) {
+            const QList<QListWidgetItem *> items = mProvidersList->findItems(mOperatorProvider, Qt::MatchExactly);
+            if (!items.isEmpty()) {
+                mProvidersList->setCurrentItem(items.first());
+            }
+        }
         if (mProvidersList->count() > 0) {
             mProvidersList->setEnabled(true);
             radioAutoProvider->setEnabled(true);
@@ -173,6 +181,13 @@ OUT_3:
         break;
 
     case 4: // Confirm Page
+        if (!hasVisitedPage(2)) {
+            // Jumped here from the intro page, fill in the skipped pages with the provider of the SIM card
+            initializePage(1);
+            initializePage(2);
+            initializePage(3);
+        }
+
         if (radioManualProvider->isChecked()) {
             labelProvider->setText("    " + lineEditProvider->text() + ", " + country);
             provider = lineEditProvider->text();
@@ -210,8 +225,50 @@ OUT_3:
     }
 }
 
+bool MobileConnectionWizard::validateCurrentPage()
+{
+    // Intro page
+    if (currentId() == 0) {
+        lookupOperator();
+    }
+    return QWizard::validateCurrentPage();
+}
+
+void MobileConnectionWizard::lookupOperator()
+{
+    mSkipToConfirm = false;
+    if (mInitialMethodType) {
+        return;
+    }
+
+    // Only look up each device once, going back to the intro page allows changing the settings
+    const QString uni = mDeviceComboBox->itemData(mDeviceComboBox->currentIndex()).toString();
+    if (uni == mOperatorDevice) {
+        return;
+    }
+    mOperatorDevice = uni;
+    mOperatorProvider.clear();
+
+    NetworkManager::ModemDevice::Ptr nmModemIface = NetworkManager::findNetworkInterface(uni).objectCast<NetworkManager::ModemDevice>();
+    if (!nmModemIface || UiUtils::modemSubType(nmModemIface->currentCapabilities()) != NetworkManager::ModemDevice::GsmUmts) {
+        return;
+    }
+
+    QString operatorCountry;
+    const QString operatorCode = MobileProviders::operatorCode(ModemManager::findModemDevice(nmModemIface->udi()));
+    if (mProviders->findOperator(operatorCode, &operatorCountry, &mOperatorProvider)) {
+        country = operatorCountry;
+        mSkipToConfirm = true;
+    }
+}
+
 int MobileConnectionWizard::nextId() const
 {
+    // Intro page
+    if (currentId() == 0 && mSkipToConfirm) {
+        return 4;
+    }
+
     // Providers page
     if (currentId() == 2 && type() != NetworkManager::ConnectionSettings::Gsm) {
         // Jumps to Confirm page instead of Plans page if type != Gsm.
@@ -77,7 +77,9 @@ private:
     QWizardPage * createPlansPage();
     QWizardPage * createConfirmPage();
     void initializePage(int id) override;
+    bool validateCurrentPage() override;
     int nextId() const override;
+    void lookupOperator();
 
     MobileProviders * mProviders;
     QString country;
@@ -86,6 +88,11 @@ private:
     NetworkManager::ConnectionSettings::ConnectionType mType;
     bool mInitialMethodType;
 
+    // Provider of the SIM card in the selected device
+    QString mOperatorDevice;
+    QString mOperatorProvider;
+    bool mSkipToConfirm = false;
+
     // Intro page
     KComboBox * mDeviceComboBox;
     void introAddInitialDevices();
@@ -0,0 +1,338 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "routeanalyzer.h"
+
+RouteAnalyzer::RouteAnalyzer(QAbstractSocket::NetworkLayerProtocol protocol)
+    : m_protocol(protocol)
+    , m_bitOffset(protocol == QAbstractSocket::IPv4Protocol ? 96 : 0)
+    , m_maxPrefixLength(protocol == QAbstractSocket::IPv4Protocol ? 32 : 128)
+{
+    m_nodes.resize(1);
+}
+
+void RouteAnalyzer::setRoutes(const QVector<RouteEntry> &routes)
+{
+    m_routes.clear();
+    m_routes.reserve(routes.size());
+    m_freeHandles.clear();
+
+    for (const RouteEntry &entry : routes) {
+        Route route;
+        route.entry = entry;
+        route.used = true;
+        m_routes << route;
+    }
+
+    rebuild();
+}
+
+int RouteAnalyzer::addRoute(const RouteEntry &entry)
+{
+    int handle;
+    if (m_freeHandles.isEmpty()) {
+        handle = m_routes.size();
+        m_routes.append(Route());
+    } else {
+        handle = m_freeHandles.takeLast();
+        m_routes[handle] = Route();
+    }
+
+    m_routes[handle].entry = entry;
+    m_routes[handle].used = true;
+
+    QVector<int> path;
+    insert(handle, &path);
+    updateCoverage(path);
+    evaluatePath(path);
+    evaluate(handle);
+    if (isOnLink(handle)) {
+        evaluateNextHops();
+    }
+
+    return handle;
+}
+
+bool RouteAnalyzer::updateRoute(int handle, const RouteEntry &entry)
+{
+    if (handle < 0 || handle >= m_routes.size() || !m_routes.at(handle).used) {
+        return false;
+    }
+
+    const bool wasOnLink = isOnLink(handle);
+
+    QVector<int> oldPath;
+    QVector<int> newPath;
+    take(handle, &oldPath);
+    m_routes[handle].entry = entry;
+    insert(handle, &newPath);
+
+    updateCoverage(oldPath);
+    updateCoverage(newPath);
+
+    bool changed = evaluatePath(oldPath);
+    changed |= evaluatePath(newPath);
+    changed |= evaluate(handle);
+    if (wasOnLink || isOnLink(handle)) {
+        changed |= evaluateNextHops();
+    }
+
+    return changed;
+}
+
+bool RouteAnalyzer::removeRoute(int handle)
+{
+    if (handle < 0 || handle >= m_routes.size() || !m_routes.at(handle).used) {
+        return false;
+    }
+
+    const bool wasOnLink = isOnLink(handle);
+
+    QVector<int> path;
+    take(handle, &path);
+    m_routes[handle] = Route();
+    m_freeHandles << handle;
+
+    updateCoverage(path);
+    bool changed = evaluatePath(path);
+    if (wasOnLink) {
+        changed |= evaluateNextHops();
+    }
+
+    return changed;
+}
+
+void RouteAnalyzer::setAddresses(const QList<NetworkManager::IpAddress> &addresses)
+{
+    m_addresses.clear();
+    for (const NetworkManager::IpAddress &address : addresses) {
+        if (address.ip().protocol() == m_protocol && address.prefixLength() >= 0) {
+            m_addresses << qMakePair(RouteEntry::toRaw(address.ip()), qMin(address.prefixLength(), m_maxPrefixLength));
+        }
+    }
+    m_checkNextHops = true;
+
+    rebuild();
+}
+
+RouteAnalyzer::Issues RouteAnalyzer::issues(int handle) const
+{
+    return handle >= 0 && handle < m_routes.size() ? m_routes.at(handle).issues : NoIssue;
+}
+
+int RouteAnalyzer::duplicateOf(int handle) const
+{
+    return handle >= 0 && handle < m_routes.size() ? m_routes.at(handle).duplicateOf : -1;
+}
+
+bool RouteAnalyzer::bit(const Q_IPV6ADDR &address, int index) const
+{
+    const int i = m_bitOffset + index;
+    return address[i / 8] & (0x80 >> (i % 8));
+}
+
+int RouteAnalyzer::findNode(const Q_IPV6ADDR &address, int prefixLength, QVector<int> *path)
+{
+    int node = 0;
+    if (path) {
+        path->reserve(prefixLength + 1);
+        path->append(node);
+    }
+
+    for (int i = 0; i < prefixLength; ++i) {
+        const int direction = bit(address, i);
+        int child = m_nodes.at(node).child[direction];
+        if (child < 0) {
+            child = m_nodes.size();
+            m_nodes.append(Node());
+            m_nodes[node].child[direction] = child;
+        }
+        node = child;
+        if (path) {
+            path->append(node);
+        }
+    }
+
+    return node;
+}
+
+bool RouteAnalyzer::isOnLink(int handle) const
+{
+    const Route &route = m_routes.at(handle);
+    return route.node >= 0 && !route.entry.hasNextHop;
+}
+
+bool RouteAnalyzer::isReachable(const Q_IPV6ADDR &address) const
+{
+    // IPv6 link-local gateways are always on-link
+    if (m_protocol == QAbstractSocket::IPv6Protocol && address[0] == 0xfe && (address[1] & 0xc0) == 0x80) {
+        return true;
+    }
+
+    // Any network on the way to the most specific one containing the address
+    int node = 0;
+    for (int i = 0; node >= 0; ++i) {
+        const Node &current = m_nodes.at(node);
+        if (current.addresses || current.onLinkRoutes) {
+            return true;
+        }
+        node = i < m_maxPrefixLength ? current.child[bit(address, i)] : -1;
+    }
+
+    return false;
+}
+
+void RouteAnalyzer::insert(int handle, QVector<int> *path)
+{
+    Route &route = m_routes[handle];
+    route.node = -1;
+
+    // Rows which are still being edited are not part of the analysis
+    if (!route.entry.hasAddress || route.entry.prefixLength < 0 || route.entry.prefixLength > m_maxPrefixLength) {
+        return;
+    }
+
+    const int node = findNode(route.entry.address, route.entry.prefixLength, path);
+    m_routes[handle].node = node;
+    m_nodes[node].routes << handle;
+    if (!m_routes.at(handle).entry.hasNextHop) {
+        ++m_nodes[node].onLinkRoutes;
+    }
+}
+
+void RouteAnalyzer::take(int handle, QVector<int> *path)
+{
+    Route &route = m_routes[handle];
+    if (route.node < 0) {
+        return;
+    }
+
+    findNode(route.entry.address, route.entry.prefixLength, path);
+    Node &node = m_nodes[route.node];
+    node.routes.removeOne(handle);
+    if (!route.entry.hasNextHop) {
+        --node.onLinkRoutes;
+    }
+    route.node = -1;
+}
+
+void RouteAnalyzer::rebuild()
+{
+    m_nodes.clear();
+    m_nodes.resize(1);
+
+    for (const QPair<Q_IPV6ADDR, int> &address : qAsConst(m_addresses)) {
+        ++m_nodes[findNode(address.first, address.second)].addresses;
+    }
+
+    for (int handle = 0; handle < m_routes.size(); ++handle) {
+        if (m_routes.at(handle).used) {
+            insert(handle, nullptr);
+        }
+    }
+
+    // Children are always created after their parent
+    for (int i = m_nodes.size() - 1; i >= 0; --i) {
+        Node &node = m_nodes[i];
+        node.covered = !node.routes.isEmpty() ||
+                       (node.child[0] >= 0 && node.child[1] >= 0 && m_nodes.at(node.child[0]).covered && m_nodes.at(node.child[1]).covered);
+    }
+
+    for (int handle = 0; handle < m_routes.size(); ++handle) {
+        evaluate(handle);
+    }
+}
+
+void RouteAnalyzer::updateCoverage(const QVector<int> &path)
+{
+    for (int i = path.size() - 1; i >= 0; --i) {
+        Node &node = m_nodes[path.at(i)];
+        node.covered = !node.routes.isEmpty() ||
+                       (node.child[0] >= 0 && node.child[1] >= 0 && m_nodes.at(node.child[0]).covered && m_nodes.at(node.child[1]).covered);
+    }
+}
+
+bool RouteAnalyzer::evaluate(int handle)
+{
+    Route &route = m_routes[handle];
+    Issues issues = NoIssue;
+    int duplicateOf = -1;
+
+    if (route.node >= 0) {
+        const Node &node = m_nodes.at(route.node);
+
+        for (int other : node.routes) {
+            if (other != handle && m_routes.at(other).entry.metric == route.entry.metric) {
+                issues |= Duplicate;
+                duplicateOf = other;
+                break;
+            }
+        }
+
+        if (node.child[0] >= 0 && node.child[1] >= 0 && m_nodes.at(node.child[0]).covered && m_nodes.at(node.child[1]).covered) {
+            issues |= Shadowed;
+        }
+
+        // The own networks are on the way to the route's node
+        int current = 0;
+        for (int i = 0; current >= 0; ++i) {
+            if (m_nodes.at(current).addresses) {
+                issues |= WithinAddressNetwork;
+                break;
+            }
+            current = i < route.entry.prefixLength ? m_nodes.at(current).child[bit(route.entry.address, i)] : -1;
+        }
+
+        if (m_checkNextHops && route.entry.hasNextHop && !isReachable(route.entry.nextHop)) {
+            issues |= UnreachableNextHop;
+        }
+    }
+
+    const bool changed = issues != route.issues || duplicateOf != route.duplicateOf;
+    route.issues = issues;
+    route.duplicateOf = duplicateOf;
+    return changed;
+}
+
+bool RouteAnalyzer::evaluatePath(const QVector<int> &path)
+{
+    bool changed = false;
+    for (int node : path) {
+        for (int handle : m_nodes.at(node).routes) {
+            changed |= evaluate(handle);
+        }
+    }
+    return changed;
+}
+
+bool RouteAnalyzer::evaluateNextHops()
+{
+    if (!m_checkNextHops) {
+        return false;
+    }
+
+    bool changed = false;
+    for (int handle = 0; handle < m_routes.size(); ++handle) {
+        if (m_routes.at(handle).entry.hasNextHop) {
+            changed |= evaluate(handle);
+        }
+    }
+    return changed;
+}
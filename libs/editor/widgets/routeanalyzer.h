@@ -0,0 +1,120 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_ROUTE_ANALYZER_H
+#define PLASMA_NM_ROUTE_ANALYZER_H
+
+#include <QVector>
+
+#include <NetworkManagerQt/IpAddress>
+
+#include "routemodel.h"
+
+/**
+ * Finds problems in a list of static routes of one address family: duplicates,
+ * routes whose whole destination is covered by more specific routes, gateways
+ * which are not on-link and destinations within the connection's own networks.
+ *
+ * Routes are kept in a binary prefix trie, so analyzing n routes takes
+ * O(n * prefix length). Changing a single route only re-evaluates the routes
+ * on the trie paths of its old and new destination, unless it is an on-link
+ * route, which can make the gateway of any other route reachable.
+ *
+ * Routes are referred to by the handle returned when adding them.
+ */
+class Q_DECL_EXPORT RouteAnalyzer
+{
+public:
+    enum Issue {
+        NoIssue = 0,
+        Duplicate = 0x1,            // same destination and metric as another route
+        Shadowed = 0x2,             // more specific routes cover the whole destination
+        UnreachableNextHop = 0x4,   // no address or on-link route covers the gateway
+        WithinAddressNetwork = 0x8  // the destination is part of the connection's own network
+    };
+    Q_DECLARE_FLAGS(Issues, Issue)
+
+    explicit RouteAnalyzer(QAbstractSocket::NetworkLayerProtocol protocol);
+
+    /**
+     * Replaces all routes, their handles are their indexes in @p routes.
+     */
+    void setRoutes(const QVector<RouteEntry> &routes);
+    int addRoute(const RouteEntry &route);
+    /**
+     * @return whether the issues of any route changed
+     */
+    bool updateRoute(int handle, const RouteEntry &route);
+    bool removeRoute(int handle);
+
+    /**
+     * Sets the addresses of the connection. Gateways are only checked once
+     * the addresses are known.
+     */
+    void setAddresses(const QList<NetworkManager::IpAddress> &addresses);
+
+    Issues issues(int handle) const;
+    /**
+     * The route which @p handle duplicates, or -1.
+     */
+    int duplicateOf(int handle) const;
+
+private:
+    struct Node {
+        int child[2] = {-1, -1};
+        QVector<int> routes;
+        int addresses = 0;      // connection addresses with this network
+        int onLinkRoutes = 0;   // routes of this destination without gateway
+        bool covered = false;   // every address below is matched by a route
+    };
+
+    struct Route {
+        RouteEntry entry;
+        int node = -1;          // -1 for removed or incomplete routes
+        bool used = false;
+        Issues issues;
+        int duplicateOf = -1;
+    };
+
+    bool bit(const Q_IPV6ADDR &address, int index) const;
+    int findNode(const Q_IPV6ADDR &address, int prefixLength, QVector<int> *path = nullptr);
+    bool isOnLink(int handle) const;
+    bool isReachable(const Q_IPV6ADDR &address) const;
+    void insert(int handle, QVector<int> *path);
+    void take(int handle, QVector<int> *path);
+    void rebuild();
+    void updateCoverage(const QVector<int> &path);
+    bool evaluate(int handle);
+    bool evaluatePath(const QVector<int> &path);
+    bool evaluateNextHops();
+
+    QAbstractSocket::NetworkLayerProtocol m_protocol;
+    int m_bitOffset;
+    int m_maxPrefixLength;
+    bool m_checkNextHops = false;
+    QVector<QPair<Q_IPV6ADDR, int>> m_addresses;
+    QVector<Node> m_nodes;
+    QVector<Route> m_routes;
+    QVector<int> m_freeHandles;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(RouteAnalyzer::Issues)
+
+#endif // PLASMA_NM_ROUTE_ANALYZER_H
@@ -0,0 +1,573 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "routemodel.h"
+#include "routeanalyzer.h"
+
+#include <QIcon>
+#include <QtAlgorithms>
+#include <QTextStream>
+
+#include <KLocalizedString>
+
+#include <cstring>
+#include <numeric>
+
+extern quint32 suggestNetmask(quint32 ip);
+extern quint32 suggestNetmask(Q_IPV6ADDR ip);
+
+// Words of "ip route" output which are not followed by a value
+static const QStringList routeFlags = {
+    QStringLiteral("onlink"),
+    QStringLiteral("pervasive"),
+    QStringLiteral("linkdown"),
+    QStringLiteral("dead"),
+    QStringLiteral("offload"),
+    QStringLiteral("trap"),
+    QStringLiteral("notify"),
+    QStringLiteral("rt_offload"),
+    QStringLiteral("rt_trap"),
+    QStringLiteral("rt_offload_failed")
+};
+
+static int maxPrefixLength(QAbstractSocket::NetworkLayerProtocol protocol)
+{
+    return protocol == QAbstractSocket::IPv4Protocol ? 32 : 128;
+}
+
+static bool isNullAddress(const Q_IPV6ADDR &address)
+{
+    static const Q_IPV6ADDR zero = RouteEntry().address;
+    static const Q_IPV6ADDR mappedZero = RouteEntry::toRaw(QHostAddress(QHostAddress::AnyIPv4));
+    return !memcmp(&address, &zero, sizeof(Q_IPV6ADDR)) || !memcmp(&address, &mappedZero, sizeof(Q_IPV6ADDR));
+}
+
+static QHostAddress fromRaw(const Q_IPV6ADDR &address, QAbstractSocket::NetworkLayerProtocol protocol)
+{
+    if (protocol == QAbstractSocket::IPv4Protocol) {
+        return QHostAddress(quint32(address[12]) << 24 | quint32(address[13]) << 16 | quint32(address[14]) << 8 | address[15]);
+    }
+    return QHostAddress(address);
+}
+
+RouteEntry::RouteEntry()
+{
+    memset(&address, 0, sizeof(Q_IPV6ADDR));
+    memset(&nextHop, 0, sizeof(Q_IPV6ADDR));
+}
+
+QHostAddress RouteEntry::addressValue(QAbstractSocket::NetworkLayerProtocol protocol) const
+{
+    return hasAddress ? fromRaw(address, protocol) : QHostAddress();
+}
+
+QHostAddress RouteEntry::nextHopValue(QAbstractSocket::NetworkLayerProtocol protocol) const
+{
+    return hasNextHop ? fromRaw(nextHop, protocol) : QHostAddress();
+}
+
+Q_IPV6ADDR RouteEntry::toRaw(const QHostAddress &address)
+{
+    if (address.protocol() != QAbstractSocket::IPv4Protocol) {
+        return address.toIPv6Address();
+    }
+
+    Q_IPV6ADDR raw;
+    memset(&raw, 0, sizeof(Q_IPV6ADDR));
+    const quint32 ip = address.toIPv4Address();
+    raw[10] = 0xff;
+    raw[11] = 0xff;
+    raw[12] = ip >> 24;
+    raw[13] = ip >> 16;
+    raw[14] = ip >> 8;
+    raw[15] = ip;
+    return raw;
+}
+
+RouteModel::RouteModel(QAbstractSocket::NetworkLayerProtocol protocol, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_protocol(protocol)
+    , m_analyzer(new RouteAnalyzer(protocol))
+{
+}
+
+RouteModel::~RouteModel()
+{
+}
+
+QAbstractSocket::NetworkLayerProtocol RouteModel::protocol() const
+{
+    return m_protocol;
+}
+
+int RouteModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_routes.size();
+}
+
+int RouteModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant RouteModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_routes.size()) {
+        return QVariant();
+    }
+
+    if (role == Qt::DecorationRole && index.column() == AddressColumn) {
+        return m_analyzer->issues(m_handles.at(index.row())) ? QIcon::fromTheme(QStringLiteral("dialog-warning")) : QVariant();
+    } else if (role == Qt::ToolTipRole) {
+        const QString text = issuesText(index.row());
+        return text.isEmpty() ? QVariant() : text;
+    } else if (role != Qt::DisplayRole && role != Qt::EditRole) {
+        return QVariant();
+    }
+
+    const RouteEntry &route = m_routes.at(index.row());
+    switch (index.column()) {
+    case AddressColumn:
+        return route.hasAddress ? route.addressValue(m_protocol).toString() : QString();
+    case PrefixColumn:
+        return prefixText(route);
+    case NextHopColumn:
+        return route.hasNextHop ? route.nextHopValue(m_protocol).toString() : QString();
+    case MetricColumn:
+        return QString::number(route.metric);
+    }
+
+    return QVariant();
+}
+
+bool RouteModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || index.row() >= m_routes.size() || role != Qt::EditRole) {
+        return false;
+    }
+
+    RouteEntry &route = m_routes[index.row()];
+    const QString text = value.toString().trimmed();
+
+    switch (index.column()) {
+    case AddressColumn:
+    case NextHopColumn: {
+        QHostAddress address;
+        if (!text.isEmpty() && (!address.setAddress(text) || address.protocol() != m_protocol)) {
+            return false;
+        }
+
+        if (index.column() == NextHopColumn) {
+            route.hasNextHop = !address.isNull();
+            route.nextHop = RouteEntry::toRaw(address);
+            break;
+        }
+
+        route.hasAddress = !address.isNull();
+        route.address = RouteEntry::toRaw(address);
+
+        // Suggest the prefix of the address class
+        if (route.hasAddress && route.prefixLength < 0) {
+            if (m_protocol == QAbstractSocket::IPv4Protocol) {
+                const quint32 netmask = suggestNetmask(address.toIPv4Address());
+                if (netmask) {
+                    route.prefixLength = 32 - qCountTrailingZeroBits(netmask);
+                }
+            } else {
+                route.prefixLength = suggestNetmask(address.toIPv6Address());
+            }
+
+            if (route.prefixLength >= 0) {
+                const QModelIndex prefixIndex = index.sibling(index.row(), PrefixColumn);
+                Q_EMIT dataChanged(prefixIndex, prefixIndex);
+            }
+        }
+        break;
+    }
+    case PrefixColumn:
+        if (!setPrefixText(route, text)) {
+            return false;
+        }
+        break;
+    case MetricColumn: {
+        bool ok = true;
+        const quint32 metric = text.isEmpty() ? 0 : text.toUInt(&ok);
+        if (!ok) {
+            return false;
+        }
+        route.metric = metric;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    Q_EMIT dataChanged(index, index);
+
+    if (m_analyzer->updateRoute(m_handles.at(index.row()), route)) {
+        analysisChanged();
+    }
+    return true;
+}
+
+QVariant RouteModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    const bool ipv4 = m_protocol == QAbstractSocket::IPv4Protocol;
+    switch (section) {
+    case AddressColumn:
+        return ipv4 ? i18nc("Header text for IPv4 address", "Address") : i18nc("Header text for IPv6 address", "Address");
+    case PrefixColumn:
+        return ipv4 ? i18nc("Header text for IPv4 netmask", "Netmask") : i18nc("Header text for IPv6 netmask", "Netmask");
+    case NextHopColumn:
+        return ipv4 ? i18nc("Header text for IPv4 gateway", "Gateway") : i18nc("Header text for IPv6 gateway", "Gateway");
+    case MetricColumn:
+        return ipv4 ? i18nc("Header text for IPv4 route metric", "Metric") : i18nc("Header text for IPv6 route metric", "Metric");
+    }
+
+    return QVariant();
+}
+
+Qt::ItemFlags RouteModel::flags(const QModelIndex &index) const
+{
+    return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+bool RouteModel::insertRows(int row, int count, const QModelIndex &parent)
+{
+    if (parent.isValid() || row < 0 || row > m_routes.size() || count <= 0) {
+        return false;
+    }
+
+    beginInsertRows(parent, row, row + count - 1);
+    m_routes.insert(row, count, RouteEntry());
+    m_handles.insert(row, count, -1);
+    for (int i = row; i < row + count; ++i) {
+        m_handles[i] = m_analyzer->addRoute(RouteEntry());
+    }
+    endInsertRows();
+    return true;
+}
+
+bool RouteModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    if (parent.isValid() || row < 0 || count <= 0 || row + count > m_routes.size()) {
+        return false;
+    }
+
+    bool changed = false;
+    for (int i = row; i < row + count; ++i) {
+        changed |= m_analyzer->removeRoute(m_handles.at(i));
+    }
+
+    beginRemoveRows(parent, row, row + count - 1);
+    m_routes.remove(row, count);
+    m_handles.remove(row, count);
+    endRemoveRows();
+
+    if (changed) {
+        analysisChanged();
+    }
+    return true;
+}
+
+void RouteModel::setRoutes(const QList<NetworkManager::IpRoute> &routes)
+{
+    beginResetModel();
+    m_routes.clear();
+    m_routes.reserve(routes.size());
+    for (const NetworkManager::IpRoute &route : routes) {
+        RouteEntry entry;
+        entry.hasAddress = !route.ip().isNull();
+        entry.address = RouteEntry::toRaw(route.ip());
+        entry.prefixLength = route.prefixLength();
+        entry.hasNextHop = !route.nextHop().isNull();
+        entry.nextHop = RouteEntry::toRaw(route.nextHop());
+        entry.metric = route.metric();
+        m_routes << entry;
+    }
+    m_analyzer->setRoutes(m_routes);
+    m_handles.resize(m_routes.size());
+    std::iota(m_handles.begin(), m_handles.end(), 0);
+    endResetModel();
+}
+
+QList<NetworkManager::IpRoute> RouteModel::routes() const
+{
+    QList<NetworkManager::IpRoute> list;
+    list.reserve(m_routes.size());
+
+    for (const RouteEntry &entry : m_routes) {
+        NetworkManager::IpRoute route;
+        route.setIp(entry.addressValue(m_protocol));
+        if (entry.prefixLength >= 0) {
+            route.setPrefixLength(entry.prefixLength);
+        }
+        route.setNextHop(entry.nextHopValue(m_protocol));
+        route.setMetric(entry.metric);
+        list << route;
+    }
+
+    return list;
+}
+
+const QVector<RouteEntry> &RouteModel::entries() const
+{
+    return m_routes;
+}
+
+void RouteModel::setAddresses(const QList<NetworkManager::IpAddress> &addresses)
+{
+    m_analyzer->setAddresses(addresses);
+    // Handles stay valid, the analyzer only re-evaluates the routes
+    analysisChanged();
+}
+
+int RouteModel::importRoutes(QTextStream &stream, QStringList *errors)
+{
+    QVector<RouteEntry> imported;
+    QString line;
+    int lineNumber = 0;
+
+    while (stream.readLineInto(&line)) {
+        ++lineNumber;
+
+        const QStringRef trimmed = QStringRef(&line).trimmed();
+        if (trimmed.isEmpty() || trimmed.startsWith(QLatin1Char('#'))) {
+            continue;
+        }
+
+        RouteEntry route;
+        QString error;
+        if (parseRoute(line, m_protocol, &route, &error)) {
+            imported << route;
+        } else if (errors) {
+            errors->append(i18n("Line %1: %2", lineNumber, error));
+        }
+    }
+
+    if (!imported.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_routes.size(), m_routes.size() + imported.size() - 1);
+        m_routes << imported;
+        // Analyzing everything at once is cheaper than route by route
+        m_analyzer->setRoutes(m_routes);
+        m_handles.resize(m_routes.size());
+        std::iota(m_handles.begin(), m_handles.end(), 0);
+        endInsertRows();
+        analysisChanged();
+    }
+
+    return imported.size();
+}
+
+void RouteModel::exportRoutes(QTextStream &stream) const
+{
+    for (const RouteEntry &route : m_routes) {
+        // Incomplete rows have nothing to export
+        if (route.hasAddress) {
+            stream << formatRoute(route, m_protocol) << QLatin1Char('\n');
+        }
+    }
+}
+
+bool RouteModel::parseRoute(const QString &line, QAbstractSocket::NetworkLayerProtocol protocol, RouteEntry *route, QString *error)
+{
+    auto fail = [error] (const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    const QString simplified = line.simplified();
+    const QVector<QStringRef> tokens = simplified.splitRef(QLatin1Char(' '), Qt::SkipEmptyParts);
+    int i = 0;
+    if (i < tokens.size() && tokens.at(i) == QLatin1String("unicast")) {
+        ++i;
+    }
+    if (i >= tokens.size()) {
+        return fail(i18n("Missing destination"));
+    }
+
+    // Destination, "default" or address with optional prefix length
+    const QStringRef destination = tokens.at(i++);
+    RouteEntry entry;
+    if (destination == QLatin1String("default")) {
+        entry.hasAddress = true;
+        entry.address = RouteEntry::toRaw(protocol == QAbstractSocket::IPv4Protocol ? QHostAddress(QHostAddress::AnyIPv4) : QHostAddress(QHostAddress::AnyIPv6));
+        entry.prefixLength = 0;
+    } else {
+        const int slash = destination.indexOf(QLatin1Char('/'));
+        QHostAddress address;
+        if (!address.setAddress(destination.left(slash).toString())) {
+            // Other route types than unicast start with their name
+            if (i < tokens.size() && destination.at(0).isLetter()) {
+                return fail(i18n("Routes of type \"%1\" are not supported", destination.toString()));
+            }
+            return fail(i18n("Invalid destination \"%1\"", destination.toString()));
+        }
+        if (address.protocol() != protocol) {
+            return fail(protocol == QAbstractSocket::IPv4Protocol ? i18n("\"%1\" is not an IPv4 route", destination.toString())
+                                                                  : i18n("\"%1\" is not an IPv6 route", destination.toString()));
+        }
+
+        entry.hasAddress = true;
+        entry.address = RouteEntry::toRaw(address);
+        entry.prefixLength = maxPrefixLength(protocol);
+        if (slash >= 0) {
+            bool ok;
+            entry.prefixLength = destination.mid(slash + 1).toInt(&ok);
+            if (!ok || entry.prefixLength < 0 || entry.prefixLength > maxPrefixLength(protocol)) {
+                return fail(i18n("Invalid prefix length in \"%1\"", destination.toString()));
+            }
+        }
+    }
+
+    while (i < tokens.size()) {
+        const QStringRef key = tokens.at(i++);
+        if (routeFlags.contains(key.toString())) {
+            continue;
+        }
+        if (i >= tokens.size()) {
+            return fail(i18n("Missing value for \"%1\"", key.toString()));
+        }
+
+        QStringRef value = tokens.at(i++);
+        if (key == QLatin1String("via")) {
+            // "via inet6 fe80::1"
+            if ((value == QLatin1String("inet") || value == QLatin1String("inet6")) && i < tokens.size()) {
+                value = tokens.at(i++);
+            }
+            QHostAddress nextHop;
+            if (!nextHop.setAddress(value.toString()) || nextHop.protocol() != protocol) {
+                return fail(i18n("Invalid gateway \"%1\"", value.toString()));
+            }
+            entry.hasNextHop = true;
+            entry.nextHop = RouteEntry::toRaw(nextHop);
+        } else if (key == QLatin1String("metric") || key == QLatin1String("preference") || key == QLatin1String("priority")) {
+            bool ok;
+            entry.metric = value.toUInt(&ok);
+            if (!ok) {
+                return fail(i18n("Invalid metric \"%1\"", value.toString()));
+            }
+        }
+        // Everything else (dev, proto, scope, src, table, ...) does not end up in the connection
+    }
+
+    *route = entry;
+    return true;
+}
+
+QString RouteModel::formatRoute(const RouteEntry &route, QAbstractSocket::NetworkLayerProtocol protocol)
+{
+    QString line;
+    if (route.prefixLength == 0 && isNullAddress(route.address)) {
+        line = QStringLiteral("default");
+    } else {
+        line = route.addressValue(protocol).toString();
+        if (route.prefixLength >= 0) {
+            line += QLatin1Char('/') + QString::number(route.prefixLength);
+        }
+    }
+
+    if (route.hasNextHop) {
+        line += QLatin1String(" via ") + route.nextHopValue(protocol).toString();
+    }
+    if (route.metric) {
+        line += QLatin1String(" metric ") + QString::number(route.metric);
+    }
+
+    return line;
+}
+
+QString RouteModel::issuesText(int row) const
+{
+    const int handle = m_handles.at(row);
+    const RouteAnalyzer::Issues issues = m_analyzer->issues(handle);
+
+    QStringList messages;
+    if (issues & RouteAnalyzer::Duplicate) {
+        messages << i18n("Same destination and metric as the route in row %1", m_handles.indexOf(m_analyzer->duplicateOf(handle)) + 1);
+    }
+    if (issues & RouteAnalyzer::Shadowed) {
+        messages << i18n("Never used, more specific routes cover the whole destination");
+    }
+    if (issues & RouteAnalyzer::WithinAddressNetwork) {
+        messages << i18n("The destination is part of the network of an address of this connection");
+    }
+    if (issues & RouteAnalyzer::UnreachableNextHop) {
+        messages << i18n("The gateway is neither within the network of an address of this connection nor of a route without gateway");
+    }
+
+    return messages.join(QLatin1Char('\n'));
+}
+
+void RouteModel::analysisChanged()
+{
+    if (!m_routes.isEmpty()) {
+        Q_EMIT dataChanged(index(0, 0), index(m_routes.size() - 1, ColumnCount - 1), {Qt::DecorationRole, Qt::ToolTipRole});
+    }
+}
+
+QString RouteModel::prefixText(const RouteEntry &route) const
+{
+    if (route.prefixLength < 0) {
+        return QString();
+    }
+
+    if (m_protocol == QAbstractSocket::IPv4Protocol) {
+        return QHostAddress(route.prefixLength ? ~quint32(0) << (32 - route.prefixLength) : 0).toString();
+    }
+    return QString::number(route.prefixLength);
+}
+
+bool RouteModel::setPrefixText(RouteEntry &route, const QString &text) const
+{
+    if (text.isEmpty()) {
+        route.prefixLength = -1;
+        return true;
+    }
+
+    if (m_protocol == QAbstractSocket::IPv4Protocol) {
+        QHostAddress netmask;
+        if (!netmask.setAddress(text) || netmask.protocol() != QAbstractSocket::IPv4Protocol) {
+            return false;
+        }
+
+        // Only contiguous netmasks make a prefix
+        const quint32 hostBits = ~netmask.toIPv4Address();
+        if (hostBits & (hostBits + 1)) {
+            return false;
+        }
+        route.prefixLength = 32 - qPopulationCount(hostBits);
+        return true;
+    }
+
+    bool ok;
+    const int prefixLength = text.toInt(&ok);
+    if (!ok || prefixLength < 0 || prefixLength > 128) {
+        return false;
+    }
+    route.prefixLength = prefixLength;
+    return true;
+}
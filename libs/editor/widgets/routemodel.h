@@ -0,0 +1,130 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_ROUTE_MODEL_H
+#define PLASMA_NM_ROUTE_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QHostAddress>
+#include <QScopedPointer>
+#include <QVector>
+
+#include <NetworkManagerQt/IpAddress>
+#include <NetworkManagerQt/IpConfig>
+
+class QTextStream;
+class RouteAnalyzer;
+
+/**
+ * A static route as edited in the routes dialogs. Addresses are kept in their
+ * parsed form, IPv4 addresses in the last four bytes as IPv4-mapped addresses.
+ */
+struct RouteEntry
+{
+    Q_IPV6ADDR address;
+    Q_IPV6ADDR nextHop;
+    int prefixLength = -1;  // -1 while not set
+    quint32 metric = 0;
+    bool hasAddress = false;
+    bool hasNextHop = false;
+
+    RouteEntry();
+
+    QHostAddress addressValue(QAbstractSocket::NetworkLayerProtocol protocol) const;
+    QHostAddress nextHopValue(QAbstractSocket::NetworkLayerProtocol protocol) const;
+    static Q_IPV6ADDR toRaw(const QHostAddress &address);
+};
+
+Q_DECLARE_TYPEINFO(RouteEntry, Q_MOVABLE_TYPE);
+
+/**
+ * Table model of the static routes of one address family, backed by a vector
+ * of parsed routes. Cells are only converted to and from text when they are
+ * shown or edited, so large route tables load and save quickly.
+ *
+ * Routes can also be imported from and exported to the format printed by
+ * "ip route". Problems found by RouteAnalyzer are shown as warning icon and
+ * tooltip of the affected rows.
+ */
+class Q_DECL_EXPORT RouteModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column {
+        AddressColumn = 0,
+        PrefixColumn,       // netmask for IPv4, prefix length for IPv6
+        NextHopColumn,
+        MetricColumn,
+        ColumnCount
+    };
+
+    explicit RouteModel(QAbstractSocket::NetworkLayerProtocol protocol, QObject *parent = nullptr);
+    ~RouteModel() override;
+
+    QAbstractSocket::NetworkLayerProtocol protocol() const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool insertRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+    bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+
+    void setRoutes(const QList<NetworkManager::IpRoute> &routes);
+    QList<NetworkManager::IpRoute> routes() const;
+
+    const QVector<RouteEntry> &entries() const;
+
+    /**
+     * The addresses of the connection, gateways are checked against them.
+     */
+    void setAddresses(const QList<NetworkManager::IpAddress> &addresses);
+
+    /**
+     * Appends the routes read line by line from @p stream, which contains the
+     * output of "ip route" or "ip -6 route". Lines which cannot be used are
+     * skipped and described in @p errors.
+     *
+     * @return the number of imported routes
+     */
+    int importRoutes(QTextStream &stream, QStringList *errors = nullptr);
+    void exportRoutes(QTextStream &stream) const;
+
+    /**
+     * Parses a single line of "ip route" output.
+     */
+    static bool parseRoute(const QString &line, QAbstractSocket::NetworkLayerProtocol protocol, RouteEntry *route, QString *error = nullptr);
+    static QString formatRoute(const RouteEntry &route, QAbstractSocket::NetworkLayerProtocol protocol);
+
+private:
+    QString prefixText(const RouteEntry &route) const;
+    bool setPrefixText(RouteEntry &route, const QString &text) const;
+    QString issuesText(int row) const;
+    void analysisChanged();
+
+    QAbstractSocket::NetworkLayerProtocol m_protocol;
+    QVector<RouteEntry> m_routes;
+    QScopedPointer<RouteAnalyzer> m_analyzer;
+    QVector<int> m_handles; // analyzer handles of the rows
+};
+
+#endif // PLASMA_NM_ROUTE_MODEL_H
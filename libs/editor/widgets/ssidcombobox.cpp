@@ -23,7 +23,7 @@
 #include "uiutils.h"
 
 #include <NetworkManagerQt/Manager>
-#include <NetworkManagerQt/WirelessDevice>
+#include <NetworkManagerQt/Utils>
 
 #include <KLocalizedString>
 
@@ -32,6 +32,18 @@ bool signalCompare(const NetworkManager::WirelessNetwork::Ptr & one, const Netwo
     return one->signalStrength() > two->signalStrength();
 }
 
+bool SsidComboBox::SecurityKey::operator==(const SecurityKey &other) const
+{
+    return deviceCapabilities == other.deviceCapabilities && adhoc == other.adhoc && capabilities == other.capabilities &&
+           wpaFlags == other.wpaFlags && rsnFlags == other.rsnFlags;
+}
+
+uint qHash(const SsidComboBox::SecurityKey &key, uint seed)
+{
+    return qHash(qMakePair(qMakePair(uint(key.deviceCapabilities), uint(key.capabilities) | (key.adhoc ? 0x80000000 : 0)),
+                           qMakePair(uint(key.wpaFlags), uint(key.rsnFlags))), seed);
+}
+
 SsidComboBox::SsidComboBox(QWidget *parent) :
     KComboBox(parent)
 {
@@ -69,33 +81,28 @@ void SsidComboBox::init(const QString &ssid)
 
     // qCDebug(PLASMA_NM) << "Initial ssid:" << m_initialSsid;
 
-    QList<NetworkManager::WirelessNetwork::Ptr> networks;
-
     for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
         if (device->type() == NetworkManager::Device::Wifi) {
             NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
 
             for (const NetworkManager::WirelessNetwork::Ptr &newNetwork : wifiDevice->networks()) {
-                bool found = false;
-                for (const NetworkManager::WirelessNetwork::Ptr &existingNetwork : networks) {
-                    if (newNetwork->ssid() == existingNetwork->ssid()) {
-                        if (newNetwork->signalStrength() > existingNetwork->signalStrength()) {
-                            networks.removeOne(existingNetwork);
-                            break;
-                        } else {
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if (!found) {
-                    networks << newNetwork;
+                auto it = m_networks.find(newNetwork->ssid());
+                if (it == m_networks.end()) {
+                    m_networks.insert(newNetwork->ssid(), {newNetwork, wifiDevice});
+                } else if (newNetwork->signalStrength() > it->network->signalStrength()) {
+                    *it = {newNetwork, wifiDevice};
                 }
             }
+
+            connect(wifiDevice.data(), &NetworkManager::WirelessDevice::networkAppeared, this, &SsidComboBox::slotNetworkAppeared, Qt::UniqueConnection);
+            connect(wifiDevice.data(), &NetworkManager::WirelessDevice::networkDisappeared, this, &SsidComboBox::slotNetworkDisappeared, Qt::UniqueConnection);
         }
     }
 
-    std::sort(networks.begin(), networks.end(), signalCompare);
+    QList<Network> networks = m_networks.values();
+    std::sort(networks.begin(), networks.end(), [] (const Network &one, const Network &two) {
+        return signalCompare(one.network, two.network);
+    });
     addSsidsToCombo(networks);
 
     int index = findData(m_initialSsid);
@@ -108,41 +115,108 @@ void SsidComboBox::init(const QString &ssid)
     setEditText(m_initialSsid);
 }
 
-void SsidComboBox::addSsidsToCombo(const QList<NetworkManager::WirelessNetwork::Ptr> &networks)
+void SsidComboBox::slotNetworkAppeared(const QString &ssid)
 {
-    QList<NetworkManager::WirelessDevice::Ptr> wifiDevices;
+    Network network;
+    if (!findStrongestNetwork(ssid, network)) {
+        return;
+    }
 
-    for (const NetworkManager::Device::Ptr &dev : NetworkManager::networkInterfaces()) {
-        if (dev->type() == NetworkManager::Device::Wifi) {
-            wifiDevices << dev.objectCast<NetworkManager::WirelessDevice>();
-        }
+    const bool known = m_networks.contains(ssid);
+    m_networks.insert(ssid, network);
+    if (!known && findData(ssid) == -1) {
+        // Append so the entries the user is looking at do not move
+        addSsidToCombo(network);
     }
+}
 
-    bool empty = true;
+void SsidComboBox::slotNetworkDisappeared(const QString &ssid)
+{
+    Network network;
+    if (findStrongestNetwork(ssid, network)) {
+        // Still visible through another device
+        m_networks.insert(ssid, network);
+        return;
+    }
+
+    m_networks.remove(ssid);
 
-    for (const NetworkManager::WirelessNetwork::Ptr &network : networks) {
-        NetworkManager::AccessPoint::Ptr accessPoint = network->referenceAccessPoint();
+    const int index = findData(ssid);
+    if (index == -1 || index == currentIndex()) {
+        return;
+    }
 
-        if (!accessPoint) {
+    removeItem(index);
+    // Drop one of the separators around the entry
+    auto isSeparator = [this] (int index) {
+        return index >= 0 && index < count() && itemData(index, Qt::AccessibleDescriptionRole).toString() == QLatin1String("separator");
+    };
+    if (isSeparator(index - 1)) {
+        removeItem(index - 1);
+    } else if (isSeparator(index)) {
+        removeItem(index);
+    }
+}
+
+bool SsidComboBox::findStrongestNetwork(const QString &ssid, Network &result) const
+{
+    bool found = false;
+    for (const NetworkManager::Device::Ptr &device : NetworkManager::networkInterfaces()) {
+        if (device->type() != NetworkManager::Device::Wifi) {
             continue;
         }
 
-        for (const NetworkManager::WirelessDevice::Ptr &wifiDev : wifiDevices) {
-            if (wifiDev->findNetwork(network->ssid()) == network) {
-                if (!empty) {
-                    insertSeparator(count());
-                }
-                empty = false;
-
-                NetworkManager::WirelessSecurityType security = NetworkManager::findBestWirelessSecurity(wifiDev->wirelessCapabilities(), true, (wifiDev->mode() == NetworkManager::WirelessDevice::Adhoc), accessPoint->capabilities(), accessPoint->wpaFlags(), accessPoint->rsnFlags());
-                if (security != NetworkManager::UnknownSecurity && security != NetworkManager::NoneSecurity) {
-                    const QString text = i18n("%1 (%2%)\nSecurity: %3\nFrequency: %4 Mhz", accessPoint->ssid(), network->signalStrength(), UiUtils::labelFromWirelessSecurity(security), accessPoint->frequency());
-                    addItem(QIcon::fromTheme("object-locked"), text, accessPoint->ssid());
-                } else {
-                    const QString text = i18n("%1 (%2%)\nSecurity: Insecure\nFrequency: %3 Mhz", accessPoint->ssid(), network->signalStrength(), accessPoint->frequency());
-                    addItem(QIcon::fromTheme("object-unlocked"), text, accessPoint->ssid());
-                }
-            }
+        NetworkManager::WirelessDevice::Ptr wifiDevice = device.objectCast<NetworkManager::WirelessDevice>();
+        NetworkManager::WirelessNetwork::Ptr network = wifiDevice->findNetwork(ssid);
+        if (network && (!found || network->signalStrength() > result.network->signalStrength())) {
+            result = {network, wifiDevice};
+            found = true;
         }
     }
+
+    return found;
+}
+
+NetworkManager::WirelessSecurityType SsidComboBox::security(const NetworkManager::WirelessDevice::Ptr &device, const NetworkManager::AccessPoint::Ptr &accessPoint)
+{
+    const SecurityKey key = {device->wirelessCapabilities(), device->mode() == NetworkManager::WirelessDevice::Adhoc,
+                             accessPoint->capabilities(), accessPoint->wpaFlags(), accessPoint->rsnFlags()};
+
+    auto it = m_securityCache.constFind(key);
+    if (it != m_securityCache.constEnd()) {
+        return *it;
+    }
+
+    const NetworkManager::WirelessSecurityType security = NetworkManager::findBestWirelessSecurity(key.deviceCapabilities, true, key.adhoc, key.capabilities, key.wpaFlags, key.rsnFlags);
+    m_securityCache.insert(key, security);
+    return security;
+}
+
+void SsidComboBox::addSsidsToCombo(const QList<Network> &networks)
+{
+    for (const Network &network : networks) {
+        addSsidToCombo(network);
+    }
+}
+
+void SsidComboBox::addSsidToCombo(const Network &network)
+{
+    NetworkManager::AccessPoint::Ptr accessPoint = network.network->referenceAccessPoint();
+
+    if (!accessPoint) {
+        return;
+    }
+
+    if (count() && itemData(count() - 1, Qt::AccessibleDescriptionRole).toString() != QLatin1String("separator")) {
+        insertSeparator(count());
+    }
+
+    NetworkManager::WirelessSecurityType security = this->security(network.device, accessPoint);
+    if (security != NetworkManager::UnknownSecurity && security != NetworkManager::NoneSecurity) {
+        const QString text = i18n("%1 (%2%)\nSecurity: %3\nFrequency: %4 Mhz", accessPoint->ssid(), network.network->signalStrength(), UiUtils::labelFromWirelessSecurity(security), accessPoint->frequency());
+        addItem(QIcon::fromTheme("object-locked"), text, accessPoint->ssid());
+    } else {
+        const QString text = i18n("%1 (%2%)\nSecurity: Insecure\nFrequency: %3 Mhz", accessPoint->ssid(), network.network->signalStrength(), accessPoint->frequency());
+        addItem(QIcon::fromTheme("object-unlocked"), text, accessPoint->ssid());
+    }
 }
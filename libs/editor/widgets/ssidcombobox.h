@@ -24,6 +24,9 @@
 
 #include <KComboBox>
 
+#include <QHash>
+
+#include <NetworkManagerQt/WirelessDevice>
 #include <NetworkManagerQt/WirelessNetwork>
 
 class Q_DECL_EXPORT SsidComboBox : public KComboBox
@@ -42,10 +45,36 @@ Q_SIGNALS:
 private Q_SLOTS:
     void slotEditTextChanged(const QString &text);
     void slotCurrentIndexChanged(int);
+    void slotNetworkAppeared(const QString &ssid);
+    void slotNetworkDisappeared(const QString &ssid);
 
 private:
-    void addSsidsToCombo(const QList<NetworkManager::WirelessNetwork::Ptr> &networks);
+    // The strongest network seen for an SSID and the device it was seen on
+    struct Network {
+        NetworkManager::WirelessNetwork::Ptr network;
+        NetworkManager::WirelessDevice::Ptr device;
+    };
+
+    // Everything findBestWirelessSecurity() depends on
+    struct SecurityKey {
+        NetworkManager::WirelessDevice::Capabilities deviceCapabilities;
+        bool adhoc;
+        NetworkManager::AccessPoint::Capabilities capabilities;
+        NetworkManager::AccessPoint::WpaFlags wpaFlags;
+        NetworkManager::AccessPoint::WpaFlags rsnFlags;
+
+        bool operator==(const SecurityKey &other) const;
+    };
+    friend uint qHash(const SecurityKey &key, uint seed);
+
+    void addSsidsToCombo(const QList<Network> &networks);
+    void addSsidToCombo(const Network &network);
+    bool findStrongestNetwork(const QString &ssid, Network &result) const;
+    NetworkManager::WirelessSecurityType security(const NetworkManager::WirelessDevice::Ptr &device, const NetworkManager::AccessPoint::Ptr &accessPoint);
+
     QString m_initialSsid;
+    QHash<QString, Network> m_networks;
+    QHash<SecurityKey, NetworkManager::WirelessSecurityType> m_securityCache;
 };
 
 #endif // PLASMA_NM_SSIDCOMBOBOX_H
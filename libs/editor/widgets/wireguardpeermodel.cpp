@@ -0,0 +1,382 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "wireguardpeermodel.h"
+#include "simpleiplistvalidator.h"
+#include "wireguardkeyvalidator.h"
+
+#include <QTextStream>
+
+#include <KLocalizedString>
+
+#include <algorithm>
+
+// Tags used in a WireGuard .conf file
+#define PNM_WG_CONF_TAG_INTERFACE            "[Interface]"
+#define PNM_WG_CONF_TAG_PEER                 "[Peer]"
+#define PNM_WG_CONF_TAG_PUBLIC_KEY           "PublicKey"
+#define PNM_WG_CONF_TAG_PRESHARED_KEY        "PresharedKey"
+#define PNM_WG_CONF_TAG_ALLOWED_IPS          "AllowedIPs"
+#define PNM_WG_CONF_TAG_ENDPOINT             "Endpoint"
+#define PNM_WG_CONF_TAG_PERSISTENT_KEEPALIVE "PersistentKeepalive"
+
+// Keys for the NetworkManager configuration
+#define PNM_WG_PEER_KEY_ALLOWED_IPS          "allowed-ips"
+#define PNM_WG_PEER_KEY_ENDPOINT             "endpoint"
+#define PNM_WG_PEER_KEY_PERSISTENT_KEEPALIVE "persistent-keepalive"
+#define PNM_WG_PEER_KEY_PRESHARED_KEY        "preshared-key"
+#define PNM_WG_PEER_KEY_PUBLIC_KEY           "public-key"
+
+WireGuardPeerReader::WireGuardPeerReader(const std::function<void(const QVariantMap &)> &addPeer)
+    : m_addPeer(addPeer)
+    , m_keyValidator(new WireGuardKeyValidator)
+    , m_allowedIpsValidator(new SimpleIpListValidator(SimpleIpListValidator::WithCidr, SimpleIpListValidator::Both))
+{
+}
+
+WireGuardPeerReader::~WireGuardPeerReader()
+{
+}
+
+bool WireGuardPeerReader::readLine(QTextStream &stream, QString &key, QString &value)
+{
+    QString line;
+    while (stream.readLineInto(&line)) {
+        const int comment = line.indexOf(QLatin1Char('#'));
+        if (comment >= 0) {
+            line.truncate(comment);
+        }
+
+        // Keys end in '=' so only the first one separates the value
+        const int separator = line.indexOf(QLatin1Char('='));
+        if (separator < 0) {
+            const QString section = line.trimmed();
+            if (section == QLatin1String(PNM_WG_CONF_TAG_INTERFACE) || section == QLatin1String(PNM_WG_CONF_TAG_PEER)) {
+                key = section;
+                value.clear();
+                return true;
+            }
+            continue;
+        }
+
+        key = line.left(separator).trimmed();
+        value = line.mid(separator + 1).trimmed();
+        return true;
+    }
+
+    return false;
+}
+
+bool WireGuardPeerReader::startPeer()
+{
+    if (!finish()) {
+        return false;
+    }
+
+    m_inPeer = true;
+    return true;
+}
+
+void WireGuardPeerReader::readValue(const QString &key, const QString &value)
+{
+    if (!m_inPeer) {
+        return;
+    }
+
+    int pos = 0;
+    QString val = value;
+    if (key == QLatin1String(PNM_WG_CONF_TAG_PUBLIC_KEY)) {
+        if (QValidator::Acceptable == m_keyValidator->validate(val, pos)) {
+            m_peer.insert(PNM_WG_PEER_KEY_PUBLIC_KEY, val);
+            m_havePublicKey = true;
+        }
+    } else if (key == QLatin1String(PNM_WG_CONF_TAG_ALLOWED_IPS)) {
+        if (QValidator::Acceptable == m_allowedIpsValidator->validate(val, pos)) {
+            QStringList valList = val.split(QLatin1Char(','));
+            for (QString &str : valList) {
+                str = str.trimmed();
+            }
+            m_peer.insert(PNM_WG_PEER_KEY_ALLOWED_IPS, valList);
+            m_haveAllowedIps = true;
+        }
+    } else if (key == QLatin1String(PNM_WG_CONF_TAG_ENDPOINT)) {
+        if (!val.isEmpty()) {
+            m_peer.insert(PNM_WG_PEER_KEY_ENDPOINT, val);
+        }
+    } else if (key == QLatin1String(PNM_WG_CONF_TAG_PRESHARED_KEY)) {
+        if (QValidator::Acceptable == m_keyValidator->validate(val, pos)) {
+            m_peer.insert(PNM_WG_PEER_KEY_PRESHARED_KEY, val);
+        }
+    } else if (key == QLatin1String(PNM_WG_CONF_TAG_PERSISTENT_KEEPALIVE)) {
+        bool ok = false;
+        const uint interval = val.toUInt(&ok);
+        if (ok && interval > 0 && interval <= 65535) {
+            m_peer.insert(PNM_WG_PEER_KEY_PERSISTENT_KEEPALIVE, interval);
+        }
+    }
+}
+
+bool WireGuardPeerReader::finish()
+{
+    if (!m_inPeer) {
+        return true;
+    }
+
+    if (!m_havePublicKey || !m_haveAllowedIps) {
+        return false;
+    }
+
+    m_addPeer(m_peer);
+    m_peer.clear();
+    m_inPeer = false;
+    m_havePublicKey = false;
+    m_haveAllowedIps = false;
+    return true;
+}
+
+constexpr int WireGuardPeerModel::fetchBatchSize;
+
+WireGuardPeerModel::WireGuardPeerModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+WireGuardPeerModel::~WireGuardPeerModel()
+{
+}
+
+int WireGuardPeerModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_fetched;
+}
+
+int WireGuardPeerModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant WireGuardPeerModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_fetched) {
+        return QVariant();
+    }
+
+    const QVariantMap &peer = m_peers.at(index.row());
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case PublicKeyColumn:
+            return peer.value(PNM_WG_PEER_KEY_PUBLIC_KEY).toString();
+        case EndpointColumn:
+            return peer.value(PNM_WG_PEER_KEY_ENDPOINT).toString();
+        case AllowedIpsColumn:
+            return peer.value(PNM_WG_PEER_KEY_ALLOWED_IPS).toStringList().size();
+        case KeepaliveColumn:
+            return peer.value(PNM_WG_PEER_KEY_PERSISTENT_KEEPALIVE).toString();
+        }
+    } else if (role == Qt::ToolTipRole && index.column() == AllowedIpsColumn) {
+        return peer.value(PNM_WG_PEER_KEY_ALLOWED_IPS).toStringList().join(QLatin1Char('\n'));
+    }
+
+    return QVariant();
+}
+
+QVariant WireGuardPeerModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case PublicKeyColumn:
+        return i18nc("Header text for WireGuard peer public key", "Public Key");
+    case EndpointColumn:
+        return i18nc("Header text for WireGuard peer endpoint", "Endpoint");
+    case AllowedIpsColumn:
+        return i18nc("Header text for the number of WireGuard peer allowed IPs", "Allowed IPs");
+    case KeepaliveColumn:
+        return i18nc("Header text for WireGuard peer persistent keepalive", "Keepalive");
+    }
+
+    return QVariant();
+}
+
+bool WireGuardPeerModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_fetched < m_peers.size();
+}
+
+void WireGuardPeerModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    const int count = qMin(fetchBatchSize, m_peers.size() - m_fetched);
+    beginInsertRows(QModelIndex(), m_fetched, m_fetched + count - 1);
+    m_fetched += count;
+    endInsertRows();
+}
+
+void WireGuardPeerModel::setPeers(const NMVariantMapList &peers)
+{
+    beginResetModel();
+    m_peers = peers;
+    m_valid.fill(true, m_peers.size());
+    m_invalidCount = 0;
+    m_fetched = qMin(fetchBatchSize, m_peers.size());
+    endResetModel();
+}
+
+NMVariantMapList WireGuardPeerModel::peers() const
+{
+    return m_peers;
+}
+
+int WireGuardPeerModel::peerCount() const
+{
+    return m_peers.size();
+}
+
+QVariantMap WireGuardPeerModel::peer(int row) const
+{
+    return m_peers.value(row);
+}
+
+void WireGuardPeerModel::setPeer(int row, const QVariantMap &peer, bool valid)
+{
+    if (row < 0 || row >= m_peers.size()) {
+        return;
+    }
+
+    m_peers[row] = peer;
+    if (m_valid.at(row) != valid) {
+        m_valid[row] = valid;
+        m_invalidCount += valid ? -1 : 1;
+    }
+
+    if (row < m_fetched) {
+        Q_EMIT dataChanged(index(row, 0), index(row, ColumnCount - 1), {Qt::DisplayRole, Qt::ToolTipRole});
+    }
+}
+
+void WireGuardPeerModel::addPeers(const NMVariantMapList &peers, bool valid)
+{
+    if (peers.isEmpty()) {
+        return;
+    }
+
+    const bool allFetched = m_fetched == m_peers.size();
+    m_peers << peers;
+    m_valid.insert(m_valid.size(), peers.size(), valid);
+    if (!valid) {
+        m_invalidCount += peers.size();
+    }
+
+    // Show the first batch of the new peers right away when the end of the list is visible
+    if (allFetched) {
+        fetchMore(QModelIndex());
+    }
+}
+
+void WireGuardPeerModel::removePeers(QVector<int> rows)
+{
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // Remove contiguous ranges from the end so the remaining rows keep their numbers
+    int i = rows.size() - 1;
+    while (i >= 0) {
+        const int last = rows.at(i);
+        while (i > 0 && rows.at(i - 1) == rows.at(i) - 1) {
+            --i;
+        }
+        const int first = rows.at(i--);
+        if (first < 0 || last >= m_peers.size()) {
+            continue;
+        }
+
+        for (int row = first; row <= last; ++row) {
+            if (!m_valid.at(row)) {
+                --m_invalidCount;
+            }
+        }
+
+        // Peers which were not fetched yet are not rows of the model
+        const int fetchedLast = qMin(last, m_fetched - 1);
+        if (first <= fetchedLast) {
+            beginRemoveRows(QModelIndex(), first, fetchedLast);
+        }
+        m_peers.erase(m_peers.begin() + first, m_peers.begin() + last + 1);
+        m_valid.remove(first, last - first + 1);
+        if (first <= fetchedLast) {
+            m_fetched -= fetchedLast - first + 1;
+            endRemoveRows();
+        }
+    }
+}
+
+void WireGuardPeerModel::fetchRow(int row)
+{
+    while (row >= m_fetched && canFetchMore(QModelIndex())) {
+        fetchMore(QModelIndex());
+    }
+}
+
+bool WireGuardPeerModel::isValid() const
+{
+    return m_invalidCount == 0;
+}
+
+int WireGuardPeerModel::importPeers(QTextStream &stream, QString *error)
+{
+    const bool allFetched = m_fetched == m_peers.size();
+    int imported = 0;
+
+    // The peers are not rows before they are fetched, so they can be stored as they are read
+    WireGuardPeerReader reader([this, &imported] (const QVariantMap &peer) {
+        m_peers << peer;
+        m_valid << true;
+        ++imported;
+    });
+
+    QString key;
+    QString value;
+    bool complete = true;
+    while (complete && WireGuardPeerReader::readLine(stream, key, value)) {
+        if (key == QLatin1String(PNM_WG_CONF_TAG_PEER)) {
+            complete = reader.startPeer();
+        } else if (key == QLatin1String(PNM_WG_CONF_TAG_INTERFACE)) {
+            complete = reader.finish();
+        } else {
+            reader.readValue(key, value);
+        }
+    }
+    complete = complete && reader.finish();
+
+    // Show the first batch of the new peers right away when the end of the list is visible
+    if (allFetched) {
+        fetchMore(QModelIndex());
+    }
+
+    if (!complete && error) {
+        *error = i18n("Peer %1 lacks a valid public key or allowed IPs", imported + 1);
+    }
+    return imported;
+}
@@ -0,0 +1,155 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_WIREGUARD_PEER_MODEL_H
+#define PLASMA_NM_WIREGUARD_PEER_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QScopedPointer>
+#include <QVector>
+
+#include <NetworkManagerQt/GenericTypes>
+
+#include <functional>
+
+class QTextStream;
+class SimpleIpListValidator;
+class WireGuardKeyValidator;
+
+/**
+ * Reads the [Peer] sections of a wg-quick configuration. A peer is handed to
+ * the callback as soon as its section is complete, so a configuration never
+ * has to be held in memory as a whole.
+ */
+class Q_DECL_EXPORT WireGuardPeerReader
+{
+public:
+    explicit WireGuardPeerReader(const std::function<void(const QVariantMap &)> &addPeer);
+    ~WireGuardPeerReader();
+
+    /**
+     * Reads the next line of @p stream which is neither empty nor a comment and
+     * splits it at the first '='. Section headers and lines without '=' are
+     * returned with a null @p value.
+     *
+     * @return false at the end of the stream
+     */
+    static bool readLine(QTextStream &stream, QString &key, QString &value);
+
+    /**
+     * Starts a new [Peer] section, fails if the previous one lacks the public
+     * key or the allowed IPs.
+     */
+    bool startPeer();
+    void readValue(const QString &key, const QString &value);
+    /**
+     * Completes the current section, if any.
+     */
+    bool finish();
+
+private:
+    std::function<void(const QVariantMap &)> m_addPeer;
+    QScopedPointer<WireGuardKeyValidator> m_keyValidator;
+    QScopedPointer<SimpleIpListValidator> m_allowedIpsValidator;
+    QVariantMap m_peer;
+    bool m_inPeer = false;
+    bool m_havePublicKey = false;
+    bool m_haveAllowedIps = false;
+};
+
+/**
+ * Table model of the peers of a WireGuard connection.
+ *
+ * Rows are materialized in batches through fetchMore() as the view scrolls,
+ * and the cells are derived from the peer settings only when shown, so
+ * connections with thousands of peers open without delay.
+ */
+class Q_DECL_EXPORT WireGuardPeerModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column {
+        PublicKeyColumn = 0,
+        EndpointColumn,
+        AllowedIpsColumn,   // number of allowed IPs, the list as tooltip
+        KeepaliveColumn,
+        ColumnCount
+    };
+
+    static constexpr int fetchBatchSize = 256;
+
+    explicit WireGuardPeerModel(QObject *parent = nullptr);
+    ~WireGuardPeerModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    /**
+     * Peers loaded from a saved connection are considered valid.
+     */
+    void setPeers(const NMVariantMapList &peers);
+    NMVariantMapList peers() const;
+    /**
+     * The number of peers, including the rows which were not fetched yet.
+     */
+    int peerCount() const;
+
+    QVariantMap peer(int row) const;
+    void setPeer(int row, const QVariantMap &peer, bool valid);
+
+    /**
+     * Appends @p peers, they only become rows once everything before them was fetched.
+     */
+    void addPeers(const NMVariantMapList &peers, bool valid = true);
+    /**
+     * Removes the peers at @p rows, which may be in any order.
+     */
+    void removePeers(QVector<int> rows);
+    /**
+     * Fetches rows until @p row is one of them.
+     */
+    void fetchRow(int row);
+
+    /**
+     * Whether none of the peers is marked invalid.
+     */
+    bool isValid() const;
+
+    /**
+     * Appends the [Peer] sections read from the wg-quick configuration in
+     * @p stream, the [Interface] section is skipped. Reading stops at the first
+     * incomplete section, which is described in @p error.
+     *
+     * @return the number of imported peers
+     */
+    int importPeers(QTextStream &stream, QString *error = nullptr);
+
+private:
+    NMVariantMapList m_peers;
+    QVector<bool> m_valid;
+    int m_invalidCount = 0;
+    int m_fetched = 0;
+};
+
+#endif // PLASMA_NM_WIREGUARD_PEER_MODEL_H
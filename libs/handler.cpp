@@ -22,6 +22,7 @@
 #include "connectioneditordialog.h"
 #include "configuration.h"
 #include "uiutils.h"
+#include "vpnuipluginregistry.h"
 #include "debug.h"
 
 #include <NetworkManagerQt/Manager>
@@ -51,8 +52,6 @@
 #include <KLocalizedString>
 #include <KUser>
 #include <KProcess>
-#include <KService>
-#include <KServiceTypeTrader>
 #include <KWindowSystem>
 #include <KWallet>
 
@@ -110,9 +109,7 @@ void Handler::activateConnection(const QString& connection, const QString& devic
             bool pluginMissing = false;
 
             // Check missing plasma-nm VPN plugin
-            const KService::List services = KServiceTypeTrader::self()->query("PlasmaNetworkManagement/VpnUiPlugin",
-                                                                              QString::fromLatin1("[X-NetworkManager-Services]=='%1'").arg(vpnSetting->serviceType()));
-            pluginMissing = services.isEmpty();
+            pluginMissing = !VpnUiPluginRegistry::self()->contains(vpnSetting->serviceType());
 
             // Check missing NetworkManager VPN plugin
             if (!pluginMissing) {
@@ -25,6 +25,8 @@
 #include "uiutils.h"
 
 #if WITH_MODEMMANAGER_SUPPORT
+#include "modemsignalsampler.h"
+
 #include <ModemManagerQt/manager.h>
 #endif
 #include <NetworkManagerQt/Settings>
@@ -39,6 +41,11 @@ NetworkModel::NetworkModel(QObject *parent)
 
 NetworkModel::~NetworkModel()
 {
+#if WITH_MODEMMANAGER_SUPPORT
+    for (auto it = m_modemSignalRefreshRates.constBegin(); it != m_modemSignalRefreshRates.constEnd(); ++it) {
+        ModemSignalSampler::forModem(it.key())->unwatch(it.value());
+    }
+#endif
 }
 
 QVariant NetworkModel::data(const QModelIndex &index, int role) const
@@ -109,6 +116,14 @@ QVariant NetworkModel::data(const QModelIndex &index, int role) const
                 return item->rxBytes();
             case TxBytesRole:
                 return item->txBytes();
+            case RssiRole:
+                return item->rssi();
+            case RsrpRole:
+                return item->rsrp();
+            case RsrqRole:
+                return item->rsrq();
+            case SinrRole:
+                return item->sinr();
             default:
                 break;
         }
@@ -154,6 +169,10 @@ QHash<int, QByteArray> NetworkModel::roleNames() const
     roles[VpnType] = "VpnType";
     roles[RxBytesRole] = "RxBytes";
     roles[TxBytesRole] = "TxBytes";
+    roles[RssiRole] = "Rssi";
+    roles[RsrpRole] = "Rsrp";
+    roles[RsrqRole] = "Rsrq";
+    roles[SinrRole] = "Sinr";
 
     return roles;
 }
@@ -563,6 +582,41 @@ void NetworkModel::setDeviceStatisticsRefreshRateMs(const QString &devicePath, u
     }
 }
 
+void NetworkModel::setModemSignalRefreshRate(const QString &devicePath, uint refreshRate)
+{
+#if WITH_MODEMMANAGER_SUPPORT
+    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(devicePath);
+
+    if (!device || device->type() != NetworkManager::Device::Modem) {
+        return;
+    }
+
+    // The NetworkManager udi of a modem is its ModemManager object path
+    const QString modemPath = device->udi();
+    ModemSignalSampler *sampler = ModemSignalSampler::forModem(modemPath);
+
+    const uint previousRate = m_modemSignalRefreshRates.value(modemPath);
+    if (previousRate == refreshRate) {
+        return;
+    }
+
+    if (refreshRate) {
+        connect(sampler, &ModemSignalSampler::sampleAdded, this, &NetworkModel::modemSignalSampleAdded, Qt::UniqueConnection);
+        sampler->watch(refreshRate);
+        m_modemSignalRefreshRates.insert(modemPath, refreshRate);
+    } else {
+        m_modemSignalRefreshRates.remove(modemPath);
+    }
+
+    if (previousRate) {
+        sampler->unwatch(previousRate);
+    }
+#else
+    Q_UNUSED(devicePath);
+    Q_UNUSED(refreshRate);
+#endif
+}
+
 void NetworkModel::updateItem(NetworkModelItem*item)
 {
     const int row = m_list.indexOf(item);
@@ -941,6 +995,27 @@ void NetworkModel::gsmNetworkSignalQualityChanged(const ModemManager::SignalQual
     }
 }
 
+void NetworkModel::modemSignalSampleAdded()
+{
+    ModemSignalSampler *sampler = qobject_cast<ModemSignalSampler*>(sender());
+    if (!sampler) {
+        return;
+    }
+
+    const ModemSignalSample sample = sampler->lastSample();
+
+    for (const NetworkManager::Device::Ptr &dev : NetworkManager::networkInterfaces()) {
+        if (dev->type() != NetworkManager::Device::Modem || dev->udi() != sampler->modemPath()) {
+            continue;
+        }
+
+        for (NetworkModelItem *item : m_list.returnItems(NetworkItemsList::Device, dev->uni())) {
+            item->setModemSignalMetrics(sample.rssi, sample.rsrp, sample.rsrq, sample.sinr);
+            updateItem(item);
+        }
+    }
+}
+
 #endif
 
 void NetworkModel::ipConfigChanged()
@@ -69,7 +69,11 @@ public:
         VpnState,
         VpnType,
         RxBytesRole,
-        TxBytesRole
+        TxBytesRole,
+        RssiRole,
+        RsrpRole,
+        RsrqRole,
+        SinrRole
     };
     Q_ENUMS(ItemRole)
 
@@ -80,6 +84,10 @@ public:
 public Q_SLOTS:
     void onItemUpdated();
     void setDeviceStatisticsRefreshRateMs(const QString &devicePath, uint refreshRate);
+    /**
+     * Samples extended modem signal metrics every @p refreshRate seconds, 0 stops sampling
+     */
+    void setModemSignalRefreshRate(const QString &devicePath, uint refreshRate);
 
 private Q_SLOTS:
     void accessPointSignalStrengthChanged(int signal);
@@ -99,6 +107,7 @@ private Q_SLOTS:
     void gsmNetworkAccessTechnologiesChanged(QFlags<MMModemAccessTechnology> accessTechnologies);
     void gsmNetworkCurrentModesChanged();
     void gsmNetworkSignalQualityChanged(const ModemManager::SignalQualityPair &signalQuality);
+    void modemSignalSampleAdded();
 #endif
     void ipConfigChanged();
     void ipInterfaceChanged();
@@ -111,6 +120,9 @@ private Q_SLOTS:
     void initialize();
 private:
     NetworkItemsList m_list;
+#if WITH_MODEMMANAGER_SUPPORT
+    QHash<QString, uint> m_modemSignalRefreshRates;
+#endif
 
     void addActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection);
     void addAvailableConnection(const QString &connection, const NetworkManager::Device::Ptr &device);
@@ -502,6 +502,22 @@ void NetworkModelItem::setTxBytes(qulonglong bytes)
     }
 }
 
+void NetworkModelItem::setModemSignalMetrics(double rssi, double rsrp, double rsrq, double sinr)
+{
+    // NaN marks a metric the modem does not report
+    auto update = [this] (double &field, double value, int role) {
+        if (field != value && !(qIsNaN(field) && qIsNaN(value))) {
+            field = value;
+            m_changedRoles << role;
+        }
+    };
+
+    update(m_rssi, rssi, NetworkModel::RssiRole);
+    update(m_rsrp, rsrp, NetworkModel::RsrpRole);
+    update(m_rsrq, rsrq, NetworkModel::RsrqRole);
+    update(m_sinr, sinr, NetworkModel::SinrRole);
+}
+
 bool NetworkModelItem::operator==(const NetworkModelItem *item) const
 {
     if (!item->uuid().isEmpty() && !uuid().isEmpty()) {
@@ -613,6 +629,19 @@ void NetworkModelItem::updateDetails() const
                     m_details << i18n("Signal Quality") << QString("%1%").arg(modemNetwork->signalQuality().signal);
                     m_details << i18n("Access Technology") << UiUtils::convertAccessTechnologyToString(modemNetwork->accessTechnologies());
                 }
+
+                if (!qIsNaN(m_rsrp)) {
+                    m_details << i18n("RSRP") << i18nc("signal power in dBm", "%1 dBm", m_rsrp);
+                }
+                if (!qIsNaN(m_rsrq)) {
+                    m_details << i18n("RSRQ") << i18nc("signal quality in dB", "%1 dB", m_rsrq);
+                }
+                if (!qIsNaN(m_sinr)) {
+                    m_details << i18n("SINR") << i18nc("signal to noise ratio in dB", "%1 dB", m_sinr);
+                }
+                if (!qIsNaN(m_rssi)) {
+                    m_details << i18n("RSSI") << i18nc("signal power in dBm", "%1 dBm", m_rssi);
+                }
             }
         }
 #endif
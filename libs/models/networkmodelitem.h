@@ -115,6 +115,12 @@ public:
     qulonglong txBytes() const;
     void setTxBytes(qulonglong bytes);
 
+    double rssi() const { return m_rssi; }
+    double rsrp() const { return m_rsrp; }
+    double rsrq() const { return m_rsrq; }
+    double sinr() const { return m_sinr; }
+    void setModemSignalMetrics(double rssi, double rsrp, double rsrq, double sinr);
+
     bool operator==(const NetworkModelItem *item) const;
 
     QVector<int> changedRoles() const { return m_changedRoles; }
@@ -151,6 +157,10 @@ private:
     NetworkManager::VpnConnection::State m_vpnState;
     qulonglong m_rxBytes;
     qulonglong m_txBytes;
+    double m_rssi = qQNaN();
+    double m_rsrp = qQNaN();
+    double m_rsrq = qQNaN();
+    double m_sinr = qQNaN();
     QString m_icon;
     QVector<int> m_changedRoles;
 };
@@ -0,0 +1,250 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "modemsignalsampler.h"
+#include "debug.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDBusArgument>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QHash>
+#include <QPointer>
+
+#include <algorithm>
+#include <cmath>
+
+static const QString signalInterface = QStringLiteral("org.freedesktop.ModemManager1.Modem.Signal");
+static const QString propertiesInterface = QStringLiteral("org.freedesktop.DBus.Properties");
+
+// Technologies ordered by preference, the first one reporting a value wins
+static const QStringList signalTechnologies = {
+    QStringLiteral("Nr5g"),
+    QStringLiteral("Lte"),
+    QStringLiteral("Umts"),
+    QStringLiteral("Evdo"),
+    QStringLiteral("Cdma"),
+    QStringLiteral("Gsm")
+};
+
+QVariantMap ModemSignalSample::toVariantMap() const
+{
+    return QVariantMap {
+        {QStringLiteral("timestamp"), timestamp},
+        {QStringLiteral("rssi"), rssi},
+        {QStringLiteral("rsrp"), rsrp},
+        {QStringLiteral("rsrq"), rsrq},
+        {QStringLiteral("sinr"), sinr}
+    };
+}
+
+ModemSignalSampler::ModemSignalSampler(const QString &modemPath, const QDBusConnection &connection, const QString &service, QObject *parent)
+    : QObject(parent)
+    , m_connection(connection)
+    , m_service(service)
+    , m_modemPath(modemPath)
+{
+    qRegisterMetaType<ModemSignalSample>();
+
+    m_history.resize(historySize);
+
+    m_connection.connect(m_service, m_modemPath, propertiesInterface, QStringLiteral("PropertiesChanged"),
+                         this, SLOT(onPropertiesChanged(QString,QVariantMap,QStringList)));
+}
+
+ModemSignalSampler::~ModemSignalSampler()
+{
+    if (m_refreshRate) {
+        setup(0);
+    }
+}
+
+ModemSignalSampler *ModemSignalSampler::forModem(const QString &modemPath)
+{
+    static QHash<QString, QPointer<ModemSignalSampler>> samplers;
+
+    QPointer<ModemSignalSampler> &sampler = samplers[modemPath];
+    if (!sampler) {
+        sampler = new ModemSignalSampler(modemPath, QDBusConnection::systemBus(),
+                                         QStringLiteral("org.freedesktop.ModemManager1"),
+                                         QCoreApplication::instance());
+    }
+
+    return sampler;
+}
+
+QString ModemSignalSampler::modemPath() const
+{
+    return m_modemPath;
+}
+
+void ModemSignalSampler::watch(uint refreshRate)
+{
+    if (!refreshRate) {
+        return;
+    }
+
+    const bool wasWatching = isWatching();
+    m_requestedRates << refreshRate;
+
+    const uint rate = *std::min_element(m_requestedRates.constBegin(), m_requestedRates.constEnd());
+    if (rate != m_refreshRate) {
+        setup(rate);
+    }
+
+    if (!wasWatching) {
+        // Seed the history with what ModemManager already knows
+        requestProperties();
+    }
+}
+
+void ModemSignalSampler::unwatch(uint refreshRate)
+{
+    if (!m_requestedRates.removeOne(refreshRate)) {
+        return;
+    }
+
+    const uint rate = m_requestedRates.isEmpty() ? 0 : *std::min_element(m_requestedRates.constBegin(), m_requestedRates.constEnd());
+    if (rate != m_refreshRate) {
+        setup(rate);
+    }
+}
+
+bool ModemSignalSampler::isWatching() const
+{
+    return !m_requestedRates.isEmpty();
+}
+
+uint ModemSignalSampler::refreshRate() const
+{
+    return m_refreshRate;
+}
+
+bool ModemSignalSampler::hasSamples() const
+{
+    return m_count > 0;
+}
+
+ModemSignalSample ModemSignalSampler::lastSample() const
+{
+    if (!m_count) {
+        return ModemSignalSample();
+    }
+
+    return m_history.at((m_head + historySize - 1) % historySize);
+}
+
+QVector<ModemSignalSample> ModemSignalSampler::history() const
+{
+    QVector<ModemSignalSample> result;
+    result.reserve(m_count);
+
+    const int first = (m_head + historySize - m_count) % historySize;
+    for (int i = 0; i < m_count; ++i) {
+        result << m_history.at((first + i) % historySize);
+    }
+
+    return result;
+}
+
+void ModemSignalSampler::onPropertiesChanged(const QString &interface, const QVariantMap &changedProperties, const QStringList &invalidatedProperties)
+{
+    Q_UNUSED(invalidatedProperties);
+
+    if (interface != signalInterface || !isWatching()) {
+        return;
+    }
+
+    addSample(changedProperties);
+}
+
+void ModemSignalSampler::setup(uint refreshRate)
+{
+    m_refreshRate = refreshRate;
+
+    QDBusMessage message = QDBusMessage::createMethodCall(m_service, m_modemPath, signalInterface, QStringLiteral("Setup"));
+    message << refreshRate;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_connection.asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, refreshRate] (QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<> reply = *watcher;
+        if (reply.isError()) {
+            qCWarning(PLASMA_NM) << "Failed to set signal refresh rate" << refreshRate << "for" << m_modemPath << reply.error().message();
+        }
+        watcher->deleteLater();
+    });
+}
+
+void ModemSignalSampler::requestProperties()
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(m_service, m_modemPath, propertiesInterface, QStringLiteral("GetAll"));
+    message << signalInterface;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_connection.asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this] (QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<QVariantMap> reply = *watcher;
+        if (reply.isValid() && isWatching()) {
+            addSample(reply.value());
+        }
+        watcher->deleteLater();
+    });
+}
+
+void ModemSignalSampler::addSample(const QVariantMap &properties)
+{
+    ModemSignalSample sample;
+    bool valid = false;
+
+    for (const QString &technology : signalTechnologies) {
+        const QVariant value = properties.value(technology);
+        if (!value.isValid()) {
+            continue;
+        }
+
+        const QVariantMap values = value.userType() == qMetaTypeId<QDBusArgument>() ? qdbus_cast<QVariantMap>(value) : value.toMap();
+        auto assign = [&values, &valid] (double &field, const QString &key) {
+            if (std::isnan(field) && values.contains(key)) {
+                field = values.value(key).toDouble();
+                valid = true;
+            }
+        };
+
+        assign(sample.rssi, QStringLiteral("rssi"));
+        assign(sample.rsrp, QStringLiteral("rsrp"));
+        assign(sample.rsrq, QStringLiteral("rsrq"));
+        // LTE and 5G report the signal to noise ratio as "snr", EV-DO as "sinr"
+        assign(sample.sinr, QStringLiteral("snr"));
+        assign(sample.sinr, QStringLiteral("sinr"));
+    }
+
+    if (!valid) {
+        return;
+    }
+
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    m_history[m_head] = sample;
+    m_head = (m_head + 1) % historySize;
+    m_count = qMin(m_count + 1, historySize);
+
+    Q_EMIT sampleAdded(sample);
+}
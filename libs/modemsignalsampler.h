@@ -0,0 +1,114 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_MODEM_SIGNAL_SAMPLER_H
+#define PLASMA_NM_MODEM_SIGNAL_SAMPLER_H
+
+#include <QDBusConnection>
+#include <QObject>
+#include <QVariantMap>
+#include <QVector>
+
+#include <limits>
+
+struct ModemSignalSample
+{
+    qint64 timestamp = 0; // milliseconds since epoch
+    double rssi = std::numeric_limits<double>::quiet_NaN(); // dBm
+    double rsrp = std::numeric_limits<double>::quiet_NaN(); // dBm
+    double rsrq = std::numeric_limits<double>::quiet_NaN(); // dB
+    double sinr = std::numeric_limits<double>::quiet_NaN(); // dB
+
+    QVariantMap toVariantMap() const;
+};
+
+/**
+ * Samples the extended signal metrics (RSSI, RSRP, RSRQ, SINR) exposed by the
+ * ModemManager "Signal" interface of a single modem.
+ *
+ * ModemManager only polls the modem after Setup() was called with a non-zero rate,
+ * so sampling is reference counted: every watch() enables it with the lowest
+ * requested rate and the last unwatch() disables it again. The most recent
+ * samples are kept in a fixed size ring buffer.
+ */
+class Q_DECL_EXPORT ModemSignalSampler : public QObject
+{
+Q_OBJECT
+public:
+    static constexpr int historySize = 360;
+
+    explicit ModemSignalSampler(const QString &modemPath,
+                                const QDBusConnection &connection = QDBusConnection::systemBus(),
+                                const QString &service = QStringLiteral("org.freedesktop.ModemManager1"),
+                                QObject *parent = nullptr);
+    ~ModemSignalSampler() override;
+
+    /**
+     * Returns the process wide sampler for the given ModemManager object path.
+     */
+    static ModemSignalSampler *forModem(const QString &modemPath);
+
+    QString modemPath() const;
+
+    /**
+     * Starts sampling every @p refreshRate seconds. The effective rate is the
+     * lowest of all active watchers.
+     */
+    void watch(uint refreshRate);
+    /**
+     * Drops a watcher previously registered with the same @p refreshRate.
+     */
+    void unwatch(uint refreshRate);
+
+    bool isWatching() const;
+    uint refreshRate() const;
+
+    bool hasSamples() const;
+    ModemSignalSample lastSample() const;
+    /**
+     * Returns the buffered samples, oldest first.
+     */
+    QVector<ModemSignalSample> history() const;
+
+Q_SIGNALS:
+    void sampleAdded(const ModemSignalSample &sample);
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QString &interface, const QVariantMap &changedProperties, const QStringList &invalidatedProperties);
+
+private:
+    void setup(uint refreshRate);
+    void requestProperties();
+    void addSample(const QVariantMap &properties);
+
+    QDBusConnection m_connection;
+    QString m_service;
+    QString m_modemPath;
+    QList<uint> m_requestedRates;
+    uint m_refreshRate = 0;
+
+    QVector<ModemSignalSample> m_history;
+    int m_head = 0;
+    int m_count = 0;
+};
+
+Q_DECLARE_METATYPE(ModemSignalSample)
+
+#endif // PLASMA_NM_MODEM_SIGNAL_SAMPLER_H
@@ -18,6 +18,8 @@
  */
 
 #include "mobilebroadbandsettings.h"
+#include "modemsignalsampler.h"
+#include "mobileproviders.h"
 
 #include <KPluginFactory>
 #include <KLocalizedString>
@@ -42,12 +44,22 @@ MobileBroadbandSettings::MobileBroadbandSettings(QObject* parent, const QVariant
     about->addAuthor(i18n("Martin Kacej"), QString(), "m.kacej@atlas.sk");
     setAboutData(about);
     ModemManager::scanDevices();
-    this->getModemDevice();
     this->setupMobileNetwork();
+
+    const QString modemPath = this->getModemDevice();
+    if (!modemPath.isEmpty()) {
+        // Sample extended signal metrics only while the KCM is open
+        m_signalSampler = ModemSignalSampler::forModem(modemPath);
+        connect(m_signalSampler, &ModemSignalSampler::sampleAdded, this, &MobileBroadbandSettings::signalHistoryChanged);
+        m_signalSampler->watch(m_signalRefreshRate);
+    }
 }
 
 MobileBroadbandSettings::~MobileBroadbandSettings()
 {
+    if (m_signalSampler) {
+        m_signalSampler->unwatch(m_signalRefreshRate);
+    }
 }
 
 bool MobileBroadbandSettings::mobileDataActive()
@@ -101,9 +113,54 @@ void MobileBroadbandSettings::setupMobileNetwork()
     }
 }
 
+QVariantList MobileBroadbandSettings::signalHistory() const
+{
+    QVariantList history;
+    if (!m_signalSampler) {
+        return history;
+    }
+
+    for (const ModemSignalSample &sample : m_signalSampler->history()) {
+        history << sample.toVariantMap();
+    }
+    return history;
+}
+
+uint MobileBroadbandSettings::signalRefreshRate() const
+{
+    return m_signalRefreshRate;
+}
+
+void MobileBroadbandSettings::setSignalRefreshRate(uint refreshRate)
+{
+    if (!refreshRate || refreshRate == m_signalRefreshRate) {
+        return;
+    }
+
+    if (m_signalSampler) {
+        m_signalSampler->watch(refreshRate);
+        m_signalSampler->unwatch(m_signalRefreshRate);
+    }
+    m_signalRefreshRate = refreshRate;
+    emit signalRefreshRateChanged(m_signalRefreshRate);
+}
+
 QString MobileBroadbandSettings::getAPN()
 {
-    return "some.ap.placeholder.com";
+    // Suggest the default APN of the operator of the SIM card
+    const QString operatorCode = MobileProviders::operatorCode(ModemManager::findModemDevice(getModemDevice()));
+    if (operatorCode.isEmpty()) {
+        return QString();
+    }
+
+    MobileProviders providers;
+    QString country;
+    QString provider;
+    QString apn;
+    if (!providers.findOperator(operatorCode, &country, &provider, &apn)) {
+        return QString();
+    }
+    return apn;
 }
 
 #include "mobilebroadbandsettings.moc"
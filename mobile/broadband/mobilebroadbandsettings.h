@@ -22,10 +22,14 @@
 
 #include <KQuickAddons/ConfigModule>
 
+class ModemSignalSampler;
+
 class MobileBroadbandSettings : public KQuickAddons::ConfigModule
 {
     Q_OBJECT
     Q_PROPERTY(bool mobileDataActive READ mobileDataActive WRITE setMobileDataActive NOTIFY mobileDataActiveChanged)
+    Q_PROPERTY(QVariantList signalHistory READ signalHistory NOTIFY signalHistoryChanged)
+    Q_PROPERTY(uint signalRefreshRate READ signalRefreshRate WRITE setSignalRefreshRate NOTIFY signalRefreshRateChanged)
 
 public:
     MobileBroadbandSettings(QObject *parent, const QVariantList &args);
@@ -38,8 +42,21 @@ public:
     void setupMobileNetwork();
     Q_INVOKABLE QString getAPN();
 
+    /**
+     * Extended signal samples of the current modem, oldest first, as maps with
+     * "timestamp", "rssi", "rsrp", "rsrq" and "sinr" keys
+     */
+    QVariantList signalHistory() const;
+    Q_SIGNAL void signalHistoryChanged();
+
+    uint signalRefreshRate() const;
+    void setSignalRefreshRate(uint refreshRate);
+    Q_SIGNAL void signalRefreshRateChanged(uint refreshRate);
+
 private:
     bool m_mobileDataActive;
+    ModemSignalSampler *m_signalSampler = nullptr;
+    uint m_signalRefreshRate = 5;
 };
 
 #endif // MOBILEBROADBANDSETTINGS_H
@@ -78,5 +78,72 @@ Kirigami.Page {
         Controls.Button {
             text: i18n("Data usage")
         }
+        Kirigami.Separator {}
+        Column {
+            width: parent.width
+            visible: kcm.signalHistory.length > 0
+
+            property var lastSample: kcm.signalHistory.length > 0 ? kcm.signalHistory[kcm.signalHistory.length - 1] : null
+
+            function formatMetric(value, unit) {
+                return isNaN(value) ? i18nc("metric not reported by the modem", "n/a") : i18nc("value with unit", "%1 %2", value.toFixed(1), unit)
+            }
+
+            Controls.Label {
+                text: i18n("Signal")
+                font.weight: Font.Bold
+            }
+            Controls.Label {
+                text: parent.lastSample ? i18n("RSRP: %1   RSRQ: %2   SINR: %3   RSSI: %4",
+                                                parent.formatMetric(parent.lastSample.rsrp, "dBm"),
+                                                parent.formatMetric(parent.lastSample.rsrq, "dB"),
+                                                parent.formatMetric(parent.lastSample.sinr, "dB"),
+                                                parent.formatMetric(parent.lastSample.rssi, "dBm")) : ""
+            }
+            Canvas {
+                id: rsrpChart
+                width: parent.width
+                height: Kirigami.Units.gridUnit * 6
+
+                // RSRP typically ranges from -140 dBm (no signal) to -44 dBm (excellent)
+                readonly property real minimum: -140
+                readonly property real maximum: -44
+
+                onPaint: {
+                    var ctx = getContext("2d")
+                    ctx.reset()
+                    var history = kcm.signalHistory
+                    if (history.length < 2) {
+                        return
+                    }
+                    ctx.strokeStyle = Kirigami.Theme.highlightColor
+                    ctx.lineWidth = 2
+                    ctx.beginPath()
+                    var started = false
+                    for (var i = 0; i < history.length; ++i) {
+                        var value = history[i].rsrp
+                        if (isNaN(value)) {
+                            continue
+                        }
+                        var x = i * width / (history.length - 1)
+                        var y = height - (Math.min(Math.max(value, minimum), maximum) - minimum) * height / (maximum - minimum)
+                        if (started) {
+                            ctx.lineTo(x, y)
+                        } else {
+                            ctx.moveTo(x, y)
+                            started = true
+                        }
+                    }
+                    ctx.stroke()
+                }
+
+                Connections {
+                    target: kcm
+                    function onSignalHistoryChanged() {
+                        rsrpChart.requestPaint()
+                    }
+                }
+            }
+        }
     }
 }
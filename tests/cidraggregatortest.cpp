@@ -0,0 +1,188 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cidraggregator.h"
+
+#include <QHostAddress>
+#include <QTest>
+
+class CidrAggregatorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void aggregateTest();
+    void aggregateTest_data();
+    void invalidTest();
+    void parityTest();
+    void benchmark();
+    void benchmark_data();
+};
+
+static quint32 nextRandom(quint32 &seed)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+void CidrAggregatorTest::aggregateTest_data()
+{
+    QTest::addColumn<QStringList>("prefixes");
+    QTest::addColumn<QStringList>("aggregated");
+
+    QTest::newRow("empty") << QStringList() << QStringList();
+    QTest::newRow("duplicates") << QStringList({"10.0.0.0/24", "10.0.0.0/24"}) << QStringList({"10.0.0.0/24"});
+    QTest::newRow("host bits") << QStringList({"10.0.0.1/24"}) << QStringList({"10.0.0.0/24"});
+    QTest::newRow("host") << QStringList({"192.168.1.1"}) << QStringList({"192.168.1.1/32"});
+    QTest::newRow("covered") << QStringList({"10.0.0.0/8", "10.1.0.0/16"}) << QStringList({"10.0.0.0/8"});
+    QTest::newRow("covered first") << QStringList({"10.1.0.0/16", "10.0.0.0/8"}) << QStringList({"10.0.0.0/8"});
+    QTest::newRow("siblings") << QStringList({"10.0.0.128/25", "10.0.0.0/25"}) << QStringList({"10.0.0.0/24"});
+    QTest::newRow("cascade") << QStringList({"10.0.0.0/25", "10.0.0.128/26", "10.0.0.192/26"}) << QStringList({"10.0.0.0/24"});
+    QTest::newRow("not siblings") << QStringList({"10.0.0.128/25", "10.0.1.0/25"}) << QStringList({"10.0.0.128/25", "10.0.1.0/25"});
+    QTest::newRow("default") << QStringList({"0.0.0.0/1", "128.0.0.0/1"}) << QStringList({"0.0.0.0/0"});
+    QTest::newRow("ipv6") << QStringList({"2001:db8:8000::/33", "2001:db8::/33"}) << QStringList({"2001:db8::/32"});
+    QTest::newRow("ipv6 low half") << QStringList({"2001:db8::/65", "2001:db8:0:0:8000::/65"}) << QStringList({"2001:db8::/64"});
+    QTest::newRow("ipv6 host") << QStringList({"::1"}) << QStringList({"::1/128"});
+    QTest::newRow("mixed") << QStringList({"::/0", "10.0.0.0/9", " 10.0.0.0/8 "}) << QStringList({"10.0.0.0/8", "::/0"});
+}
+
+void CidrAggregatorTest::aggregateTest()
+{
+    QFETCH(QStringList, prefixes);
+    QFETCH(QStringList, aggregated);
+
+    QStringList invalid;
+    QCOMPARE(CidrAggregator::aggregate(prefixes, &invalid), aggregated);
+    QVERIFY(invalid.isEmpty());
+}
+
+void CidrAggregatorTest::invalidTest()
+{
+    const QStringList prefixes = {"10.0.0.0/33", "foo", "2001:db8::/129", "10.0.0.0/x", "10.0.0.0/8"};
+
+    CidrAggregator aggregator;
+    QStringList invalid;
+    aggregator.addPrefixes(prefixes, &invalid);
+
+    QCOMPARE(invalid, prefixes.mid(0, 4));
+    QCOMPARE(aggregator.inputCount(), 1);
+    QCOMPARE(aggregator.aggregate(), QStringList({"10.0.0.0/8"}));
+}
+
+// Merges until nothing changes, one pair at a time
+static QList<QPair<quint32, int>> naiveAggregate(QList<QPair<quint32, int>> prefixes)
+{
+    auto mask = [] (int length) {
+        return length ? ~quint32(0) << (32 - length) : 0;
+    };
+
+    for (auto &prefix : prefixes) {
+        prefix.first &= mask(prefix.second);
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < prefixes.size() && !changed; ++i) {
+            for (int j = 0; j < prefixes.size() && !changed; ++j) {
+                if (i == j) {
+                    continue;
+                }
+                const QPair<quint32, int> a = prefixes.at(i);
+                const QPair<quint32, int> b = prefixes.at(j);
+                if (b.second >= a.second && (b.first & mask(a.second)) == a.first) {
+                    // b is a duplicate of or within a
+                    prefixes.removeAt(j);
+                    changed = true;
+                } else if (a.second == b.second && a.second > 0 && (a.first & mask(a.second - 1)) == (b.first & mask(a.second - 1))) {
+                    prefixes[i] = qMakePair(a.first & mask(a.second - 1), a.second - 1);
+                    prefixes.removeAt(j);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    std::sort(prefixes.begin(), prefixes.end());
+    return prefixes;
+}
+
+void CidrAggregatorTest::parityTest()
+{
+    quint32 seed = 1;
+    for (int round = 0; round < 200; ++round) {
+        QList<QPair<quint32, int>> prefixes;
+        QStringList input;
+        const int count = nextRandom(seed) % 40;
+        for (int i = 0; i < count; ++i) {
+            // Crowd the prefixes into a /22 so that many of them touch
+            const quint32 address = 0x0a000000 | (nextRandom(seed) & 0x3ff);
+            const int length = 22 + nextRandom(seed) % 11;
+            prefixes << qMakePair(address, length);
+            input << QHostAddress(address).toString() + QLatin1Char('/') + QString::number(length);
+        }
+
+        QStringList expected;
+        for (const auto &prefix : naiveAggregate(prefixes)) {
+            expected << QHostAddress(prefix.first).toString() + QLatin1Char('/') + QString::number(prefix.second);
+        }
+
+        QCOMPARE(CidrAggregator::aggregate(input), expected);
+    }
+}
+
+void CidrAggregatorTest::benchmark_data()
+{
+    QTest::addColumn<QStringList>("prefixes");
+
+    const int count = 100000;
+    quint32 seed = 1;
+
+    QStringList ipv4;
+    QStringList adjacent;
+    QStringList ipv6;
+    for (int i = 0; i < count; ++i) {
+        ipv4 << QHostAddress(nextRandom(seed) << 8 | nextRandom(seed) % 256).toString() + QLatin1Char('/') + QString::number(16 + nextRandom(seed) % 17);
+        adjacent << QHostAddress(quint32(0x0a000000 + i)).toString() + QStringLiteral("/32");
+        ipv6 << QStringLiteral("2001:db8:%1:%2::/%3").arg(nextRandom(seed) % 0x10000, 0, 16).arg(nextRandom(seed) % 0x10000, 0, 16).arg(48 + nextRandom(seed) % 17);
+    }
+
+    QTest::newRow("ipv4 100k") << ipv4;
+    QTest::newRow("ipv4 adjacent 100k") << adjacent;
+    QTest::newRow("ipv6 100k") << ipv6;
+    QTest::newRow("mixed 200k") << ipv4 + ipv6;
+}
+
+void CidrAggregatorTest::benchmark()
+{
+    QFETCH(QStringList, prefixes);
+
+    QStringList aggregated;
+    QBENCHMARK {
+        aggregated = CidrAggregator::aggregate(prefixes);
+    }
+
+    QVERIFY(!aggregated.isEmpty());
+    QVERIFY(aggregated.size() <= prefixes.size());
+}
+
+QTEST_GUILESS_MAIN(CidrAggregatorTest)
+
+#include "cidraggregatortest.moc"
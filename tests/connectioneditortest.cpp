@@ -0,0 +1,269 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectioneditortabwidget.h"
+
+#include <QTabWidget>
+#include <QTest>
+
+#include <NetworkManagerQt/BondSetting>
+#include <NetworkManagerQt/Ipv4Setting>
+#include <NetworkManagerQt/Security8021xSetting>
+#include <NetworkManagerQt/VlanSetting>
+#include <NetworkManagerQt/WiredSetting>
+#include <NetworkManagerQt/WireGuardSetting>
+#include <NetworkManagerQt/WirelessSecuritySetting>
+#include <NetworkManagerQt/WirelessSetting>
+
+class ConnectionEditorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void unbuiltTabsTest();
+    void unbuiltTabsInvalidTest();
+    void unbuiltSecurity8021xTest();
+    void unbuiltMacAddressTest();
+    void unbuiltVlanTest();
+    void unbuiltBondTest();
+    void unbuiltWireGuardTest();
+    void openEditorBenchmark();
+    void openEditorBenchmark_data();
+};
+
+static NetworkManager::ConnectionSettings::Ptr createConnection(NetworkManager::ConnectionSettings::ConnectionType type, bool enterprise = false)
+{
+    NetworkManager::ConnectionSettings::Ptr connection(new NetworkManager::ConnectionSettings(type));
+    connection->setId(QStringLiteral("plasma-nm test"));
+    connection->setUuid(NetworkManager::ConnectionSettings::createNewUuid());
+
+    if (type == NetworkManager::ConnectionSettings::Wireless) {
+        NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->setting(NetworkManager::Setting::Wireless).staticCast<NetworkManager::WirelessSetting>();
+        wirelessSetting->setSsid("plasma-nm");
+        wirelessSetting->setInitialized(true);
+
+        NetworkManager::WirelessSecuritySetting::Ptr securitySetting = connection->setting(NetworkManager::Setting::WirelessSecurity).staticCast<NetworkManager::WirelessSecuritySetting>();
+        if (enterprise) {
+            securitySetting->setKeyMgmt(NetworkManager::WirelessSecuritySetting::WpaEap);
+
+            NetworkManager::Security8021xSetting::Ptr security8021xSetting = connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>();
+            security8021xSetting->setEapMethods({NetworkManager::Security8021xSetting::EapMethodPeap});
+            security8021xSetting->setPhase2AuthMethod(NetworkManager::Security8021xSetting::AuthMethodMschapv2);
+            security8021xSetting->setIdentity(QStringLiteral("user"));
+            security8021xSetting->setPasswordFlags(NetworkManager::Setting::NotSaved);
+            security8021xSetting->setInitialized(true);
+        } else {
+            securitySetting->setKeyMgmt(NetworkManager::WirelessSecuritySetting::WpaPsk);
+            securitySetting->setPsk(QStringLiteral("password"));
+        }
+        securitySetting->setInitialized(true);
+    }
+
+    return connection;
+}
+
+void ConnectionEditorTest::unbuiltTabsTest()
+{
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::Wireless, true);
+    const NMVariantMapMap stored = connection->toMap();
+    const QString security8021x = NetworkManager::Setting::typeAsString(NetworkManager::Setting::Security8021x);
+
+    ConnectionEditorTabWidget editor(connection);
+
+    // Nothing but the general tab was constructed, the stored settings stand in for the rest
+    NMVariantMapMap settings = editor.setting();
+    QVERIFY(editor.isValid());
+    QCOMPARE(settings.value(security8021x), stored.value(security8021x));
+
+    // Constructing every tab must not change the result
+    QTabWidget *tabWidget = editor.findChild<QTabWidget *>();
+    QVERIFY(tabWidget);
+    editor.show();
+    for (int i = 0; i < tabWidget->count(); ++i) {
+        tabWidget->setCurrentIndex(i);
+    }
+
+    settings = editor.setting();
+    QVERIFY(editor.isValid());
+    QCOMPARE(settings.value(security8021x).value(QLatin1String(NM_SETTING_802_1X_IDENTITY)), QVariant(QStringLiteral("user")));
+    QCOMPARE(settings.value(security8021x).value(QLatin1String(NM_SETTING_802_1X_EAP)), stored.value(security8021x).value(QLatin1String(NM_SETTING_802_1X_EAP)));
+}
+
+void ConnectionEditorTest::unbuiltTabsInvalidTest()
+{
+    // A new WPA-PSK connection without a key must not be saved before its security tab is shown
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::Wireless);
+    connection->setting(NetworkManager::Setting::WirelessSecurity).staticCast<NetworkManager::WirelessSecuritySetting>()->setPsk(QString());
+
+    ConnectionEditorTabWidget editor(connection);
+    QVERIFY(!editor.isValid());
+
+    // Neither may a manual IPv4 configuration without addresses
+    connection = createConnection(NetworkManager::ConnectionSettings::Wireless);
+    connection->setting(NetworkManager::Setting::Ipv4).staticCast<NetworkManager::Ipv4Setting>()->setMethod(NetworkManager::Ipv4Setting::Manual);
+
+    ConnectionEditorTabWidget ipv4Editor(connection);
+    QVERIFY(!ipv4Editor.isValid());
+
+    // Asking for the key on every connect needs none to be stored
+    connection = createConnection(NetworkManager::ConnectionSettings::Wireless);
+    NetworkManager::WirelessSecuritySetting::Ptr securitySetting = connection->setting(NetworkManager::Setting::WirelessSecurity).staticCast<NetworkManager::WirelessSecuritySetting>();
+    securitySetting->setPsk(QString());
+    securitySetting->setPskFlags(NetworkManager::Setting::NotSaved);
+
+    ConnectionEditorTabWidget askEditor(connection);
+    QVERIFY(askEditor.isValid());
+}
+
+void ConnectionEditorTest::unbuiltSecurity8021xTest()
+{
+    // WPA-EAP without an identity
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::Wireless, true);
+    NetworkManager::Security8021xSetting::Ptr security8021xSetting = connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>();
+    security8021xSetting->setIdentity(QString());
+
+    ConnectionEditorTabWidget wirelessEditor(connection);
+    QVERIFY(!wirelessEditor.isValid());
+
+    // Wired 802.1x with a stored password which is missing
+    connection = createConnection(NetworkManager::ConnectionSettings::Wired);
+    security8021xSetting = connection->setting(NetworkManager::Setting::Security8021x).staticCast<NetworkManager::Security8021xSetting>();
+    security8021xSetting->setEapMethods({NetworkManager::Security8021xSetting::EapMethodTtls});
+    security8021xSetting->setIdentity(QStringLiteral("user"));
+    security8021xSetting->setPasswordFlags(NetworkManager::Setting::AgentOwned);
+    security8021xSetting->setInitialized(true);
+
+    ConnectionEditorTabWidget wiredEditor(connection);
+    QVERIFY(!wiredEditor.isValid());
+
+    // Asking for the password is fine, as is a wired connection without 802.1x
+    security8021xSetting->setPasswordFlags(NetworkManager::Setting::NotSaved);
+    ConnectionEditorTabWidget askEditor(connection);
+    QVERIFY(askEditor.isValid());
+
+    ConnectionEditorTabWidget plainEditor(createConnection(NetworkManager::ConnectionSettings::Wired));
+    QVERIFY(plainEditor.isValid());
+}
+
+void ConnectionEditorTest::unbuiltMacAddressTest()
+{
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::Wired);
+    connection->setting(NetworkManager::Setting::Wired).staticCast<NetworkManager::WiredSetting>()->setClonedMacAddress(QByteArray::fromHex("0011"));
+
+    ConnectionEditorTabWidget wiredEditor(connection);
+    QVERIFY(!wiredEditor.isValid());
+
+    connection = createConnection(NetworkManager::ConnectionSettings::Wireless);
+    connection->setting(NetworkManager::Setting::Wireless).staticCast<NetworkManager::WirelessSetting>()->setBssid(QByteArray::fromHex("001122"));
+
+    ConnectionEditorTabWidget wirelessEditor(connection);
+    QVERIFY(!wirelessEditor.isValid());
+
+    connection = createConnection(NetworkManager::ConnectionSettings::Wireless);
+    connection->setting(NetworkManager::Setting::Wireless).staticCast<NetworkManager::WirelessSetting>()->setBssid(QByteArray::fromHex("001122334455"));
+
+    ConnectionEditorTabWidget validEditor(connection);
+    QVERIFY(validEditor.isValid());
+}
+
+void ConnectionEditorTest::unbuiltVlanTest()
+{
+    // Neither a parent nor an interface name
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::Vlan);
+
+    ConnectionEditorTabWidget editor(connection);
+    QVERIFY(!editor.isValid());
+
+    connection->setting(NetworkManager::Setting::Vlan).staticCast<NetworkManager::VlanSetting>()->setInterfaceName(QStringLiteral("vlan10"));
+
+    ConnectionEditorTabWidget namedEditor(connection);
+    QVERIFY(namedEditor.isValid());
+}
+
+void ConnectionEditorTest::unbuiltBondTest()
+{
+    // Without a running NetworkManager there are no slaves, so the bond is never valid,
+    // the ARP targets are checked before that though
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::Bond);
+    NetworkManager::BondSetting::Ptr bondSetting = connection->setting(NetworkManager::Setting::Bond).staticCast<NetworkManager::BondSetting>();
+    bondSetting->setInterfaceName(QStringLiteral("bond0"));
+    bondSetting->addOption(QStringLiteral(NM_SETTING_BOND_OPTION_ARP_IP_TARGET), QStringLiteral("192.168.1.1,gateway"));
+
+    ConnectionEditorTabWidget editor(connection);
+    QVERIFY(!editor.isValid());
+
+    // Constructing the tab gives the same result
+    QTabWidget *tabWidget = editor.findChild<QTabWidget *>();
+    QVERIFY(tabWidget);
+    editor.show();
+    for (int i = 0; i < tabWidget->count(); ++i) {
+        tabWidget->setCurrentIndex(i);
+    }
+    QVERIFY(!editor.isValid());
+}
+
+void ConnectionEditorTest::unbuiltWireGuardTest()
+{
+    // No private key
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(NetworkManager::ConnectionSettings::WireGuard);
+    NetworkManager::WireGuardSetting::Ptr wireGuardSetting = connection->setting(NetworkManager::Setting::WireGuard).staticCast<NetworkManager::WireGuardSetting>();
+
+    ConnectionEditorTabWidget editor(connection);
+    QVERIFY(!editor.isValid());
+
+    wireGuardSetting->setPrivateKey(QStringLiteral("yAnz5TF+lXXJte14tji3zlMNq+hd2rYUIgJBgB3fBmk="));
+    ConnectionEditorTabWidget keyEditor(connection);
+    QVERIFY(keyEditor.isValid());
+
+    // A port which does not fit into the listen port field
+    wireGuardSetting->setListenPort(70000);
+    ConnectionEditorTabWidget portEditor(connection);
+    QVERIFY(!portEditor.isValid());
+}
+
+void ConnectionEditorTest::openEditorBenchmark_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<bool>("enterprise");
+
+    QTest::newRow("wired") << int(NetworkManager::ConnectionSettings::Wired) << false;
+    QTest::newRow("wireless") << int(NetworkManager::ConnectionSettings::Wireless) << false;
+    QTest::newRow("wireless 802.1x") << int(NetworkManager::ConnectionSettings::Wireless) << true;
+    QTest::newRow("gsm") << int(NetworkManager::ConnectionSettings::Gsm) << false;
+    QTest::newRow("bond") << int(NetworkManager::ConnectionSettings::Bond) << false;
+    QTest::newRow("wireguard") << int(NetworkManager::ConnectionSettings::WireGuard) << false;
+}
+
+void ConnectionEditorTest::openEditorBenchmark()
+{
+    QFETCH(int, type);
+    QFETCH(bool, enterprise);
+
+    NetworkManager::ConnectionSettings::Ptr connection = createConnection(static_cast<NetworkManager::ConnectionSettings::ConnectionType>(type), enterprise);
+
+    QBENCHMARK {
+        ConnectionEditorTabWidget editor(connection);
+        editor.show();
+    }
+}
+
+QTEST_MAIN(ConnectionEditorTest)
+
+#include "connectioneditortest.moc"
@@ -0,0 +1,151 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "eventjournal.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUuid>
+
+#include <cstring>
+#include <limits>
+
+static const QString wlanUuid = QStringLiteral("{8f5f6a3c-8c7e-4b43-a3a9-7d3e0c1f2b11}");
+static const QString ethernetUuid = QStringLiteral("{0b0c5d1e-2f3a-4b5c-8d9e-0f1a2b3c4d5e}");
+
+class EventJournalTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void wrapAroundTest();
+    void reloadTest();
+    void filterTest();
+
+private:
+    static QVector<EventJournal::Record> allEvents(const EventJournal &journal, const QString &device = QString(), const QString &uuid = QString());
+
+    QTemporaryDir m_dir;
+};
+
+void EventJournalTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QVector<EventJournal::Record> EventJournalTest::allEvents(const EventJournal &journal, const QString &device, const QString &uuid)
+{
+    const QByteArray events = journal.events(0, std::numeric_limits<qint64>::max(), device, uuid);
+
+    QVector<EventJournal::Record> records(events.size() / int(sizeof(EventJournal::Record)));
+    memcpy(records.data(), events.constData(), records.size() * sizeof(EventJournal::Record));
+    return records;
+}
+
+void EventJournalTest::wrapAroundTest()
+{
+    EventJournal journal(m_dir.filePath(QStringLiteral("wrap")), 4);
+    for (uint i = 0; i < 6; ++i) {
+        journal.append(EventJournal::DeviceStateChanged, QStringLiteral("wlan0"), QString(), i);
+    }
+
+    // Only the newest events fit, oldest first
+    const QVector<EventJournal::Record> records = allEvents(journal);
+    QCOMPARE(records.size(), 4);
+    for (int i = 0; i < records.size(); ++i) {
+        QCOMPARE(records.at(i).newState, quint32(i + 2));
+    }
+}
+
+void EventJournalTest::reloadTest()
+{
+    const QString fileName = m_dir.filePath(QStringLiteral("reload"));
+    const qint64 future = QDateTime::currentMSecsSinceEpoch() + 3600 * 1000;
+
+    {
+        EventJournal journal(fileName, 8);
+        journal.append(EventJournal::ConnectivityChanged, QString(), QString(), 1);
+        journal.append(EventJournal::ConnectivityChanged, QString(), QString(), 2);
+        QCOMPARE(allEvents(journal).size(), 2);
+    }
+
+    // Pretend the clock was stepped back since the last event was recorded
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.seek(64 + sizeof(EventJournal::Record)));
+    QCOMPARE(file.write(reinterpret_cast<const char *>(&future), sizeof(future)), qint64(sizeof(future)));
+    file.close();
+
+    EventJournal journal(fileName, 8);
+    journal.append(EventJournal::ConnectivityChanged, QString(), QString(), 3);
+
+    // The event from the future is dropped instead of being stamped on the new ones
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const QVector<EventJournal::Record> records = allEvents(journal);
+    QCOMPARE(records.size(), 2);
+    QCOMPARE(records.at(0).newState, 1u);
+    QCOMPARE(records.at(1).newState, 3u);
+    QVERIFY(records.at(0).timestamp <= records.at(1).timestamp);
+    QVERIFY(records.at(1).timestamp <= now);
+
+    // So recent events are found by time
+    QCOMPARE(journal.events(now - 60 * 1000, now, QString(), QString()).size(), int(2 * sizeof(EventJournal::Record)));
+
+    // A different capacity starts a new journal
+    EventJournal resized(fileName, 16);
+    QVERIFY(allEvents(resized).isEmpty());
+}
+
+void EventJournalTest::filterTest()
+{
+    EventJournal journal(m_dir.filePath(QStringLiteral("filter")), 16);
+    journal.append(EventJournal::DeviceStateChanged, QStringLiteral("wlan0"), wlanUuid, 100);
+    journal.append(EventJournal::DeviceStateChanged, QStringLiteral("eth0"), ethernetUuid, 100);
+    journal.append(EventJournal::ConnectivityChanged, QString(), QString(), 4);
+    journal.append(EventJournal::DeviceStateChanged, QStringLiteral("wlan0"), wlanUuid, 30);
+
+    QCOMPARE(allEvents(journal).size(), 4);
+
+    QVector<EventJournal::Record> records = allEvents(journal, QStringLiteral("wlan0"));
+    QCOMPARE(records.size(), 2);
+    QCOMPARE(records.at(1).newState, 30u);
+
+    records = allEvents(journal, QString(), ethernetUuid);
+    QCOMPARE(records.size(), 1);
+    QCOMPARE(QByteArray(records.first().device), QByteArray("eth0"));
+
+    QVERIFY(allEvents(journal, QStringLiteral("eth0"), wlanUuid).isEmpty());
+
+    // An invalid UUID must not match the records without one
+    QVERIFY(allEvents(journal, QString(), QStringLiteral("not-a-uuid")).isEmpty());
+
+    // Time ranges
+    const qint64 first = allEvents(journal).first().timestamp;
+    QCOMPARE(journal.events(first, first - 1, QString(), QString()), QByteArray());
+    QVERIFY(journal.events(0, first - 1, QString(), QString()).isEmpty());
+    QCOMPARE(journal.events(first, std::numeric_limits<qint64>::max(), QString(), QString()).size(), int(4 * sizeof(EventJournal::Record)));
+}
+
+QTEST_GUILESS_MAIN(EventJournalTest)
+
+#include "eventjournaltest.moc"
@@ -0,0 +1,160 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "listvalidator.h"
+#include <QTest>
+
+// Accepts items of two to four letters and fixes them up to upper case
+// without dashes, so a fixed up item can get shorter than the typed one
+class CodeValidator : public QValidator
+{
+public:
+    State validate(QString &text, int &pos) const override
+    {
+        Q_UNUSED(pos);
+        ++calls;
+        text = text.toUpper().remove(QLatin1Char('-'));
+        for (const QChar &c : qAsConst(text)) {
+            if (!c.isLetter()) {
+                return Invalid;
+            }
+        }
+        if (text.size() < 2) {
+            return Intermediate;
+        }
+        return text.size() <= 4 ? Acceptable : Invalid;
+    }
+
+    mutable int calls = 0;
+};
+
+class ListValidatorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void editTest();
+    void editTest_data();
+    void sequenceTest();
+
+private:
+    void compareWithScratch(ListValidator &validator, QString &text);
+};
+
+Q_DECLARE_METATYPE(QValidator::State)
+
+void ListValidatorTest::compareWithScratch(ListValidator &validator, QString &text)
+{
+    CodeValidator inner;
+    ListValidator reference(nullptr);
+    reference.setInnerValidator(&inner);
+    QString referenceText = text;
+    int pos = 0;
+
+    QCOMPARE(validator.validate(text, pos), reference.validate(referenceText, pos));
+    QCOMPARE(text, referenceText);
+}
+
+void ListValidatorTest::editTest_data()
+{
+    QTest::addColumn<int>("position");
+    QTest::addColumn<int>("removed");
+    QTest::addColumn<QString>("inserted");
+    QTest::addColumn<QString>("result");
+    QTest::addColumn<QValidator::State>("state");
+    QTest::addColumn<int>("calls");
+
+    // Edits of "AB, CD, EF, GH", only the touched items are validated again
+    QTest::newRow("edit") << 4 << 2 << "x-yz" << "AB, XYZ, EF, GH" << QValidator::Acceptable << 1;
+    QTest::newRow("edit invalid") << 4 << 2 << "c1" << "AB, C1, EF, GH" << QValidator::Invalid << 1;
+    QTest::newRow("edit intermediate") << 4 << 2 << "c-" << "AB, C, EF, GH" << QValidator::Intermediate << 1;
+    QTest::newRow("insert") << 4 << 0 << "q-r, " << "AB, QR, CD, EF, GH" << QValidator::Acceptable << 2;
+    QTest::newRow("insert invalid") << 4 << 0 << "1, " << "AB, 1, CD, EF, GH" << QValidator::Invalid << 1;
+    QTest::newRow("remove") << 4 << 4 << "" << "AB, EF, GH" << QValidator::Acceptable << 1;
+    QTest::newRow("remove comma") << 6 << 2 << "" << "AB, CDEF, GH" << QValidator::Acceptable << 1;
+}
+
+void ListValidatorTest::editTest()
+{
+    QFETCH(int, position);
+    QFETCH(int, removed);
+    QFETCH(QString, inserted);
+    QFETCH(QString, result);
+    QFETCH(QValidator::State, state);
+    QFETCH(int, calls);
+
+    CodeValidator inner;
+    ListValidator validator(nullptr);
+    validator.setInnerValidator(&inner);
+    QString text = QStringLiteral("ab, cd, ef, gh");
+    int pos = 0;
+    QCOMPARE(validator.validate(text, pos), QValidator::Acceptable);
+    QCOMPARE(text, QStringLiteral("AB, CD, EF, GH"));
+
+    inner.calls = 0;
+    text.replace(position, removed, inserted);
+    compareWithScratch(validator, text);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+    QCOMPARE(text, result);
+    QCOMPARE(validator.validate(text, pos), state);
+    QCOMPARE(inner.calls, calls);
+}
+
+void ListValidatorTest::sequenceTest()
+{
+    // The items after a fixed up one are shifted in the cache, every later
+    // edit has to find them at their new place
+    struct Edit {
+        int position;
+        int removed;
+        const char *inserted;
+    };
+    const Edit edits[] = {
+        {4, 2, "x-yz"},   // AB, XYZ, EF, GH
+        {9, 0, "1, "},    // AB, XYZ, 1, EF, GH
+        {9, 1, "k-"},     // AB, XYZ, K, EF, GH
+        {4, 0, "m, "},    // AB, M, XYZ, K, EF, GH
+        {7, 5, ""},       // AB, M, K, EF, GH
+        {4, 1, "m-n"},    // AB, MN, K, EF, GH
+        {8, 1, "k-l-m"},  // AB, MN, KLM, EF, GH
+        {13, 4, ""},      // AB, MN, KLM, GH
+    };
+
+    CodeValidator inner;
+    ListValidator validator(nullptr);
+    validator.setInnerValidator(&inner);
+    QString text = QStringLiteral("ab, cd, ef, gh");
+    compareWithScratch(validator, text);
+
+    for (const Edit &edit : edits) {
+        text.replace(edit.position, edit.removed, QLatin1String(edit.inserted));
+        compareWithScratch(validator, text);
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+    QCOMPARE(text, QStringLiteral("AB, MN, KLM, GH"));
+}
+
+QTEST_GUILESS_MAIN(ListValidatorTest)
+
+#include "listvalidatortest.moc"
@@ -0,0 +1,586 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mobileproviders.h"
+#include "mobileprovidersindex.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QDomDocument>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <QTest>
+
+static const char providersXml[] =
+    "<?xml version=\"1.0\"?>\n"
+    "<serviceproviders format=\"2.0\">\n"
+    "  <country code=\"de\">\n"
+    "    <provider>\n"
+    "      <name>Telekom</name>\n"
+    "      <name xml:lang=\"de-DE\">Deutsche Telekom</name>\n"
+    "      <gsm>\n"
+    "        <network-id mcc=\"262\" mnc=\"01\"/>\n"
+    "        <network-id mcc=\"262\" mnc=\"06\"/>\n"
+    "        <apn value=\"internet.telekom\">\n"
+    "          <usage type=\"internet\"/>\n"
+    "          <name>Internet</name>\n"
+    "          <username>telekom</username>\n"
+    "          <password>tm</password>\n"
+    "          <dns>10.74.210.210</dns>\n"
+    "          <dns>10.74.210.211</dns>\n"
+    "        </apn>\n"
+    "        <apn value=\"mms.t-d1.de\">\n"
+    "          <usage type=\"mms\"/>\n"
+    "        </apn>\n"
+    "      </gsm>\n"
+    "    </provider>\n"
+    "    <provider>\n"
+    "      <name>Shared</name>\n"
+    "      <gsm>\n"
+    "        <network-id mcc=\"262\" mnc=\"06\"/>\n"
+    "        <apn value=\"web.shared\"/>\n"
+    "      </gsm>\n"
+    "    </provider>\n"
+    "  </country>\n"
+    "  <country code=\"us\">\n"
+    "    <provider>\n"
+    "      <name>Verizon</name>\n"
+    "      <cdma>\n"
+    "        <username>vz</username>\n"
+    "        <sid value=\"2\">2</sid>\n"
+    "        <sid value=\"4\">4</sid>\n"
+    "      </cdma>\n"
+    "    </provider>\n"
+    "  </country>\n"
+    "</serviceproviders>\n";
+
+class MobileProvidersIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void buildTest();
+    void networkIdTest();
+    void invalidTest();
+    void invalidTest_data();
+    void corruptTest();
+    void cacheTest();
+    void scopeTest();
+    void providersTest();
+    void findOperatorTest();
+    void findOperatorTest_data();
+    void benchmark();
+    void benchmark_data();
+
+private:
+    QString writeProviders(const QByteArray &xml);
+
+    QTemporaryDir m_dir;
+};
+
+static quint32 nextRandom(quint32 &seed)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// A database of the size of the real one, about 1.5 MB
+static QByteArray syntheticProviders()
+{
+    quint32 seed = 1;
+    QByteArray xml("<?xml version=\"1.0\"?>\n<serviceproviders format=\"2.0\">\n");
+    for (int country = 0; country < 250; ++country) {
+        const QByteArray code = QByteArray(1, 'a' + country / 26) + QByteArray(1, 'a' + country % 26);
+        xml += "  <country code=\"" + code + "\">\n";
+        for (int provider = 0; provider < 6; ++provider) {
+            xml += "    <provider>\n      <name>Provider " + QByteArray::number(nextRandom(seed)) + "</name>\n      <gsm>\n";
+            for (int network = 0; network < 3; ++network) {
+                xml += "        <network-id mcc=\"" + QByteArray::number(200 + country) + "\" mnc=\"" + QByteArray::number(nextRandom(seed) % 100) + "\"/>\n";
+            }
+            for (int apn = 0; apn < 3; ++apn) {
+                xml += "        <apn value=\"apn" + QByteArray::number(nextRandom(seed)) + ".example.com\">\n"
+                       "          <usage type=\"internet\"/>\n"
+                       "          <name>Plan " + QByteArray::number(apn) + "</name>\n"
+                       "          <username>user</username>\n"
+                       "          <password>secret</password>\n"
+                       "          <dns>10.0." + QByteArray::number(country) + ".1</dns>\n"
+                       "          <dns>10.0." + QByteArray::number(country) + ".2</dns>\n"
+                       "        </apn>\n";
+            }
+            xml += "      </gsm>\n    </provider>\n";
+        }
+        xml += "  </country>\n";
+    }
+    xml += "</serviceproviders>\n";
+    return xml;
+}
+
+// What MobileProviders did before the index: parse the whole database into a
+// DOM and walk it for the providers of a country and the APNs of one of them
+static int legacyOpenWizard(const QByteArray &xml, const QString &country)
+{
+    QDomDocument document;
+    if (!document.setContent(xml)) {
+        return 0;
+    }
+
+    int apns = 0;
+    for (QDomElement e = document.documentElement().firstChildElement(); !e.isNull(); e = e.nextSiblingElement()) {
+        if (e.attribute("code").toUpper() != country) {
+            continue;
+        }
+        QStringList names;
+        for (QDomElement provider = e.firstChildElement("provider"); !provider.isNull(); provider = provider.nextSiblingElement("provider")) {
+            names << provider.firstChildElement("name").text();
+        }
+        const QDomElement gsm = e.firstChildElement("provider").firstChildElement("gsm");
+        for (QDomElement apn = gsm.firstChildElement("apn"); !apn.isNull(); apn = apn.nextSiblingElement("apn")) {
+            apns += !apn.firstChildElement("username").text().isEmpty();
+        }
+        break;
+    }
+    return apns;
+}
+
+static int openWizard(const MobileProvidersIndex &index, const QString &country)
+{
+    const QStringList countries = index.countries();
+    const QVector<int> providers = index.providers(country);
+    if (countries.isEmpty() || providers.isEmpty()) {
+        return 0;
+    }
+
+    QStringList names;
+    for (int provider : providers) {
+        names << index.providerNames(provider).value("en");
+    }
+    int apns = 0;
+    for (int apn : index.apns(providers.first())) {
+        apns += !index.apnUsername(apn).isEmpty();
+    }
+    return apns;
+}
+
+// In kB, -1 when not available
+static qint64 processStatus(const QByteArray &key)
+{
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith(key + ':')) {
+            return line.mid(key.size() + 1).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return -1;
+}
+
+static bool resetPeakRss()
+{
+    QFile clearRefs(QStringLiteral("/proc/self/clear_refs"));
+    return clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("5") == 1;
+}
+
+enum WizardSource { Dom, Stream, StreamCountry, Cache };
+
+void MobileProvidersIndexTest::benchmark_data()
+{
+    QTest::addColumn<int>("source");
+
+    QTest::newRow("QDomDocument") << int(Dom);
+    QTest::newRow("stream") << int(Stream);
+    QTest::newRow("stream country") << int(StreamCountry);
+    QTest::newRow("cache") << int(Cache);
+}
+
+void MobileProvidersIndexTest::benchmark()
+{
+    QFETCH(int, source);
+
+    const QByteArray xml = syntheticProviders();
+    const QString country = QStringLiteral("EZ");
+
+    QBuffer buffer;
+    buffer.setData(xml);
+    QByteArray data;
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCOMPARE(MobileProvidersIndex::build(&buffer, &data), MobileProvidersIndex::Ok);
+    buffer.close();
+
+    QTemporaryFile cache;
+    QVERIFY(cache.open());
+    QCOMPARE(cache.write(data), qint64(data.size()));
+    cache.close();
+    data.clear();
+
+    auto run = [&] () {
+        switch (source) {
+        case Dom:
+            return legacyOpenWizard(xml, country);
+        case Stream:
+        case StreamCountry: {
+            QByteArray compiled;
+            buffer.open(QIODevice::ReadOnly);
+            MobileProvidersIndex::build(&buffer, &compiled, 0, 0, source == StreamCountry ? country : QString());
+            buffer.close();
+            MobileProvidersIndex index;
+            index.attach(reinterpret_cast<const uchar *>(compiled.constData()), compiled.size());
+            return openWizard(index, country);
+        }
+        case Cache: {
+            QFile file(cache.fileName());
+            file.open(QIODevice::ReadOnly);
+            MobileProvidersIndex index;
+            index.attach(file.map(0, file.size()), file.size());
+            return openWizard(index, country);
+        }
+        }
+        return 0;
+    };
+
+    // The memory a single run needs on top of what the test already uses
+    if (resetPeakRss()) {
+        const qint64 before = processStatus("VmRSS");
+        QCOMPARE(run(), 3);
+        qInfo() << QTest::currentDataTag() << "peak RSS:" << processStatus("VmHWM") - before << "kB";
+    } else {
+        QCOMPARE(run(), 3);
+    }
+
+    QBENCHMARK {
+        run();
+    }
+}
+
+void MobileProvidersIndexTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QFile::remove(MobileProvidersIndex::cacheFileName());
+    QVERIFY(m_dir.isValid());
+}
+
+QString MobileProvidersIndexTest::writeProviders(const QByteArray &xml)
+{
+    const QString fileName = m_dir.filePath(QStringLiteral("serviceproviders.xml"));
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(xml) != xml.size()) {
+        return QString();
+    }
+    return fileName;
+}
+
+void MobileProvidersIndexTest::buildTest()
+{
+    QBuffer source;
+    source.setData(providersXml);
+    source.open(QIODevice::ReadOnly);
+
+    QByteArray data;
+    QCOMPARE(MobileProvidersIndex::build(&source, &data), MobileProvidersIndex::Ok);
+
+    MobileProvidersIndex index;
+    QVERIFY(index.attach(reinterpret_cast<const uchar *>(data.constData()), data.size()));
+    QVERIFY(index.isValid());
+
+    QVERIFY(index.scope().isEmpty());
+    QCOMPARE(index.countries(), QStringList({"DE", "US"}));
+    QVERIFY(index.providers(QStringLiteral("FR")).isEmpty());
+    QVERIFY(index.providers(QStringLiteral("de")).isEmpty());
+
+    const QVector<int> german = index.providers(QStringLiteral("DE"));
+    QCOMPARE(german.size(), 2);
+    const int telekom = german.first();
+    QCOMPARE(index.providerNames(telekom), (QMap<QString, QString>{{"en", "Telekom"}, {"de", "Deutsche Telekom"}}));
+    QCOMPARE(index.providerFlags(telekom), int(MobileProvidersIndex::Gsm));
+    QCOMPARE(index.providerCountry(telekom), QStringLiteral("DE"));
+    QCOMPARE(index.networkIds(telekom), QStringList({"262-01", "262-06"}));
+
+    // The MMS APN is not meant for internet access
+    const QVector<int> apns = index.apns(telekom);
+    QCOMPARE(apns.size(), 1);
+    QCOMPARE(index.apnValue(apns.first()), QStringLiteral("internet.telekom"));
+    QCOMPARE(index.apnNames(apns.first()), (QMap<QString, QString>{{"en", "Internet"}}));
+    QCOMPARE(index.apnUsername(apns.first()), QStringLiteral("telekom"));
+    QCOMPARE(index.apnPassword(apns.first()), QStringLiteral("tm"));
+    QCOMPARE(index.apnDns(apns.first()), QStringList({"10.74.210.210", "10.74.210.211"}));
+
+    const QVector<int> american = index.providers(QStringLiteral("US"));
+    QCOMPARE(american.size(), 1);
+    QCOMPARE(index.providerFlags(american.first()), int(MobileProvidersIndex::Cdma));
+    QCOMPARE(index.cdmaUsername(american.first()), QStringLiteral("vz"));
+    QVERIFY(index.cdmaPassword(american.first()).isEmpty());
+    QCOMPARE(index.sids(american.first()), QStringList({"2", "4"}));
+    QVERIFY(index.apns(american.first()).isEmpty());
+
+    // Out of range positions are harmless
+    QVERIFY(index.providerNames(-1).isEmpty());
+    QVERIFY(index.apnValue(1000).isNull());
+}
+
+void MobileProvidersIndexTest::networkIdTest()
+{
+    QBuffer source;
+    source.setData(providersXml);
+    source.open(QIODevice::ReadOnly);
+
+    QByteArray data;
+    QCOMPARE(MobileProvidersIndex::build(&source, &data), MobileProvidersIndex::Ok);
+    MobileProvidersIndex index;
+    QVERIFY(index.attach(reinterpret_cast<const uchar *>(data.constData()), data.size()));
+
+    const QVector<int> german = index.providers(QStringLiteral("DE"));
+    QCOMPARE(index.providersForNetworkId(QStringLiteral("262-01")), QVector<int>({german.at(0)}));
+    QCOMPARE(index.providersForNetworkId(QStringLiteral("262-06")), german);
+    QVERIFY(index.providersForNetworkId(QStringLiteral("262-02")).isEmpty());
+    QVERIFY(index.providersForNetworkId(QStringLiteral("262")).isEmpty());
+}
+
+void MobileProvidersIndexTest::invalidTest_data()
+{
+    QTest::addColumn<QByteArray>("xml");
+    QTest::addColumn<int>("status");
+
+    QTest::newRow("not xml") << QByteArray("serviceproviders") << int(MobileProvidersIndex::SourceWrongFormat);
+    QTest::newRow("wrong root") << QByteArray("<providers format=\"2.0\"/>") << int(MobileProvidersIndex::SourceWrongFormat);
+    QTest::newRow("old format") << QByteArray("<serviceproviders format=\"1.0\"/>") << int(MobileProvidersIndex::SourceFormatNotSupported);
+    QTest::newRow("truncated") << QByteArray(providersXml).left(600) << int(MobileProvidersIndex::SourceWrongFormat);
+}
+
+void MobileProvidersIndexTest::invalidTest()
+{
+    QFETCH(QByteArray, xml);
+    QFETCH(int, status);
+
+    QBuffer source(&xml);
+    source.open(QIODevice::ReadOnly);
+
+    QByteArray data;
+    QCOMPARE(int(MobileProvidersIndex::build(&source, &data)), status);
+}
+
+void MobileProvidersIndexTest::corruptTest()
+{
+    QBuffer source;
+    source.setData(providersXml);
+    source.open(QIODevice::ReadOnly);
+
+    QByteArray data;
+    QCOMPARE(MobileProvidersIndex::build(&source, &data), MobileProvidersIndex::Ok);
+
+    MobileProvidersIndex index;
+    QVERIFY(!index.attach(reinterpret_cast<const uchar *>(data.constData()), 16));
+    QVERIFY(!index.isValid());
+    QVERIFY(index.providers(QStringLiteral("DE")).isEmpty());
+
+    // Truncated files must not be read past their end
+    QVERIFY(!index.attach(reinterpret_cast<const uchar *>(data.constData()), data.size() - 2));
+
+    QByteArray wrongMagic = data;
+    wrongMagic[0] = 'X';
+    QVERIFY(!index.attach(reinterpret_cast<const uchar *>(wrongMagic.constData()), wrongMagic.size()));
+}
+
+void MobileProvidersIndexTest::cacheTest()
+{
+    const QString fileName = writeProviders(providersXml);
+    QVERIFY(!fileName.isEmpty());
+
+    {
+        MobileProvidersIndex index;
+        QCOMPARE(index.open(fileName), MobileProvidersIndex::Ok);
+        QCOMPARE(index.providers(QStringLiteral("DE")).size(), 2);
+    }
+    QVERIFY(QFile::exists(MobileProvidersIndex::cacheFileName()));
+    const QDateTime built = QFileInfo(MobileProvidersIndex::cacheFileName()).lastModified();
+
+    // An unchanged database is not parsed again
+    {
+        MobileProvidersIndex index;
+        QCOMPARE(index.open(fileName), MobileProvidersIndex::Ok);
+        QCOMPARE(index.providers(QStringLiteral("DE")).size(), 2);
+    }
+    QCOMPARE(QFileInfo(MobileProvidersIndex::cacheFileName()).lastModified(), built);
+
+    // An updated database replaces the index
+    QByteArray updated(providersXml);
+    updated.replace("code=\"us\"", "code=\"ca\"");
+    QVERIFY(!writeProviders(updated).isEmpty());
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(built.addSecs(60), QFileDevice::FileModificationTime));
+    file.close();
+
+    MobileProvidersIndex index;
+    QCOMPARE(index.open(fileName), MobileProvidersIndex::Ok);
+    QVERIFY(index.providers(QStringLiteral("US")).isEmpty());
+    QCOMPARE(index.providers(QStringLiteral("CA")).size(), 1);
+
+    // Another database of the same size and modification time has its own index
+    const QString otherFileName = m_dir.filePath(QStringLiteral("other-serviceproviders.xml"));
+    QFile other(otherFileName);
+    QVERIFY(other.open(QIODevice::WriteOnly));
+    QCOMPARE(other.write(providersXml), qint64(qstrlen(providersXml)));
+    QVERIFY(other.flush());
+    QVERIFY(other.setFileTime(built.addSecs(60), QFileDevice::FileModificationTime));
+    other.close();
+    QCOMPARE(QFileInfo(otherFileName).size(), QFileInfo(fileName).size());
+    QCOMPARE(QFileInfo(otherFileName).lastModified(), QFileInfo(fileName).lastModified());
+
+    QCOMPARE(index.open(otherFileName), MobileProvidersIndex::Ok);
+    QCOMPARE(index.providers(QStringLiteral("US")).size(), 1);
+    QVERIFY(index.providers(QStringLiteral("CA")).isEmpty());
+
+    QCOMPARE(MobileProvidersIndex().open(m_dir.filePath(QStringLiteral("missing.xml"))), MobileProvidersIndex::SourceMissing);
+}
+
+void MobileProvidersIndexTest::scopeTest()
+{
+    const QString fileName = writeProviders(providersXml);
+    QVERIFY(!fileName.isEmpty());
+
+    // A file in place of the cache directory makes the cache unwritable
+    const QString cacheDir = QFileInfo(MobileProvidersIndex::cacheFileName()).absolutePath();
+    QVERIFY(QDir(cacheDir).removeRecursively());
+    QFile blocker(cacheDir);
+    QVERIFY(blocker.open(QIODevice::WriteOnly));
+    blocker.close();
+
+    MobileProvidersIndex index;
+    QCOMPARE(index.open(fileName, QStringLiteral("us")), MobileProvidersIndex::Ok);
+    QCOMPARE(index.scope(), QStringLiteral("US"));
+    QCOMPARE(index.countries(), QStringList({"DE", "US"}));
+    QCOMPARE(index.providers(QStringLiteral("US")).size(), 1);
+    QVERIFY(index.providers(QStringLiteral("DE")).isEmpty());
+    QVERIFY(index.providersForNetworkId(QStringLiteral("262-01")).isEmpty());
+
+    // MobileProviders starts with the country of the locale and follows the selection
+    const QLocale locale;
+    QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedStates));
+    MobileProviders providers(fileName);
+    QLocale::setDefault(locale);
+    QCOMPARE(providers.getError(), MobileProviders::Success);
+    QCOMPARE(providers.getCountryList().size(), 2);
+    QCOMPARE(providers.getProvidersList(QStringLiteral("DE"), NetworkManager::ConnectionSettings::Gsm).size(), 2);
+    QCOMPARE(providers.getApns(QStringLiteral("Shared")), QStringList({"web.shared"}));
+    QCOMPARE(providers.getApnInfo(QStringLiteral("web.shared")).value("apn").toString(), QStringLiteral("web.shared"));
+    QCOMPARE(providers.getProvidersList(QStringLiteral("US"), NetworkManager::ConnectionSettings::Cdma), QStringList({"Verizon"}));
+    QCOMPARE(providers.getCdmaInfo(QStringLiteral("Verizon")).value("username").toString(), QStringLiteral("vz"));
+
+    // Operators of other countries are found as well
+    QString country;
+    QString provider;
+    QString apn;
+    QVERIFY(providers.findOperator(QStringLiteral("26201"), &country, &provider, &apn));
+    QCOMPARE(country, QStringLiteral("DE"));
+    QCOMPARE(apn, QStringLiteral("internet.telekom"));
+
+    // That reopened the index for all countries, the providers listed before still resolve
+    QCOMPARE(providers.getCdmaInfo(QStringLiteral("Verizon")).value("username").toString(), QStringLiteral("vz"));
+    QCOMPARE(providers.getCdmaInfo(QStringLiteral("Verizon")).value("sidList").toStringList(), QStringList({"2", "4"}));
+
+    // As do the ones of the country of the SIM card
+    QCOMPARE(providers.getProvidersList(country, NetworkManager::ConnectionSettings::Gsm).size(), 2);
+    QCOMPARE(providers.getApns(provider).value(0), apn);
+
+    QVERIFY(QFile::remove(cacheDir));
+    QVERIFY(!QFile::exists(MobileProvidersIndex::cacheFileName()));
+}
+
+void MobileProvidersIndexTest::providersTest()
+{
+    const QString fileName = writeProviders(providersXml);
+    QVERIFY(!fileName.isEmpty());
+
+    MobileProviders providers(fileName);
+    QCOMPARE(providers.getError(), MobileProviders::Success);
+    QCOMPARE(providers.getCountryList().size(), 2);
+
+    QCOMPARE(providers.getProvidersList(QStringLiteral("DE"), NetworkManager::ConnectionSettings::Gsm).size(), 2);
+    QVERIFY(providers.getProvidersList(QStringLiteral("DE"), NetworkManager::ConnectionSettings::Cdma).isEmpty());
+
+    const QStringList gsm = providers.getProvidersList(QStringLiteral("DE"), NetworkManager::ConnectionSettings::Gsm);
+    const QString telekom = gsm.contains(QStringLiteral("Telekom")) ? QStringLiteral("Telekom") : QStringLiteral("Deutsche Telekom");
+    QVERIFY(gsm.contains(telekom));
+    QCOMPARE(providers.getApns(telekom), QStringList({"internet.telekom"}));
+    QCOMPARE(providers.getNetworkIds(telekom), QStringList({"262-01", "262-06"}));
+
+    const QVariantMap apn = providers.getApnInfo(QStringLiteral("internet.telekom"));
+    QCOMPARE(apn.value("apn").toString(), QStringLiteral("internet.telekom"));
+    QCOMPARE(apn.value("username").toString(), QStringLiteral("telekom"));
+    QCOMPARE(apn.value("password").toString(), QStringLiteral("tm"));
+    QCOMPARE(apn.value("number").toString(), providers.getGsmNumber());
+    QCOMPARE(apn.value("dnsList").toStringList(), QStringList({"10.74.210.210", "10.74.210.211"}));
+
+    QCOMPARE(providers.getProvidersList(QStringLiteral("US"), NetworkManager::ConnectionSettings::Cdma), QStringList({"Verizon"}));
+    const QVariantMap cdma = providers.getCdmaInfo(QStringLiteral("Verizon"));
+    QCOMPARE(cdma.value("username").toString(), QStringLiteral("vz"));
+    QVERIFY(!cdma.contains("password"));
+    QCOMPARE(cdma.value("sidList").toStringList(), QStringList({"2", "4"}));
+}
+
+void MobileProvidersIndexTest::findOperatorTest_data()
+{
+    QTest::addColumn<QString>("operatorCode");
+    QTest::addColumn<QString>("country");
+    QTest::addColumn<QString>("apn");
+
+    QTest::newRow("own network") << "26201" << "DE" << "internet.telekom";
+    QTest::newRow("shared network") << "26206" << "DE" << "internet.telekom";
+    QTest::newRow("unknown network") << "26202" << QString() << QString();
+    QTest::newRow("cdma") << "3104" << QString() << QString();
+    QTest::newRow("mcc only") << "262" << QString() << QString();
+    QTest::newRow("not a number") << "262-01" << QString() << QString();
+    QTest::newRow("empty") << QString() << QString() << QString();
+}
+
+void MobileProvidersIndexTest::findOperatorTest()
+{
+    QFETCH(QString, operatorCode);
+    QFETCH(QString, country);
+    QFETCH(QString, apn);
+
+    const QString fileName = writeProviders(providersXml);
+    QVERIFY(!fileName.isEmpty());
+    MobileProviders providers(fileName);
+
+    QString foundCountry;
+    QString foundProvider;
+    QString foundApn;
+    QCOMPARE(providers.findOperator(operatorCode, &foundCountry, &foundProvider, &foundApn), !country.isEmpty());
+    QCOMPARE(foundCountry, country);
+    QCOMPARE(foundApn, apn);
+
+    // The wizard selects the provider in the list of its country
+    if (!country.isEmpty()) {
+        QVERIFY(providers.getProvidersList(foundCountry, NetworkManager::ConnectionSettings::Gsm).contains(foundProvider));
+        QCOMPARE(providers.getApns(foundProvider).value(0), apn);
+    }
+}
+
+QTEST_GUILESS_MAIN(MobileProvidersIndexTest)
+
+#include "mobileprovidersindextest.moc"
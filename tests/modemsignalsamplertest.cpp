@@ -0,0 +1,187 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "modemsignalsampler.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QSignalSpy>
+#include <QTest>
+
+static const QString modemPath = QStringLiteral("/org/freedesktop/ModemManager1/Modem/0");
+
+// Minimal stand-in for the org.freedesktop.ModemManager1.Modem.Signal interface
+class FakeModemSignal : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.ModemManager1.Modem.Signal")
+    Q_PROPERTY(uint Rate READ rate)
+    Q_PROPERTY(QVariantMap Lte READ lte)
+
+public:
+    uint rate() const { return setupCalls.isEmpty() ? 0 : setupCalls.last(); }
+    QVariantMap lte() const { return m_lte; }
+
+    void setLte(const QVariantMap &lte, const QDBusConnection &connection)
+    {
+        m_lte = lte;
+
+        QDBusMessage message = QDBusMessage::createSignal(modemPath, QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("PropertiesChanged"));
+        message << QStringLiteral("org.freedesktop.ModemManager1.Modem.Signal")
+                << QVariantMap{{QStringLiteral("Lte"), m_lte}}
+                << QStringList();
+        connection.send(message);
+    }
+
+    QList<uint> setupCalls;
+
+public Q_SLOTS:
+    void Setup(uint rate) { setupCalls << rate; }
+
+private:
+    QVariantMap m_lte;
+};
+
+class ModemSignalSamplerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void watchTest();
+    void sampleTest();
+    void notWatchingTest();
+    void historyTest();
+
+private:
+    QDBusConnection m_fakeBus = QDBusConnection(QString());
+    FakeModemSignal *m_fake = nullptr;
+};
+
+void ModemSignalSamplerTest::initTestCase()
+{
+    if (!QDBusConnection::sessionBus().isConnected()) {
+        QSKIP("No session bus available");
+    }
+
+    m_fakeBus = QDBusConnection::connectToBus(QDBusConnection::SessionBus, QStringLiteral("fake-modemmanager"));
+    QVERIFY(m_fakeBus.isConnected());
+}
+
+void ModemSignalSamplerTest::init()
+{
+    m_fake = new FakeModemSignal;
+    QVERIFY(m_fakeBus.registerObject(modemPath, m_fake, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties));
+}
+
+void ModemSignalSamplerTest::cleanup()
+{
+    m_fakeBus.unregisterObject(modemPath);
+    delete m_fake;
+    m_fake = nullptr;
+}
+
+void ModemSignalSamplerTest::watchTest()
+{
+    ModemSignalSampler sampler(modemPath, QDBusConnection::sessionBus(), m_fakeBus.baseService());
+
+    QVERIFY(!sampler.isWatching());
+
+    sampler.watch(10);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({10}));
+
+    // The fastest watcher wins
+    sampler.watch(2);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({10, 2}));
+    sampler.watch(5);
+    QCOMPARE(sampler.refreshRate(), 2u);
+
+    sampler.unwatch(2);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({10, 2, 5}));
+    sampler.unwatch(5);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({10, 2, 5, 10}));
+
+    // The last watcher disables polling in ModemManager
+    sampler.unwatch(10);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({10, 2, 5, 10, 0}));
+    QVERIFY(!sampler.isWatching());
+}
+
+void ModemSignalSamplerTest::sampleTest()
+{
+    ModemSignalSampler sampler(modemPath, QDBusConnection::sessionBus(), m_fakeBus.baseService());
+    sampler.watch(1);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({1}));
+
+    m_fake->setLte({{QStringLiteral("rssi"), -65.0},
+                    {QStringLiteral("rsrp"), -95.0},
+                    {QStringLiteral("rsrq"), -11.0},
+                    {QStringLiteral("snr"), 12.5}},
+                   m_fakeBus);
+
+    QTRY_VERIFY(sampler.hasSamples() && sampler.lastSample().rsrp == -95.0);
+
+    const ModemSignalSample sample = sampler.lastSample();
+    QCOMPARE(sample.rssi, -65.0);
+    QCOMPARE(sample.rsrq, -11.0);
+    QCOMPARE(sample.sinr, 12.5);
+    QVERIFY(sample.timestamp > 0);
+}
+
+void ModemSignalSamplerTest::notWatchingTest()
+{
+    ModemSignalSampler sampler(modemPath, QDBusConnection::sessionBus(), m_fakeBus.baseService());
+    QSignalSpy spy(&sampler, &ModemSignalSampler::sampleAdded);
+
+    m_fake->setLte({{QStringLiteral("rsrp"), -100.0}}, m_fakeBus);
+
+    QVERIFY(!spy.wait(200));
+    QVERIFY(!sampler.hasSamples());
+    QVERIFY(m_fake->setupCalls.isEmpty());
+}
+
+void ModemSignalSamplerTest::historyTest()
+{
+    ModemSignalSampler sampler(modemPath, QDBusConnection::sessionBus(), m_fakeBus.baseService());
+    QSignalSpy spy(&sampler, &ModemSignalSampler::sampleAdded);
+    sampler.watch(1);
+    QTRY_COMPARE(m_fake->setupCalls, QList<uint>({1}));
+    spy.clear();
+
+    const int samples = ModemSignalSampler::historySize + 10;
+    for (int i = 0; i < samples; ++i) {
+        m_fake->setLte({{QStringLiteral("rsrp"), -140.0 + i}}, m_fakeBus);
+    }
+
+    QTRY_VERIFY(!spy.isEmpty() && spy.last().first().value<ModemSignalSample>().rsrp == -140.0 + samples - 1);
+
+    const QVector<ModemSignalSample> history = sampler.history();
+    QCOMPARE(history.size(), int(ModemSignalSampler::historySize));
+    QCOMPARE(history.last().rsrp, -140.0 + samples - 1);
+    for (int i = 1; i < history.size(); ++i) {
+        QVERIFY(history.at(i - 1).rsrp < history.at(i).rsrp);
+    }
+}
+
+QTEST_GUILESS_MAIN(ModemSignalSamplerTest)
+
+#include "modemsignalsamplertest.moc"
@@ -0,0 +1,203 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "openvpncapabilities.h"
+#include "openvpncipherbenchmark.h"
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+static const QByteArray cipherOutput =
+    "The following ciphers and cipher modes are available for use\n"
+    "with OpenVPN.  Each cipher shown below may be use as a\n"
+    "parameter to the --cipher option.\n"
+    "\n"
+    "AES-128-CBC  (128 bit key, 128 bit block)\n"
+    "AES-256-GCM  (256 bit key, 128 bit block, TLS client/server mode only)\n"
+    "CHACHA20-POLY1305  (256 bit key, stream cipher, TLS client/server mode only)\n";
+
+static const QByteArray digestOutput =
+    "The following message digests are available for use with\n"
+    "OpenVPN.\n"
+    "\n"
+    "MD5 128 bit digest size\n"
+    "SHA256 256 bit digest size\n";
+
+static const QByteArray versionOutput =
+    "OpenVPN 2.5.1 x86_64-pc-linux-gnu [SSL (OpenSSL)] [LZO] [LZ4] built on Feb 24 2021\n"
+    "library versions: OpenSSL 1.1.1k  25 Mar 2021, LZO 2.10\n";
+
+class OpenVpnCapabilitiesTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void parseTest();
+    void cacheTest();
+    void probeTest();
+    void missingBinaryTest();
+    void benchmarkRankTest();
+    void benchmarkCacheTest();
+    void benchmarkMeasureTest();
+
+private:
+    QString writeFile(const QString &name, const QByteArray &contents);
+
+    QTemporaryDir m_dir;
+};
+
+void OpenVpnCapabilitiesTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_dir.isValid());
+}
+
+QString OpenVpnCapabilitiesTest::writeFile(const QString &name, const QByteArray &contents)
+{
+    const QString fileName = m_dir.filePath(name);
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return QString();
+    }
+    file.write(contents);
+    return fileName;
+}
+
+void OpenVpnCapabilitiesTest::parseTest()
+{
+    QCOMPARE(OpenVpnCapabilities::parseList(cipherOutput),
+             QStringList({QStringLiteral("AES-128-CBC"), QStringLiteral("AES-256-GCM"), QStringLiteral("CHACHA20-POLY1305")}));
+    QCOMPARE(OpenVpnCapabilities::parseList(digestOutput), QStringList({QStringLiteral("MD5"), QStringLiteral("SHA256")}));
+    QCOMPARE(OpenVpnCapabilities::parseVersion(versionOutput), QStringLiteral("2.5.1"));
+    QVERIFY(OpenVpnCapabilities::parseVersion("Options error: unknown option\n").isEmpty());
+}
+
+void OpenVpnCapabilitiesTest::cacheTest()
+{
+    const QString binary = writeFile(QStringLiteral("cached-openvpn"), "binary");
+    QVERIFY(!OpenVpnCapabilities::cached(binary).valid);
+
+    OpenVpnCapabilities capabilities;
+    capabilities.binary = binary;
+    capabilities.ciphers = QStringList({QStringLiteral("AES-256-GCM")});
+    capabilities.digests = QStringList({QStringLiteral("SHA256")});
+    capabilities.version = QStringLiteral("2.5.1");
+    capabilities.valid = true;
+    capabilities.save();
+
+    const OpenVpnCapabilities cached = OpenVpnCapabilities::cached(binary);
+    QVERIFY(cached.valid);
+    QCOMPARE(cached.ciphers, capabilities.ciphers);
+    QCOMPARE(cached.digests, capabilities.digests);
+    QCOMPARE(cached.version, capabilities.version);
+
+    // An updated binary has to be probed again
+    QVERIFY(!writeFile(QStringLiteral("cached-openvpn"), "updated binary").isEmpty());
+    QVERIFY(!OpenVpnCapabilities::cached(binary).valid);
+}
+
+void OpenVpnCapabilitiesTest::probeTest()
+{
+    writeFile(QStringLiteral("ciphers"), cipherOutput);
+    writeFile(QStringLiteral("digests"), digestOutput);
+    writeFile(QStringLiteral("version"), versionOutput);
+
+    // Behaves like openvpn, including the exit code of --version
+    const QString binary = writeFile(QStringLiteral("openvpn"),
+        "#!/bin/sh\n"
+        "cd \"$(dirname \"$0\")\"\n"
+        "case \"$1\" in\n"
+        "    --show-ciphers) cat ciphers ;;\n"
+        "    --show-digests) cat digests ;;\n"
+        "    --version) cat version; exit 1 ;;\n"
+        "esac\n");
+    QVERIFY(QFile::setPermissions(binary, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner));
+
+    OpenVpnCapabilityProbe probe(binary);
+    QSignalSpy spy(&probe, &OpenVpnCapabilityProbe::finished);
+    probe.start();
+    QVERIFY(spy.wait());
+
+    const OpenVpnCapabilities capabilities = spy.first().first().value<OpenVpnCapabilities>();
+    QVERIFY(capabilities.valid);
+    QCOMPARE(capabilities.ciphers.size(), 3);
+    QCOMPARE(capabilities.digests, QStringList({QStringLiteral("MD5"), QStringLiteral("SHA256")}));
+    QCOMPARE(capabilities.version, QStringLiteral("2.5.1"));
+
+    QCOMPARE(OpenVpnCapabilities::cached(binary).ciphers, capabilities.ciphers);
+}
+
+void OpenVpnCapabilitiesTest::missingBinaryTest()
+{
+    for (const QString &binary : {QString(), m_dir.filePath(QStringLiteral("missing"))}) {
+        OpenVpnCapabilityProbe probe(binary);
+        QSignalSpy spy(&probe, &OpenVpnCapabilityProbe::finished);
+        probe.start();
+        // A binary that cannot be started may be reported right away
+        QTRY_COMPARE(spy.count(), 1);
+        QVERIFY(!spy.first().first().value<OpenVpnCapabilities>().valid);
+    }
+}
+
+void OpenVpnCapabilitiesTest::benchmarkRankTest()
+{
+    const QStringList ciphers = {QStringLiteral("AES-128-CBC"), QStringLiteral("AES-128-GCM"),
+                                 QStringLiteral("AES-256-CBC"), QStringLiteral("AES-256-GCM")};
+    const QMap<QString, double> throughput = {{QStringLiteral("AES-128-GCM"), 800.0},
+                                              {QStringLiteral("AES-256-GCM"), 1200.0}};
+
+    QCOMPARE(OpenVpnCipherBenchmark::rank(ciphers, throughput),
+             QStringList({QStringLiteral("AES-256-GCM"), QStringLiteral("AES-128-GCM"),
+                          QStringLiteral("AES-128-CBC"), QStringLiteral("AES-256-CBC")}));
+    QCOMPARE(OpenVpnCipherBenchmark::rank(ciphers, {}), ciphers);
+}
+
+void OpenVpnCapabilitiesTest::benchmarkCacheTest()
+{
+    QMap<QString, double> throughput;
+    OpenVpnCipherBenchmark::save({{QStringLiteral("AES-256-GCM"), 1234.5}});
+    QVERIFY(OpenVpnCipherBenchmark::cached(&throughput));
+    QCOMPARE(throughput.value(QStringLiteral("AES-256-GCM")), 1234.5);
+
+    // Having nothing to measure is remembered as well
+    OpenVpnCipherBenchmark::save({});
+    QVERIFY(OpenVpnCipherBenchmark::cached(&throughput));
+    QVERIFY(throughput.isEmpty());
+}
+
+void OpenVpnCapabilitiesTest::benchmarkMeasureTest()
+{
+    const QMap<QString, double> throughput = OpenVpnCipherBenchmark::measure();
+    if (throughput.isEmpty()) {
+        QSKIP("No QCA provider supports AES-GCM");
+    }
+
+    for (auto it = throughput.constBegin(); it != throughput.constEnd(); ++it) {
+        QVERIFY2(it.value() > 0, qPrintable(it.key()));
+    }
+}
+
+QTEST_GUILESS_MAIN(OpenVpnCapabilitiesTest)
+
+#include "openvpncapabilitiestest.moc"
@@ -0,0 +1,258 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "openvpncertificatestore.h"
+#include "openvpnconfigparser.h"
+#include "nm-openvpn-service.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+class OpenVpnConfigParserTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void optionsTest();
+    void diagnosticsTest();
+    void inlineTest();
+    void certificateStoreTest();
+    void invalidTest_data();
+    void invalidTest();
+
+private:
+    QString writeConfig(const QString &name, const QByteArray &contents);
+    static NMStringMap vpnData(const OpenVpnConfigParser &parser);
+
+    QTemporaryDir m_dir;
+};
+
+void OpenVpnConfigParserTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_dir.isValid());
+    QVERIFY(QDir(OpenVpnCertificateStore::directory()).removeRecursively());
+}
+
+QString OpenVpnConfigParserTest::writeConfig(const QString &name, const QByteArray &contents)
+{
+    const QString fileName = m_dir.filePath(name);
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return QString();
+    }
+    file.write(contents);
+    return fileName;
+}
+
+NMStringMap OpenVpnConfigParserTest::vpnData(const OpenVpnConfigParser &parser)
+{
+    return parser.connection().value(QStringLiteral("vpn")).value(QStringLiteral("data")).value<NMStringMap>();
+}
+
+void OpenVpnConfigParserTest::optionsTest()
+{
+    const QString fileName = writeConfig(QStringLiteral("office.ovpn"),
+        "# Office VPN\n"
+        "client\n"
+        "dev tap0\n"
+        "proto tcp-client\n"
+        "remote 'vpn.example.com' 1194\n"
+        "remote backup.example.com 443\n"
+        "ca ca.crt ; relative to the configuration\n"
+        "cert \"/etc/openvpn/my client.crt\"\n"
+        "key client.key\n"
+        "tls-auth ta.key 1\n"
+        "cipher AES-256-GCM\n"
+        "auth SHA256\n"
+        "compress lz4-v2\n"
+        "tun-mtu 1400\n"
+        "auth-user-pass\n"
+        "X-NM-Routes 10.0.0.0/8 192.168.1.0/24\n");
+    QVERIFY(!fileName.isEmpty());
+
+    OpenVpnConfigParser parser(fileName);
+    QVERIFY(parser.parse());
+    QVERIFY(parser.warnings().isEmpty());
+
+    const QVariantMap connection = parser.connection().value(QStringLiteral("connection"));
+    QCOMPARE(connection.value(QStringLiteral("id")).toString(), QStringLiteral("office"));
+
+    const NMStringMap data = vpnData(parser);
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_TAP_DEV)), QStringLiteral("yes"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_PROTO_TCP)), QStringLiteral("yes"));
+    // Only the first remote is used
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_REMOTE)), QStringLiteral("vpn.example.com"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_PORT)), QStringLiteral("1194"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_CA)), m_dir.filePath(QStringLiteral("ca.crt")));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_CERT)), QStringLiteral("/etc/openvpn/my client.crt"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_KEY)), m_dir.filePath(QStringLiteral("client.key")));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_TA)), m_dir.filePath(QStringLiteral("ta.key")));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_TA_DIR)), QStringLiteral("1"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_CIPHER)), QStringLiteral("AES-256-GCM"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_AUTH)), QStringLiteral("SHA256"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_COMPRESS)), QStringLiteral("lz4-v2"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_TUNNEL_MTU)), QStringLiteral("1400"));
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_CONNECTION_TYPE)), QStringLiteral(NM_OPENVPN_CONTYPE_PASSWORD_TLS));
+
+    const QVariantMap ipv4 = parser.connection().value(QStringLiteral("ipv4"));
+    QCOMPARE(ipv4.value(QStringLiteral("routes")).value<QList<QList<uint>>>().size(), 2);
+}
+
+void OpenVpnConfigParserTest::diagnosticsTest()
+{
+    const QString fileName = writeConfig(QStringLiteral("diagnostics.ovpn"),
+        "client\n"
+        "remote vpn.example.com\n"
+        "tun-mtu large\n"
+        "port 99999\n"
+        "cipher AES-128-CBC BF-CBC\n"
+        "nobind\n"
+        "dev ppp\n"
+        "key-direction 2\n");
+
+    OpenVpnConfigParser parser(fileName);
+    QVERIFY(parser.parse());
+
+    // Every problem is collected, none stops the import
+    const QVector<OpenVpnDiagnostic> diagnostics = parser.diagnostics();
+    QCOMPARE(diagnostics.size(), 6);
+
+    const QVector<int> lines = {3, 4, 5, 6, 7, 8};
+    for (int i = 0; i < diagnostics.size(); ++i) {
+        QCOMPARE(diagnostics.at(i).line, lines.at(i));
+        QCOMPARE(diagnostics.at(i).severity, i == 3 ? OpenVpnDiagnostic::Ignored : OpenVpnDiagnostic::Warning);
+    }
+    QCOMPARE(parser.warnings().size(), 5);
+
+    const NMStringMap data = vpnData(parser);
+    QVERIFY(!data.contains(QLatin1String(NM_OPENVPN_KEY_TUNNEL_MTU)));
+    QVERIFY(!data.contains(QLatin1String(NM_OPENVPN_KEY_PORT)));
+    QVERIFY(!data.contains(QLatin1String(NM_OPENVPN_KEY_CIPHER)));
+}
+
+void OpenVpnConfigParserTest::inlineTest()
+{
+    const QByteArray ca = "-----BEGIN CERTIFICATE-----\nMIIBszCCAVmgAwIBAgIU\n-----END CERTIFICATE-----\n";
+    const QByteArray tlsAuth = "-----BEGIN OpenVPN Static key V1-----\n0123456789abcdef\n-----END OpenVPN Static key V1-----\n";
+    const QString fileName = writeConfig(QStringLiteral("inline.ovpn"),
+        "client\n"
+        "remote vpn.example.com 1194 udp\n"
+        "<ca>\n" + ca + "</ca>\n"
+        "<tls-auth>\n" + tlsAuth + "</tls-auth>\n"
+        "key-direction 1\n");
+
+    OpenVpnConfigParser parser(fileName);
+    QVERIFY(parser.parse());
+    QVERIFY(parser.diagnostics().isEmpty());
+
+    const NMStringMap data = vpnData(parser);
+    const QString caPath = data.value(QLatin1String(NM_OPENVPN_KEY_CA));
+    const QString tlsAuthPath = data.value(QLatin1String(NM_OPENVPN_KEY_TA));
+    QCOMPARE(QFileInfo(caPath).absolutePath() + QLatin1Char('/'), OpenVpnCertificateStore::directory());
+    QCOMPARE(QFileInfo(tlsAuthPath).absolutePath() + QLatin1Char('/'), OpenVpnCertificateStore::directory());
+    // key-direction after the block still applies to it
+    QCOMPARE(data.value(QLatin1String(NM_OPENVPN_KEY_TA_DIR)), QStringLiteral("1"));
+
+    QFile caFile(caPath);
+    QVERIFY(caFile.open(QFile::ReadOnly));
+    QCOMPARE(caFile.readAll(), ca);
+
+    QFile tlsAuthFile(tlsAuthPath);
+    QVERIFY(tlsAuthFile.open(QFile::ReadOnly));
+    QCOMPARE(tlsAuthFile.readAll(), tlsAuth);
+
+    // Another profile of the same provider shares the CA file
+    OpenVpnConfigParser other(writeConfig(QStringLiteral("inline2.ovpn"),
+        "client\n"
+        "remote vpn2.example.com\n"
+        "<ca>\n" + ca + "</ca>\n"));
+    QVERIFY(other.parse());
+    QCOMPARE(vpnData(other).value(QLatin1String(NM_OPENVPN_KEY_CA)), caPath);
+}
+
+void OpenVpnConfigParserTest::certificateStoreTest()
+{
+    const QString unused = OpenVpnCertificateStore::add(QByteArray("unused"));
+    const QString used = OpenVpnCertificateStore::add(QByteArray("used"));
+    QVERIFY(!unused.isEmpty());
+    QVERIFY(!used.isEmpty());
+    QCOMPARE(OpenVpnCertificateStore::add(QByteArray("used")), used);
+
+    const QString copied = OpenVpnCertificateStore::addFile(writeConfig(QStringLiteral("used.crt"), "used"));
+    QCOMPARE(copied, used);
+    QVERIFY(OpenVpnCertificateStore::addFile(m_dir.filePath(QStringLiteral("missing.crt"))).isEmpty());
+
+    // Fresh entries survive, an import may still be about to reference them
+    QCOMPARE(OpenVpnCertificateStore::collectGarbage({used}), 0);
+
+    const QDateTime old = QDateTime::currentDateTime().addDays(-2);
+    for (const QString &path : {unused, used}) {
+        QFile file(path);
+        QVERIFY(file.open(QFile::ReadWrite));
+        QVERIFY(file.setFileTime(old, QFileDevice::FileModificationTime));
+    }
+
+    // Not knowing any connection must not wipe what they still reference
+    QCOMPARE(OpenVpnCertificateStore::collectGarbage({}), 0);
+    QVERIFY(QFile::exists(unused));
+    QVERIFY(QFile::exists(used));
+
+    // References are compared by their canonical path
+    const QString link = m_dir.filePath(QStringLiteral("used-link.crt"));
+    QVERIFY(QFile::link(used, link));
+    const QString uncleanPath = OpenVpnCertificateStore::directory() + QLatin1String("../sha256/") + QFileInfo(used).fileName();
+
+    QCOMPARE(OpenVpnCertificateStore::collectGarbage({link, uncleanPath}), 1);
+    QVERIFY(!QFile::exists(unused));
+    QVERIFY(QFile::exists(used));
+
+    QCOMPARE(OpenVpnCertificateStore::collectGarbage({used}), 0);
+    QVERIFY(QFile::exists(used));
+}
+
+void OpenVpnConfigParserTest::invalidTest_data()
+{
+    QTest::addColumn<QByteArray>("contents");
+
+    QTest::newRow("no client") << QByteArray("remote vpn.example.com\n");
+    QTest::newRow("no remote") << QByteArray("client\nca ca.crt\n");
+    QTest::newRow("unterminated block") << QByteArray("client\n<ca>\nremote vpn.example.com\n");
+}
+
+void OpenVpnConfigParserTest::invalidTest()
+{
+    QFETCH(QByteArray, contents);
+
+    OpenVpnConfigParser parser(writeConfig(QStringLiteral("invalid.ovpn"), contents));
+    QVERIFY(!parser.parse());
+    QVERIFY(!parser.errorString().isEmpty());
+    QVERIFY(parser.connection().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(OpenVpnConfigParserTest)
+
+#include "openvpnconfigparsertest.moc"
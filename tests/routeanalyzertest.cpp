@@ -0,0 +1,221 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "widgets/routeanalyzer.h"
+
+#include <QTest>
+
+static RouteEntry route(const QString &destination, const QString &nextHop = QString(), quint32 metric = 0)
+{
+    RouteEntry entry;
+    const QStringList parts = destination.split(QLatin1Char('/'));
+    entry.hasAddress = true;
+    entry.address = RouteEntry::toRaw(QHostAddress(parts.first()));
+    entry.prefixLength = parts.last().toInt();
+    if (!nextHop.isEmpty()) {
+        entry.hasNextHop = true;
+        entry.nextHop = RouteEntry::toRaw(QHostAddress(nextHop));
+    }
+    entry.metric = metric;
+    return entry;
+}
+
+static NetworkManager::IpAddress address(const QString &ip, int prefixLength)
+{
+    NetworkManager::IpAddress address;
+    address.setIp(QHostAddress(ip));
+    address.setPrefixLength(prefixLength);
+    return address;
+}
+
+class RouteAnalyzerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void duplicateTest();
+    void shadowTest();
+    void nextHopTest();
+    void ipv6Test();
+    void incrementalTest();
+    void benchmark();
+    void benchmark_data();
+};
+
+void RouteAnalyzerTest::duplicateTest()
+{
+    RouteAnalyzer analyzer(QAbstractSocket::IPv4Protocol);
+    analyzer.setRoutes({route(QStringLiteral("10.0.0.0/8"), QStringLiteral("192.168.1.1")),
+                        route(QStringLiteral("10.0.0.0/8"), QStringLiteral("192.168.1.2")),
+                        route(QStringLiteral("10.0.0.0/8"), QStringLiteral("192.168.1.3"), 100),
+                        route(QStringLiteral("10.0.0.0/16"), QStringLiteral("192.168.1.1"))});
+
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::Duplicate));
+    QCOMPARE(analyzer.duplicateOf(0), 1);
+    QCOMPARE(analyzer.issues(1), RouteAnalyzer::Issues(RouteAnalyzer::Duplicate));
+    QCOMPARE(analyzer.duplicateOf(1), 0);
+    // A different metric is a fallback, not a duplicate
+    QCOMPARE(analyzer.issues(2), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+    QCOMPARE(analyzer.issues(3), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+
+    QVERIFY(analyzer.removeRoute(1));
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+    QCOMPARE(analyzer.duplicateOf(0), -1);
+}
+
+void RouteAnalyzerTest::shadowTest()
+{
+    RouteAnalyzer analyzer(QAbstractSocket::IPv4Protocol);
+    analyzer.setRoutes({route(QStringLiteral("10.0.0.0/8"), QStringLiteral("192.168.1.1")),
+                        route(QStringLiteral("10.0.0.0/9"), QStringLiteral("192.168.1.2")),
+                        route(QStringLiteral("10.128.0.0/10"), QStringLiteral("192.168.1.2"))});
+
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+
+    // The second half of 10.128.0.0/9 completes the cover of 10.0.0.0/8
+    const int handle = analyzer.addRoute(route(QStringLiteral("10.192.0.0/10"), QStringLiteral("192.168.1.3")));
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::Shadowed));
+    QCOMPARE(analyzer.issues(handle), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+
+    QVERIFY(analyzer.updateRoute(handle, route(QStringLiteral("10.192.0.0/11"), QStringLiteral("192.168.1.3"))));
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+}
+
+void RouteAnalyzerTest::nextHopTest()
+{
+    RouteAnalyzer analyzer(QAbstractSocket::IPv4Protocol);
+    analyzer.setRoutes({route(QStringLiteral("10.0.0.0/8"), QStringLiteral("192.168.1.1")),
+                        route(QStringLiteral("172.16.0.0/12"), QStringLiteral("192.168.2.1")),
+                        route(QStringLiteral("192.168.1.128/25"), QStringLiteral("192.168.1.1"))});
+
+    // Nothing is known about the addresses yet
+    QCOMPARE(analyzer.issues(1), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+
+    analyzer.setAddresses({address(QStringLiteral("192.168.1.10"), 24)});
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+    QCOMPARE(analyzer.issues(1), RouteAnalyzer::Issues(RouteAnalyzer::UnreachableNextHop));
+    QCOMPARE(analyzer.issues(2), RouteAnalyzer::Issues(RouteAnalyzer::WithinAddressNetwork));
+
+    // An on-link route makes the gateway reachable
+    const int handle = analyzer.addRoute(route(QStringLiteral("192.168.2.0/24")));
+    QCOMPARE(analyzer.issues(1), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+    QVERIFY(analyzer.removeRoute(handle));
+    QCOMPARE(analyzer.issues(1), RouteAnalyzer::Issues(RouteAnalyzer::UnreachableNextHop));
+}
+
+void RouteAnalyzerTest::ipv6Test()
+{
+    RouteAnalyzer analyzer(QAbstractSocket::IPv6Protocol);
+    analyzer.setAddresses({address(QStringLiteral("2001:db8::10"), 64)});
+    analyzer.setRoutes({route(QStringLiteral("2001:db8:1::/48"), QStringLiteral("fe80::1")),
+                        route(QStringLiteral("2001:db8:2::/48"), QStringLiteral("2001:db8::1")),
+                        route(QStringLiteral("2001:db8:3::/48"), QStringLiteral("2001:db8:5::1")),
+                        route(QStringLiteral("2001:db8::/48"), QStringLiteral("2001:db8::1"))});
+
+    QCOMPARE(analyzer.issues(0), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+    QCOMPARE(analyzer.issues(1), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+    QCOMPARE(analyzer.issues(2), RouteAnalyzer::Issues(RouteAnalyzer::UnreachableNextHop));
+    QCOMPARE(analyzer.issues(3), RouteAnalyzer::Issues(RouteAnalyzer::NoIssue));
+}
+
+void RouteAnalyzerTest::incrementalTest()
+{
+    // Route by route changes have to end up where a full analysis does
+    const QStringList destinations = {
+        QStringLiteral("10.0.0.0/8"), QStringLiteral("10.0.0.0/9"), QStringLiteral("10.128.0.0/9"),
+        QStringLiteral("10.0.0.0/8"), QStringLiteral("0.0.0.0/0"), QStringLiteral("192.168.1.0/24"),
+        QStringLiteral("128.0.0.0/1"), QStringLiteral("0.0.0.0/1")
+    };
+    const QStringList nextHops = {QString(), QStringLiteral("192.168.1.1"), QStringLiteral("10.1.1.1"), QStringLiteral("172.16.0.1")};
+
+    RouteAnalyzer analyzer(QAbstractSocket::IPv4Protocol);
+    analyzer.setAddresses({address(QStringLiteral("192.168.1.10"), 24)});
+    QVector<RouteEntry> routes;
+    QVector<int> handles;
+
+    quint32 seed = 1;
+    auto random = [&seed] (int bound) {
+        seed = seed * 1103515245 + 12345;
+        return int((seed >> 16) % bound);
+    };
+
+    for (int step = 0; step < 500; ++step) {
+        const RouteEntry entry = route(destinations.at(random(destinations.size())), nextHops.at(random(nextHops.size())), random(2));
+        const int operation = random(3);
+        if (operation == 0 || routes.isEmpty()) {
+            routes << entry;
+            handles << analyzer.addRoute(entry);
+        } else if (operation == 1) {
+            const int row = random(routes.size());
+            routes[row] = entry;
+            analyzer.updateRoute(handles.at(row), entry);
+        } else {
+            const int row = random(routes.size());
+            analyzer.removeRoute(handles.at(row));
+            routes.remove(row);
+            handles.remove(row);
+        }
+
+        RouteAnalyzer reference(QAbstractSocket::IPv4Protocol);
+        reference.setAddresses({address(QStringLiteral("192.168.1.10"), 24)});
+        reference.setRoutes(routes);
+        for (int row = 0; row < routes.size(); ++row) {
+            QCOMPARE(analyzer.issues(handles.at(row)), reference.issues(row));
+        }
+    }
+}
+
+void RouteAnalyzerTest::benchmark_data()
+{
+    QTest::addColumn<bool>("incremental");
+
+    QTest::newRow("10k routes") << false;
+    QTest::newRow("edit one of 10k routes") << true;
+}
+
+void RouteAnalyzerTest::benchmark()
+{
+    QFETCH(bool, incremental);
+
+    QVector<RouteEntry> routes;
+    for (int i = 0; i < 10000; ++i) {
+        routes << route(QStringLiteral("10.%1.%2.0/24").arg(i / 256).arg(i % 256), QStringLiteral("192.168.%1.1").arg(i % 4), i % 3);
+    }
+
+    RouteAnalyzer analyzer(QAbstractSocket::IPv4Protocol);
+    analyzer.setAddresses({address(QStringLiteral("192.168.0.10"), 22)});
+
+    if (incremental) {
+        analyzer.setRoutes(routes);
+        const RouteEntry edited = route(QStringLiteral("10.200.0.0/16"), QStringLiteral("192.168.1.1"));
+        QBENCHMARK {
+            analyzer.updateRoute(5000, edited);
+            analyzer.updateRoute(5000, routes.at(5000));
+        }
+    } else {
+        QBENCHMARK {
+            analyzer.setRoutes(routes);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(RouteAnalyzerTest)
+
+#include "routeanalyzertest.moc"
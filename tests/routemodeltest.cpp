@@ -0,0 +1,193 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "widgets/routemodel.h"
+
+#include <QTest>
+#include <QTextStream>
+
+class RouteModelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parseTest();
+    void parseTest_data();
+    void importExportTest();
+    void setDataTest();
+    void routesTest();
+    void benchmark();
+    void benchmark_data();
+};
+
+void RouteModelTest::parseTest_data()
+{
+    QTest::addColumn<bool>("ipv6");
+    QTest::addColumn<QString>("line");
+    QTest::addColumn<QString>("formatted"); // empty when the line is rejected
+
+    QTest::newRow("default") << false << "default via 192.168.1.1 dev wlan0 proto dhcp metric 600" << "default via 192.168.1.1 metric 600";
+    QTest::newRow("link") << false << "192.168.1.0/24 dev wlan0 proto kernel scope link src 192.168.1.23 metric 600" << "192.168.1.0/24 metric 600";
+    QTest::newRow("host") << false << "10.1.2.3 via 10.0.0.1 onlink" << "10.1.2.3/32 via 10.0.0.1";
+    QTest::newRow("unicast") << false << "unicast 10.8.0.0/16 via 10.0.0.1" << "10.8.0.0/16 via 10.0.0.1";
+    QTest::newRow("blackhole") << false << "blackhole 10.9.0.0/16" << QString();
+    QTest::newRow("family") << false << "2001:db8::/32 via fe80::1" << QString();
+    QTest::newRow("prefix") << false << "10.0.0.0/33" << QString();
+    QTest::newRow("gateway") << false << "10.0.0.0/8 via fe80::1" << QString();
+    QTest::newRow("metric") << false << "10.0.0.0/8 metric x" << QString();
+    QTest::newRow("ipv6 default") << true << "default via fe80::1 dev eth0 proto ra metric 100 pref medium" << "default via fe80::1 metric 100";
+    QTest::newRow("ipv6") << true << "2001:db8:1::/48 via 2001:db8::1 dev eth0 metric 1024 pref medium" << "2001:db8:1::/48 via 2001:db8::1 metric 1024";
+    QTest::newRow("ipv6 host") << true << "2001:db8::5 dev eth0" << "2001:db8::5/128";
+    QTest::newRow("ipv6 family") << true << "10.0.0.0/8" << QString();
+}
+
+void RouteModelTest::parseTest()
+{
+    QFETCH(bool, ipv6);
+    QFETCH(QString, line);
+    QFETCH(QString, formatted);
+
+    const QAbstractSocket::NetworkLayerProtocol protocol = ipv6 ? QAbstractSocket::IPv6Protocol : QAbstractSocket::IPv4Protocol;
+    RouteEntry route;
+    QString error;
+    const bool parsed = RouteModel::parseRoute(line, protocol, &route, &error);
+
+    QCOMPARE(parsed, !formatted.isEmpty());
+    if (parsed) {
+        QCOMPARE(RouteModel::formatRoute(route, protocol), formatted);
+    } else {
+        QVERIFY(!error.isEmpty());
+    }
+}
+
+void RouteModelTest::importExportTest()
+{
+    QString input = QStringLiteral("# Policy routes\n"
+                                   "\n"
+                                   "default via 10.0.0.1 dev eth0\n"
+                                   "172.16.0.0/12 via 10.0.0.2 metric 50\n"
+                                   "broadcast 10.0.0.255 dev eth0\n"
+                                   "192.168.0.0/16 via 10.0.0.3\n");
+    QTextStream in(&input);
+
+    RouteModel model(QAbstractSocket::IPv4Protocol);
+    QStringList errors;
+    QCOMPARE(model.importRoutes(in, &errors), 3);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(errors.size(), 1);
+    QVERIFY(errors.first().contains(QLatin1String("5")));
+
+    QCOMPARE(model.index(1, RouteModel::AddressColumn).data().toString(), QStringLiteral("172.16.0.0"));
+    QCOMPARE(model.index(1, RouteModel::PrefixColumn).data().toString(), QStringLiteral("255.240.0.0"));
+    QCOMPARE(model.index(1, RouteModel::NextHopColumn).data().toString(), QStringLiteral("10.0.0.2"));
+    QCOMPARE(model.index(1, RouteModel::MetricColumn).data().toString(), QStringLiteral("50"));
+
+    QString output;
+    QTextStream out(&output);
+    model.exportRoutes(out);
+    out.flush();
+    QCOMPARE(output, QStringLiteral("default via 10.0.0.1\n"
+                                    "172.16.0.0/12 via 10.0.0.2 metric 50\n"
+                                    "192.168.0.0/16 via 10.0.0.3\n"));
+}
+
+void RouteModelTest::setDataTest()
+{
+    RouteModel model(QAbstractSocket::IPv4Protocol);
+    QVERIFY(model.insertRow(0));
+
+    // The netmask of the address class is suggested
+    QVERIFY(model.setData(model.index(0, RouteModel::AddressColumn), QStringLiteral("172.16.5.0")));
+    QCOMPARE(model.index(0, RouteModel::PrefixColumn).data().toString(), QStringLiteral("255.255.0.0"));
+
+    QVERIFY(model.setData(model.index(0, RouteModel::PrefixColumn), QStringLiteral("255.255.255.0")));
+    QVERIFY(!model.setData(model.index(0, RouteModel::PrefixColumn), QStringLiteral("255.0.255.0")));
+    QVERIFY(!model.setData(model.index(0, RouteModel::NextHopColumn), QStringLiteral("fe80::1")));
+    QVERIFY(model.setData(model.index(0, RouteModel::NextHopColumn), QStringLiteral("10.0.0.1")));
+    QVERIFY(model.setData(model.index(0, RouteModel::MetricColumn), QStringLiteral("20")));
+
+    const NetworkManager::IpRoute route = model.routes().first();
+    QCOMPARE(route.ip(), QHostAddress(QStringLiteral("172.16.5.0")));
+    QCOMPARE(route.prefixLength(), 24);
+    QCOMPARE(route.nextHop(), QHostAddress(QStringLiteral("10.0.0.1")));
+    QCOMPARE(route.metric(), 20u);
+
+    // Clearing a cell unsets the value
+    QVERIFY(model.setData(model.index(0, RouteModel::NextHopColumn), QString()));
+    QVERIFY(model.routes().first().nextHop().isNull());
+}
+
+void RouteModelTest::routesTest()
+{
+    QList<NetworkManager::IpRoute> routes;
+    for (int i = 0; i < 3; ++i) {
+        NetworkManager::IpRoute route;
+        route.setIp(QHostAddress(QStringLiteral("2001:db8:%1::").arg(i)));
+        route.setPrefixLength(48);
+        route.setNextHop(QHostAddress(QStringLiteral("fe80::%1").arg(i + 1)));
+        route.setMetric(i);
+        routes << route;
+    }
+
+    RouteModel model(QAbstractSocket::IPv6Protocol);
+    model.setRoutes(routes);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.index(2, RouteModel::PrefixColumn).data().toString(), QStringLiteral("48"));
+
+    const QList<NetworkManager::IpRoute> result = model.routes();
+    QCOMPARE(result.size(), routes.size());
+    for (int i = 0; i < routes.size(); ++i) {
+        QCOMPARE(result.at(i).ip(), routes.at(i).ip());
+        QCOMPARE(result.at(i).prefixLength(), routes.at(i).prefixLength());
+        QCOMPARE(result.at(i).nextHop(), routes.at(i).nextHop());
+        QCOMPARE(result.at(i).metric(), routes.at(i).metric());
+    }
+}
+
+void RouteModelTest::benchmark_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("10000") << 10000;
+}
+
+void RouteModelTest::benchmark()
+{
+    QFETCH(int, count);
+
+    QString input;
+    for (int i = 0; i < count; ++i) {
+        input += QStringLiteral("10.%1.%2.0/24 via 192.168.1.1 dev eth0 metric %3\n").arg(i / 256).arg(i % 256).arg(i);
+    }
+
+    // Import, then save and reopen the way the dialog does
+    QBENCHMARK {
+        QTextStream in(&input);
+        RouteModel model(QAbstractSocket::IPv4Protocol);
+        model.importRoutes(in);
+        const QList<NetworkManager::IpRoute> routes = model.routes();
+        model.setRoutes(routes);
+    }
+}
+
+QTEST_GUILESS_MAIN(RouteModelTest)
+
+#include "routemodeltest.moc"
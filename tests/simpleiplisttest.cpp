@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "simpleiplistvalidator.h"
+#include <QStringList>
 #include <QTest>
 
 class SimpleipListTest : public QObject
@@ -35,6 +36,9 @@ private slots:
     void cidrTest_data();
     void portTest();
     void portTest_data();
+    void editTest();
+    void benchmark();
+    void benchmark_data();
 
 private:
     SimpleIpListValidator m_vb;
@@ -131,6 +135,66 @@ void SimpleipListTest::portTest()
     QCOMPARE(m_vp.validate(address, pos), result);
 }
 
+void SimpleipListTest::editTest()
+{
+    SimpleIpListValidator validator(SimpleIpListValidator::WithCidr);
+    const QString list = QStringLiteral("10.0.0.0/8, fe80::/10,192.168.1.0/24, 2001:db8::/32");
+
+    // Every edit has to give the same result as validating the text from scratch
+    auto check = [&validator] (const QString &text) {
+        SimpleIpListValidator reference(SimpleIpListValidator::WithCidr);
+        QString input = text;
+        QString referenceInput = text;
+        int pos = 0;
+        QCOMPARE(validator.validate(input, pos), reference.validate(referenceInput, pos));
+    };
+
+    for (int i = 0; i <= list.size(); ++i) {
+        check(list.left(i));
+    }
+    for (int i = 0; i < list.size(); ++i) {
+        check(QString(list).remove(i, 1));
+        check(QString(list).insert(i, QLatin1Char('/')));
+        check(QString(list).insert(i, QLatin1Char(',')));
+        check(list);
+    }
+    for (int i = list.size(); i >= 0; --i) {
+        check(list.right(i));
+    }
+}
+
+void SimpleipListTest::benchmark_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void SimpleipListTest::benchmark()
+{
+    QFETCH(int, count);
+
+    SimpleIpListValidator validator(SimpleIpListValidator::WithCidr);
+    QStringList addresses;
+    for (int i = 0; i < count; ++i) {
+        addresses << QStringLiteral("10.%1.%2.0/24").arg(i / 256).arg(i % 256)
+                  << QStringLiteral("fd00:%1::/64").arg(i, 0, 16);
+    }
+    const QString list = addresses.join(QLatin1String(", "));
+    const QString typed = list + QLatin1String(", 1");
+    int pos = 0;
+
+    // A keystroke at the end of the list, and undoing it
+    QBENCHMARK {
+        QString input = typed;
+        validator.validate(input, pos);
+        input = list;
+        validator.validate(input, pos);
+    }
+}
+
 QTEST_GUILESS_MAIN(SimpleipListTest)
 
 #include "simpleiplisttest.moc"
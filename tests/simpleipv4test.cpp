@@ -19,7 +19,94 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "simpleipv4addressvalidator.h"
+#include <QRegularExpressionValidator>
+#include <QStringList>
 #include <QTest>
+#include <QVector>
+
+// The former regular expression based implementation, kept as reference for
+// the parity test and the benchmark
+class RegExpIpV4AddressValidator
+{
+public:
+    explicit RegExpIpV4AddressValidator(SimpleIpV4AddressValidator::AddressStyle style)
+        : m_addressStyle(style)
+    {
+        switch (style) {
+        case SimpleIpV4AddressValidator::Base:
+            m_validator.setRegularExpression(QRegularExpression(QLatin1String("[0-9, ]{1,3}\\.[0-9, ]{1,3}\\.[0-9, ]{1,3}\\.[0-9, ]{1,3}")));
+            break;
+        case SimpleIpV4AddressValidator::WithCidr:
+            m_validator.setRegularExpression(QRegularExpression(QLatin1String("([0-9]{1,3}\\.){3,3}[0-9]{1,3}/[0-9]{1,2}")));
+            break;
+        case SimpleIpV4AddressValidator::WithPort:
+            m_validator.setRegularExpression(QRegularExpression(QLatin1String("([0-9]{1,3}\\.){3,3}[0-9]{1,3}:[0-9]{1,5}")));
+            break;
+        }
+    }
+
+    QValidator::State validate(QString &value, int &pos) const
+    {
+        const QValidator::State maskResult = m_validator.validate(value, pos);
+        if (maskResult == QValidator::Invalid) {
+            return QValidator::Invalid;
+        }
+
+        QVector<QStringRef> addrParts;
+        QStringList suffixParts;
+        switch (m_addressStyle) {
+        case SimpleIpV4AddressValidator::Base:
+            addrParts = value.splitRef(QLatin1Char('.'));
+            break;
+        case SimpleIpV4AddressValidator::WithCidr:
+            suffixParts = value.split(QLatin1Char('/'));
+            addrParts = suffixParts[0].splitRef(QLatin1Char('.'));
+            break;
+        case SimpleIpV4AddressValidator::WithPort:
+            suffixParts = value.split(QLatin1Char(':'));
+            addrParts = suffixParts[0].splitRef(QLatin1Char('.'));
+            break;
+        }
+
+        QStringList temp;
+        QList<int> tetrads;
+        tetrads << -1 << -1 << -1 << -1;
+        int i = 0;
+        for (const QStringRef &part : addrParts) {
+            if (part.isEmpty()) {
+                return i != addrParts.size() - 1 ? QValidator::Invalid : QValidator::Intermediate;
+            }
+            tetrads[i] = part.toInt();
+            if (tetrads[i] > 255) {
+                return QValidator::Invalid;
+            }
+            temp.append(QString::number(tetrads[i]));
+            i++;
+        }
+
+        value = temp.join(QLatin1String("."));
+        if (i < 4) {
+            return QValidator::Intermediate;
+        }
+
+        if (suffixParts.size() > 1) {
+            value += m_addressStyle == SimpleIpV4AddressValidator::WithCidr ? QLatin1String("/") : QLatin1String(":");
+            if (suffixParts[1].isEmpty()) {
+                return QValidator::Intermediate;
+            }
+            if (suffixParts[1].toInt() > (m_addressStyle == SimpleIpV4AddressValidator::WithCidr ? 32 : 65535)) {
+                return QValidator::Invalid;
+            }
+            value += suffixParts[1];
+        }
+
+        return maskResult;
+    }
+
+private:
+    SimpleIpV4AddressValidator::AddressStyle m_addressStyle;
+    QRegularExpressionValidator m_validator;
+};
 
 class SimpleIpv4Test : public QObject
 {
@@ -35,6 +122,12 @@ private slots:
     void cidrTest_data();
     void portTest();
     void portTest_data();
+    void normalizeTest();
+    void normalizeTest_data();
+    void parityTest();
+    void parityTest_data();
+    void benchmark();
+    void benchmark_data();
 
 private:
     SimpleIpV4AddressValidator m_vb;
@@ -147,6 +240,114 @@ void SimpleIpv4Test::portTest()
     QCOMPARE(m_vp.validate(address, pos), result);
 }
 
+void SimpleIpv4Test::normalizeTest_data()
+{
+    QTest::addColumn<int>("style");
+    QTest::addColumn<QString>("address");
+    QTest::addColumn<QString>("normalized");
+    QTest::addColumn<QValidator::State>("result");
+
+    QTest::newRow("001.02.3.4") << int(SimpleIpV4AddressValidator::Base) << "001.02.3.4" << "1.2.3.4" << QValidator::Acceptable;
+    QTest::newRow("10.0 .00") << int(SimpleIpV4AddressValidator::Base) << "10.0 .00" << "10.0.0" << QValidator::Intermediate;
+    QTest::newRow("01.2.") << int(SimpleIpV4AddressValidator::Base) << "01.2." << "01.2." << QValidator::Intermediate;
+    QTest::newRow("1,2.3.4.5") << int(SimpleIpV4AddressValidator::Base) << "1,2.3.4.5" << "0.3.4.5" << QValidator::Acceptable;
+    QTest::newRow("010.1.1.1/08") << int(SimpleIpV4AddressValidator::WithCidr) << "010.1.1.1/08" << "10.1.1.1/08" << QValidator::Acceptable;
+    QTest::newRow("10.01.1.1:") << int(SimpleIpV4AddressValidator::WithPort) << "10.01.1.1:" << "10.1.1.1:" << QValidator::Intermediate;
+}
+
+void SimpleIpv4Test::normalizeTest()
+{
+    QFETCH(int, style);
+    QFETCH(QString, address);
+    QFETCH(QString, normalized);
+    QFETCH(QValidator::State, result);
+
+    SimpleIpV4AddressValidator validator(static_cast<SimpleIpV4AddressValidator::AddressStyle>(style));
+    int pos = 0;
+    QCOMPARE(validator.validate(address, pos), result);
+    QCOMPARE(address, normalized);
+}
+
+void SimpleIpv4Test::parityTest_data()
+{
+    QTest::addColumn<int>("style");
+    QTest::addColumn<QString>("alphabet");
+
+    QTest::newRow("base") << int(SimpleIpV4AddressValidator::Base) << "0129. ,a";
+    QTest::newRow("cidr") << int(SimpleIpV4AddressValidator::WithCidr) << "0129./:";
+    QTest::newRow("port") << int(SimpleIpV4AddressValidator::WithPort) << "01269./:";
+}
+
+void SimpleIpv4Test::parityTest()
+{
+    QFETCH(int, style);
+    QFETCH(QString, alphabet);
+
+    const SimpleIpV4AddressValidator validator(static_cast<SimpleIpV4AddressValidator::AddressStyle>(style));
+    const RegExpIpV4AddressValidator reference(static_cast<SimpleIpV4AddressValidator::AddressStyle>(style));
+
+    // Deterministic pseudo random input, both implementations have to agree on all of it
+    quint32 seed = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        const int length = (seed >> 16) % 19;
+
+        QString input;
+        for (int j = 0; j < length; ++j) {
+            seed = seed * 1103515245 + 12345;
+            input += alphabet.at((seed >> 16) % alphabet.size());
+        }
+
+        QString address = input;
+        QString referenceAddress = input;
+        int pos = 0;
+        int referencePos = 0;
+        const QValidator::State result = validator.validate(address, pos);
+        const QValidator::State referenceResult = reference.validate(referenceAddress, referencePos);
+        QVERIFY2(result == referenceResult, qPrintable(input));
+        if (result != QValidator::Invalid) {
+            QVERIFY2(address == referenceAddress, qPrintable(input));
+        }
+    }
+}
+
+void SimpleIpv4Test::benchmark_data()
+{
+    QTest::addColumn<bool>("regExp");
+    QTest::addColumn<int>("style");
+    QTest::addColumn<QString>("address");
+
+    QTest::newRow("base") << false << int(SimpleIpV4AddressValidator::Base) << "192.168.100.254";
+    QTest::newRow("base regexp") << true << int(SimpleIpV4AddressValidator::Base) << "192.168.100.254";
+    QTest::newRow("cidr") << false << int(SimpleIpV4AddressValidator::WithCidr) << "10.77.18.4/24";
+    QTest::newRow("cidr regexp") << true << int(SimpleIpV4AddressValidator::WithCidr) << "10.77.18.4/24";
+    QTest::newRow("port") << false << int(SimpleIpV4AddressValidator::WithPort) << "10.77.18.4:65535";
+    QTest::newRow("port regexp") << true << int(SimpleIpV4AddressValidator::WithPort) << "10.77.18.4:65535";
+}
+
+void SimpleIpv4Test::benchmark()
+{
+    QFETCH(bool, regExp);
+    QFETCH(int, style);
+    QFETCH(QString, address);
+
+    const SimpleIpV4AddressValidator validator(static_cast<SimpleIpV4AddressValidator::AddressStyle>(style));
+    const RegExpIpV4AddressValidator reference(static_cast<SimpleIpV4AddressValidator::AddressStyle>(style));
+    int pos = 0;
+
+    if (regExp) {
+        QBENCHMARK {
+            QString input = address;
+            reference.validate(input, pos);
+        }
+    } else {
+        QBENCHMARK {
+            QString input = address;
+            validator.validate(input, pos);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(SimpleIpv4Test)
 
 #include "simpleipv4test.moc"
@@ -35,6 +35,8 @@ private slots:
     void cidrTest_data();
     void portTest();
     void portTest_data();
+    void benchmark();
+    void benchmark_data();
 
 private:
     SimpleIpV6AddressValidator m_vb;
@@ -119,6 +121,24 @@ void SimpleIpv6Test::baseTest_data()
     QTest::newRow("0123:4567:89ab:cdef:0123:4567:89ab:cde.") << "0123:4567:89ab:cdef:0123:4567:89ab:cde." << QValidator::Invalid;
     QTest::newRow("0123:4567:89ab:cdef:0123:4567:89ab:cden") << "0123:4567:89ab:cdef:0123:4567:89ab:cden" << QValidator::Invalid;
     QTest::newRow("0n") << "0n" << QValidator::Invalid;
+    QTest::newRow("::1:2:3:4:5:6:7") << "::1:2:3:4:5:6:7" << QValidator::Acceptable;
+    QTest::newRow("1:2:3:4:5:6:7:8:") << "1:2:3:4:5:6:7:8:" << QValidator::Invalid;
+    QTest::newRow(":::") << ":::" << QValidator::Invalid;
+    QTest::newRow("12345") << "12345" << QValidator::Invalid;
+    QTest::newRow("::ffff:") << "::ffff:" << QValidator::Intermediate;
+    QTest::newRow("::ffff:192.") << "::ffff:192." << QValidator::Intermediate;
+    QTest::newRow("::ffff:192.168.1") << "::ffff:192.168.1" << QValidator::Intermediate;
+    QTest::newRow("::ffff:192.168.1.1") << "::ffff:192.168.1.1" << QValidator::Acceptable;
+    QTest::newRow("::192.168.1.1") << "::192.168.1.1" << QValidator::Acceptable;
+    QTest::newRow("1:2:3:4:5:6:192.168.1.1") << "1:2:3:4:5:6:192.168.1.1" << QValidator::Acceptable;
+    QTest::newRow("1:2:3:4:5:192.168.1.1") << "1:2:3:4:5:192.168.1.1" << QValidator::Intermediate;
+    QTest::newRow("1:2:3:4:5:6:7:192.168.1.1") << "1:2:3:4:5:6:7:192.168.1.1" << QValidator::Invalid;
+    QTest::newRow("1:2:3:4:5:6::192.168.1.1") << "1:2:3:4:5:6::192.168.1.1" << QValidator::Invalid;
+    QTest::newRow("::ffff:192.168.1.256") << "::ffff:192.168.1.256" << QValidator::Invalid;
+    QTest::newRow("::ffff:192.168.1.1.1") << "::ffff:192.168.1.1.1" << QValidator::Invalid;
+    QTest::newRow("::ffff:192.168.1.1:1") << "::ffff:192.168.1.1:1" << QValidator::Invalid;
+    QTest::newRow("::ffff:1920.168.1.1") << "::ffff:1920.168.1.1" << QValidator::Invalid;
+    QTest::newRow("::ffff:c0.168.1.1") << "::ffff:c0.168.1.1" << QValidator::Invalid;
 }
 
 void SimpleIpv6Test::baseTest()
@@ -147,6 +167,9 @@ void SimpleIpv6Test::cidrTest_data()
     QTest::newRow("::/0") << "::/0" << QValidator::Acceptable;
     QTest::newRow("1234:2345::6789:789A:89ab/28/") << "1234:2345::6789:789A:89ab/28/" << QValidator::Invalid;
     QTest::newRow("1234:2345::6789:789A:89ab//") << "1234:2345::6789:789A:89ab//" << QValidator::Invalid;
+    QTest::newRow("1234:2345::6789:789A:89ab/1280") << "1234:2345::6789:789A:89ab/1280" << QValidator::Invalid;
+    QTest::newRow("::ffff:10.0.0.0/104") << "::ffff:10.0.0.0/104" << QValidator::Acceptable;
+    QTest::newRow("::ffff:10.0.0/104") << "::ffff:10.0.0/104" << QValidator::Invalid;
 }
 
 void SimpleIpv6Test::cidrTest()
@@ -174,6 +197,8 @@ void SimpleIpv6Test::portTest_data()
     QTest::newRow("[1234:2345::6789:789A:89ab]:12") << "[1234:2345::6789:789A:89ab]:12" << QValidator::Acceptable;
     QTest::newRow("[1234:2345::6789:789A:89ab]:65535") << "[1234:2345::6789:789A:89ab]:65535" << QValidator::Acceptable;
     QTest::newRow("[1234:2345::6789:789A:89ab]:65536") << "[1234:2345::6789:789A:89ab]:65536" << QValidator::Invalid;
+    QTest::newRow("[1234:2345::6789:789A:89ab]1") << "[1234:2345::6789:789A:89ab]1" << QValidator::Invalid;
+    QTest::newRow("[::ffff:10.0.0.1]:80") << "[::ffff:10.0.0.1]:80" << QValidator::Acceptable;
 }
 
 
@@ -187,6 +212,31 @@ void SimpleIpv6Test::portTest()
     QCOMPARE(m_vp.validate(address, pos), result);
 }
 
+void SimpleIpv6Test::benchmark_data()
+{
+    QTest::addColumn<int>("style");
+    QTest::addColumn<QString>("address");
+
+    QTest::newRow("full") << int(SimpleIpV6AddressValidator::Base) << "2001:0db8:85a3:0000:0000:8a2e:0370:7334";
+    QTest::newRow("compressed") << int(SimpleIpV6AddressValidator::Base) << "2001:db8:85a3::8a2e:370:7334";
+    QTest::newRow("dotted quad") << int(SimpleIpV6AddressValidator::Base) << "::ffff:192.168.100.254";
+    QTest::newRow("cidr") << int(SimpleIpV6AddressValidator::WithCidr) << "2001:db8:85a3::/48";
+    QTest::newRow("port") << int(SimpleIpV6AddressValidator::WithPort) << "[2001:db8:85a3::8a2e:370:7334]:51820";
+}
+
+void SimpleIpv6Test::benchmark()
+{
+    QFETCH(int, style);
+    QFETCH(QString, address);
+
+    const SimpleIpV6AddressValidator validator(static_cast<SimpleIpV6AddressValidator::AddressStyle>(style));
+    int pos = 0;
+
+    QBENCHMARK {
+        validator.validate(address, pos);
+    }
+}
+
 QTEST_GUILESS_MAIN(SimpleIpv6Test)
 
 #include "simpleipv6test.moc"
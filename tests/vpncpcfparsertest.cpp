@@ -0,0 +1,139 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vpncpcfparser.h"
+#include "nm-vpnc-service.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+// "GroupSecret" obfuscated the way the Cisco VPN client stores it
+static const QString encryptedSecret = QStringLiteral(
+    "101112131415161718191A1B1C1D1E1F20212223"
+    "2C969BC7BE3AF04583634AA41C759829F13B68C7"
+    "EE6F212E68E7C596FC1B4B8DF9FFE705");
+
+class VpncPcfParserTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void decryptTest_data();
+    void decryptTest();
+    void parseTest();
+    void invalidTest();
+
+private:
+    QString writeProfile(const QString &name, const QByteArray &contents);
+
+    QTemporaryDir m_dir;
+};
+
+void VpncPcfParserTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QString VpncPcfParserTest::writeProfile(const QString &name, const QByteArray &contents)
+{
+    const QString fileName = m_dir.filePath(name);
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return QString();
+    }
+    file.write(contents);
+    return fileName;
+}
+
+void VpncPcfParserTest::decryptTest_data()
+{
+    QTest::addColumn<QString>("encrypted");
+    QTest::addColumn<QString>("password");
+
+    QTest::newRow("valid") << encryptedSecret << QStringLiteral("GroupSecret");
+    QTest::newRow("lowercase") << encryptedSecret.toLower() << QStringLiteral("GroupSecret");
+    QTest::newRow("tampered") << QString(encryptedSecret).replace(QLatin1Char('E'), QLatin1Char('F')) << QString();
+    QTest::newRow("truncated") << encryptedSecret.left(encryptedSecret.size() - 2) << QString();
+    QTest::newRow("not hex") << QString(encryptedSecret).replace(0, 2, QStringLiteral("zz")) << QString();
+    QTest::newRow("empty") << QString() << QString();
+}
+
+void VpncPcfParserTest::decryptTest()
+{
+    QFETCH(QString, encrypted);
+    QFETCH(QString, password);
+
+    QCOMPARE(VpncPcfParser::decryptPassword(encrypted), password);
+}
+
+void VpncPcfParserTest::parseTest()
+{
+    const QString fileName = writeProfile(QStringLiteral("office.pcf"),
+        "[main]\n"
+        "Description=Office\n"
+        "Host=vpn.example.com\n"
+        "GroupName=staff\n"
+        "enc_GroupPwd=" + encryptedSecret.toLatin1() + "\n"
+        "!Username=alice\n"
+        "SaveUserPassword=1\n"
+        "EnableNat=1\n"
+        "TunnelingMode=1\n");
+
+    VpncPcfParser parser(fileName);
+    QVERIFY(parser.parse());
+
+    const NMVariantMapMap connection = parser.connection();
+    QCOMPARE(connection.value(QStringLiteral("connection")).value(QStringLiteral("id")).toString(), QStringLiteral("Office"));
+
+    const NMStringMap data = connection.value(QStringLiteral("vpn")).value(QStringLiteral("data")).value<NMStringMap>();
+    QCOMPARE(data.value(QStringLiteral(NM_VPNC_KEY_GATEWAY)), QStringLiteral("vpn.example.com"));
+    QCOMPARE(data.value(QStringLiteral(NM_VPNC_KEY_ID)), QStringLiteral("staff"));
+    QCOMPARE(data.value(QStringLiteral(NM_VPNC_KEY_XAUTH_USER)), QStringLiteral("alice"));
+    QCOMPARE(data.value(QStringLiteral(NM_VPNC_KEY_NAT_TRAVERSAL_MODE)), QStringLiteral(NM_VPNC_NATT_MODE_CISCO));
+
+    const NMStringMap secrets = connection.value(QStringLiteral("vpn")).value(QStringLiteral("secrets")).value<NMStringMap>();
+    QCOMPARE(secrets.value(QStringLiteral(NM_VPNC_KEY_SECRET)), QStringLiteral("GroupSecret"));
+
+    // TCP tunneling is reported, not shown
+    QCOMPARE(parser.warnings().size(), 1);
+}
+
+void VpncPcfParserTest::invalidTest()
+{
+    VpncPcfParser missing(m_dir.filePath(QStringLiteral("missing.pcf")));
+    QVERIFY(!missing.parse());
+    QVERIFY(!missing.errorString().isEmpty());
+
+    VpncPcfParser noMain(writeProfile(QStringLiteral("nomain.pcf"), "[other]\nHost=vpn.example.com\n"));
+    QVERIFY(!noMain.parse());
+    QVERIFY(noMain.connection().isEmpty());
+
+    // A broken obfuscated password does not stop the import
+    VpncPcfParser broken(writeProfile(QStringLiteral("broken.pcf"), "[main]\nHost=vpn.example.com\nenc_GroupPwd=0011\n"));
+    QVERIFY(broken.parse());
+    QCOMPARE(broken.warnings().size(), 1);
+    QVERIFY(!broken.connection().value(QStringLiteral("vpn")).value(QStringLiteral("secrets")).value<NMStringMap>().contains(QStringLiteral(NM_VPNC_KEY_SECRET)));
+}
+
+QTEST_GUILESS_MAIN(VpncPcfParserTest)
+
+#include "vpncpcfparsertest.moc"
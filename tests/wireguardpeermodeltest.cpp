@@ -0,0 +1,234 @@
+/*
+Copyright 2026 The plasma-nm developers
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of
+the License or (at your option) version 3 or any later version
+accepted by the membership of KDE e.V. (or its successor approved
+by the membership of KDE e.V.), which shall act as a proxy
+defined in Section 14 of version 3 of the license.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "widgets/wireguardpeermodel.h"
+
+#include <QSignalSpy>
+#include <QTest>
+#include <QTextStream>
+
+class WireGuardPeerModelTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fetchTest();
+    void dataTest();
+    void addRemoveTest();
+    void validityTest();
+    void importTest();
+    void importErrorTest();
+    void benchmark();
+    void benchmark_data();
+};
+
+static QString testKey(int i)
+{
+    return QStringLiteral("%1A=").arg(i, 42, 10, QLatin1Char('0'));
+}
+
+static QVariantMap testPeer(int i)
+{
+    return QVariantMap {
+        {QStringLiteral("public-key"), testKey(i)},
+        {QStringLiteral("endpoint"), QStringLiteral("10.0.%1.%2:51820").arg(i / 256 % 256).arg(i % 256)},
+        {QStringLiteral("allowed-ips"), QStringList {QStringLiteral("10.1.%1.0/24").arg(i % 256), QStringLiteral("fd00::%1/128").arg(i, 0, 16)}}
+    };
+}
+
+static NMVariantMapList testPeers(int count)
+{
+    NMVariantMapList peers;
+    for (int i = 0; i < count; ++i) {
+        peers << testPeer(i);
+    }
+    return peers;
+}
+
+void WireGuardPeerModelTest::fetchTest()
+{
+    WireGuardPeerModel model;
+    model.setPeers(testPeers(1000));
+
+    QCOMPARE(model.peerCount(), 1000);
+    QCOMPARE(model.rowCount(), int(WireGuardPeerModel::fetchBatchSize));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsInserted);
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 2 * WireGuardPeerModel::fetchBatchSize);
+    QCOMPARE(spy.count(), 1);
+
+    model.fetchRow(999);
+    QCOMPARE(model.rowCount(), 1000);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    // Nothing is lost by fetching lazily
+    QCOMPARE(model.peers(), testPeers(1000));
+}
+
+void WireGuardPeerModelTest::dataTest()
+{
+    WireGuardPeerModel model;
+    QVariantMap peer = testPeer(1);
+    peer.insert(QStringLiteral("persistent-keepalive"), 25u);
+    model.setPeers({peer});
+
+    QCOMPARE(model.data(model.index(0, WireGuardPeerModel::PublicKeyColumn)).toString(), testKey(1));
+    QCOMPARE(model.data(model.index(0, WireGuardPeerModel::EndpointColumn)).toString(), QStringLiteral("10.0.0.1:51820"));
+    QCOMPARE(model.data(model.index(0, WireGuardPeerModel::AllowedIpsColumn)).toInt(), 2);
+    QCOMPARE(model.data(model.index(0, WireGuardPeerModel::AllowedIpsColumn), Qt::ToolTipRole).toString(), QStringLiteral("10.1.1.0/24\nfd00::1/128"));
+    QCOMPARE(model.data(model.index(0, WireGuardPeerModel::KeepaliveColumn)).toString(), QStringLiteral("25"));
+}
+
+void WireGuardPeerModelTest::addRemoveTest()
+{
+    WireGuardPeerModel model;
+    model.setPeers(testPeers(10));
+    model.addPeers(testPeers(1000).mid(10));
+
+    // The end of the list was visible, so the first batch of new peers shows up
+    QCOMPARE(model.peerCount(), 1000);
+    QCOMPARE(model.rowCount(), 10 + WireGuardPeerModel::fetchBatchSize);
+
+    // More peers stay lazy while the previous ones were not fetched
+    model.addPeers(testPeers(1010).mid(1000));
+    QCOMPARE(model.rowCount(), 10 + WireGuardPeerModel::fetchBatchSize);
+
+    // Unordered rows, duplicates and a range across the fetched rows
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsRemoved);
+    const int fetched = model.rowCount();
+    model.removePeers({5, 3, 4, 3, fetched - 1, fetched, fetched + 1, 1009});
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(model.peerCount(), 1010 - 7);
+    QCOMPARE(model.rowCount(), fetched - 4);
+
+    NMVariantMapList expected = testPeers(1010);
+    expected.removeAt(1009);
+    expected.erase(expected.begin() + fetched - 1, expected.begin() + fetched + 2);
+    expected.erase(expected.begin() + 3, expected.begin() + 6);
+    QCOMPARE(model.peers(), expected);
+}
+
+void WireGuardPeerModelTest::validityTest()
+{
+    WireGuardPeerModel model;
+    model.setPeers(testPeers(3));
+    QVERIFY(model.isValid());
+
+    model.addPeers({QVariantMap()}, false);
+    QVERIFY(!model.isValid());
+
+    model.setPeer(3, testPeer(3), true);
+    QVERIFY(model.isValid());
+
+    model.setPeer(1, QVariantMap(), false);
+    QVERIFY(!model.isValid());
+    model.removePeers({1});
+    QVERIFY(model.isValid());
+}
+
+void WireGuardPeerModelTest::importTest()
+{
+    QString config = QStringLiteral(
+        "[Interface]\n"
+        "PrivateKey = %1\n"
+        "Address = 10.1.0.1/16\n"
+        "ListenPort = 51820\n").arg(testKey(0));
+    for (int i = 1; i <= 600; ++i) {
+        config += QStringLiteral(
+            "\n# peer %1\n"
+            "[Peer]\n"
+            "PublicKey = %2 # comment\n"
+            "AllowedIPs = 10.1.%3.0/24, fd00::%4/128\n"
+            "Endpoint = 10.0.%5.%6:51820\n").arg(i).arg(testKey(i)).arg(i % 256).arg(i, 0, 16).arg(i / 256 % 256).arg(i % 256);
+    }
+    config += QStringLiteral("PersistentKeepalive = 25\n");
+
+    WireGuardPeerModel model;
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsInserted);
+    QTextStream stream(&config);
+    QString error;
+    QCOMPARE(model.importPeers(stream, &error), 600);
+    QVERIFY(error.isEmpty());
+
+    // Only the first batch is materialized
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(model.rowCount(), int(WireGuardPeerModel::fetchBatchSize));
+
+    const NMVariantMapList peers = model.peers();
+    QCOMPARE(peers.size(), 600);
+    for (int i = 0; i < 599; ++i) {
+        QCOMPARE(peers.at(i), testPeer(i + 1));
+    }
+    QCOMPARE(peers.last().value(QStringLiteral("persistent-keepalive")).toUInt(), 25u);
+}
+
+void WireGuardPeerModelTest::importErrorTest()
+{
+    QString config = QStringLiteral(
+        "[Peer]\n"
+        "PublicKey = %1\n"
+        "AllowedIPs = 10.1.0.0/24\n"
+        "[Peer]\n"
+        "PublicKey = invalid\n"
+        "AllowedIPs = 10.2.0.0/24\n"
+        "[Peer]\n"
+        "PublicKey = %2\n"
+        "AllowedIPs = 10.3.0.0/24\n").arg(testKey(1), testKey(3));
+
+    WireGuardPeerModel model;
+    QTextStream stream(&config);
+    QString error;
+    QCOMPARE(model.importPeers(stream, &error), 1);
+    QVERIFY(!error.isEmpty());
+    QCOMPARE(model.peerCount(), 1);
+}
+
+void WireGuardPeerModelTest::benchmark_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void WireGuardPeerModelTest::benchmark()
+{
+    QFETCH(int, count);
+
+    const NMVariantMapList peers = testPeers(count);
+
+    // Loading the peers and showing the first screen of rows
+    QBENCHMARK {
+        WireGuardPeerModel model;
+        model.setPeers(peers);
+        for (int row = 0; row < qMin(30, model.rowCount()); ++row) {
+            for (int column = 0; column < WireGuardPeerModel::ColumnCount; ++column) {
+                model.data(model.index(row, column));
+            }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(WireGuardPeerModelTest)
+
+#include "wireguardpeermodeltest.moc"
@@ -51,11 +51,6 @@ QString FortisslvpnUiPlugin::suggestedFileName(const NetworkManager::ConnectionS
     return QString();
 }
 
-QString FortisslvpnUiPlugin::supportedFileExtensions() const
-{
-    return QString();
-}
-
 NMVariantMapMap FortisslvpnUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
@@ -51,11 +51,6 @@ QString IodineUiPlugin::suggestedFileName(const NetworkManager::ConnectionSettin
     return QString();
 }
 
-QString IodineUiPlugin::supportedFileExtensions() const
-{
-    return QString();
-}
-
 NMVariantMapMap IodineUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
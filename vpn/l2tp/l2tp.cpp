@@ -53,11 +53,6 @@ QString L2tpUiPlugin::suggestedFileName(const NetworkManager::ConnectionSettings
     return QString();
 }
 
-QString L2tpUiPlugin::supportedFileExtensions() const
-{
-    return QString();
-}
-
 NMVariantMapMap L2tpUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
@@ -53,11 +53,6 @@ QString OpenconnectUiPlugin::suggestedFileName(const NetworkManager::ConnectionS
     return QString();
 }
 
-QString OpenconnectUiPlugin::supportedFileExtensions() const
-{
-    return QString();
-}
-
 QMessageBox::StandardButtons OpenconnectUiPlugin::suggestedAuthDialogButtons() const
 {
     return QMessageBox::Close;
@@ -37,7 +37,6 @@ public:
     SettingWidget * askUser(const NetworkManager::VpnSetting::Ptr &setting, QWidget * parent = nullptr) override;
 
     QString suggestedFileName(const NetworkManager::ConnectionSettings::Ptr &connection) const override;
-    QString supportedFileExtensions() const override;
     QMessageBox::StandardButtons suggestedAuthDialogButtons() const override;
     NMVariantMapMap importConnectionSettings(const QString &fileName) override;
     bool exportConnectionSettings(const NetworkManager::ConnectionSettings::Ptr &connection, const QString &fileName) override;
@@ -52,11 +52,6 @@ QString OpenswanUiPlugin::suggestedFileName(const NetworkManager::ConnectionSett
     return QString();
 }
 
-QString OpenswanUiPlugin::supportedFileExtensions() const
-{
-    return QString();
-}
-
 NMVariantMapMap OpenswanUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
@@ -27,7 +27,6 @@
 #include "vpnuiplugin.h"
 
 #include <QVariant>
-#include <QTextStream>
 
 class Q_DECL_EXPORT OpenVpnUiPlugin : public VpnUiPlugin
 {
@@ -39,13 +38,12 @@ public:
     SettingWidget * askUser(const NetworkManager::VpnSetting::Ptr &setting, QWidget * parent = nullptr) override;
 
     QString suggestedFileName(const NetworkManager::ConnectionSettings::Ptr &connection) const override;
-    QString supportedFileExtensions() const override;
     NMVariantMapMap importConnectionSettings(const QString &fileName) override;
+    QList<NMVariantMapMap> importConnections(const QStringList &fileNames, QStringList *messages) override;
     bool exportConnectionSettings(const NetworkManager::ConnectionSettings::Ptr &connection, const QString &fileName) override;
 
 private:
-    QString saveFile(QTextStream &in, const QString &endTag, const QString &connectionName, const QString &fileName);
-    QString tryToCopyToCertificatesDirectory(const QString &connectionName, const QString &sourceFilePath);
+    bool askCopyCertificates();
 };
 
 #endif //  PLASMANM_OPENVPN_H
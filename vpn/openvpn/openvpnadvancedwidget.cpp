@@ -20,31 +20,34 @@
 */
 
 #include "openvpnadvancedwidget.h"
+#include "openvpncapabilities.h"
+#include "openvpncipherbenchmark.h"
 #include "ui_openvpnadvanced.h"
 #include "nm-openvpn-service.h"
 #include "settingwidget.h"
 
-#include <QStandardPaths>
+#include <QLocale>
+#include <QStandardItemModel>
+#include <QThread>
 #include <QUrl>
 #include <QComboBox>
 
 #include <KLocalizedString>
-#include <KProcess>
 #include <KAcceleratorManager>
 
+#include <memory>
+
 class OpenVpnAdvancedWidget::Private {
 public:
     NetworkManager::VpnSetting::Ptr setting;
-    KProcess *openvpnCipherProcess = nullptr;
-    KProcess *openvpnVersionProcess = nullptr;
-    QByteArray openvpnCiphers;
-    QByteArray openVpnVersion;
     bool gotOpenVpnCiphers = false;
     bool gotOpenVpnVersion = false;
     bool readConfig = false;
     int versionX = 0;
     int versionY = 0;
     int versionZ = 0;
+    QStringList ciphers;
+    QMap<QString, double> throughput;
 
     class EnumProxyType
     {
@@ -91,27 +94,6 @@ OpenVpnAdvancedWidget::OpenVpnAdvancedWidget(const NetworkManager::VpnSetting::P
         }
     });
 
-    // start openVPN process and get its cipher list
-    const QString openVpnBinary = QStandardPaths::findExecutable("openvpn", QStringList() << "/sbin" << "/usr/sbin");
-    const QStringList ciphersArgs(QLatin1String("--show-ciphers"));
-    const QStringList versionArgs(QLatin1String("--version"));
-
-    d->openvpnCipherProcess = new KProcess(this);
-    d->openvpnCipherProcess->setOutputChannelMode(KProcess::OnlyStdoutChannel);
-    d->openvpnCipherProcess->setReadChannel(QProcess::StandardOutput);
-    connect(d->openvpnCipherProcess, &KProcess::errorOccurred, this, &OpenVpnAdvancedWidget::openVpnCipherError);
-    connect(d->openvpnCipherProcess, &KProcess::readyReadStandardOutput, this, &OpenVpnAdvancedWidget::gotOpenVpnCipherOutput);
-    connect(d->openvpnCipherProcess, QOverload<int, QProcess::ExitStatus>::of(&KProcess::finished), this, &OpenVpnAdvancedWidget::openVpnCipherFinished);
-    d->openvpnCipherProcess->setProgram(openVpnBinary, ciphersArgs);
-
-    d->openvpnVersionProcess = new KProcess(this);
-    d->openvpnVersionProcess->setOutputChannelMode(KProcess::OnlyStdoutChannel);
-    d->openvpnVersionProcess->setReadChannel(QProcess::StandardOutput);
-    connect(d->openvpnVersionProcess, &KProcess::errorOccurred, this, &OpenVpnAdvancedWidget::openVpnVersionError);
-    connect(d->openvpnVersionProcess, &KProcess::readyReadStandardOutput, this, &OpenVpnAdvancedWidget::gotOpenVpnVersionOutput);
-    connect(d->openvpnVersionProcess, QOverload<int, QProcess::ExitStatus>::of(&KProcess::finished), this, &OpenVpnAdvancedWidget::openVpnVersionFinished);
-    d->openvpnVersionProcess->setProgram(openVpnBinary, versionArgs);
-
     connect(m_ui->buttonBox, &QDialogButtonBox::accepted, this, &OpenVpnAdvancedWidget::accept);
     connect(m_ui->buttonBox, &QDialogButtonBox::rejected, this, &OpenVpnAdvancedWidget::reject);
 
@@ -129,35 +111,71 @@ OpenVpnAdvancedWidget::~OpenVpnAdvancedWidget()
 
 void OpenVpnAdvancedWidget::init()
 {
-    d->openvpnCipherProcess->start();
-    d->openvpnVersionProcess->start();
+    if (!OpenVpnCipherBenchmark::cached(&d->throughput)) {
+        measureCipherThroughput();
+    }
+
+    // Asking openvpn takes a while, it only needs to be done again after it was updated
+    const QString openVpnBinary = OpenVpnCapabilities::findBinary();
+    const OpenVpnCapabilities capabilities = OpenVpnCapabilities::cached(openVpnBinary);
+    if (capabilities.valid) {
+        setCapabilities(capabilities);
+        return;
+    }
+
+    OpenVpnCapabilityProbe *probe = new OpenVpnCapabilityProbe(openVpnBinary, this);
+    connect(probe, &OpenVpnCapabilityProbe::finished, this, [this, probe] (const OpenVpnCapabilities &capabilities) {
+        setCapabilities(capabilities);
+        probe->deleteLater();
+    });
+    probe->start();
 }
 
-void OpenVpnAdvancedWidget::gotOpenVpnCipherOutput()
+void OpenVpnAdvancedWidget::measureCipherThroughput()
 {
-    d->openvpnCiphers.append(d->openvpnCipherProcess->readAll());
+    // Encrypting for a moment would block the dialog, measure in the background
+    auto throughput = std::make_shared<QMap<QString, double>>();
+    QThread *thread = QThread::create([throughput] () {
+        *throughput = OpenVpnCipherBenchmark::measure();
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    connect(thread, &QThread::finished, this, [this, throughput] () {
+        OpenVpnCipherBenchmark::save(*throughput);
+        d->throughput = *throughput;
+        if (d->gotOpenVpnCiphers && !d->ciphers.isEmpty()) {
+            fillCiphers();
+        }
+    });
+    thread->start(QThread::LowPriority);
 }
 
-void OpenVpnAdvancedWidget::openVpnCipherError(QProcess::ProcessError)
+void OpenVpnAdvancedWidget::fillCiphers()
 {
-    m_ui->cboCipher->removeItem(0);
-    m_ui->cboCipher->addItem(i18nc("@item:inlistbox Item added when OpenVPN cipher lookup failed", "OpenVPN cipher lookup failed"));
+    const QVariant current = m_ui->cboCipher->currentData();
+
+    m_ui->cboCipher->clear();
+    m_ui->cboCipher->addItem(i18nc("@item::inlist Default openvpn cipher item", "Default"));
+    // The fastest ciphers on this machine come first
+    for (const QString &cipher : OpenVpnCipherBenchmark::rank(d->ciphers, d->throughput)) {
+        if (d->throughput.contains(cipher)) {
+            m_ui->cboCipher->addItem(i18nc("@item:inlistbox openvpn cipher name and its measured throughput", "%1 (%2 MB/s)",
+                                           cipher, QLocale().toString(d->throughput.value(cipher), 'f', 0)), cipher);
+        } else {
+            m_ui->cboCipher->addItem(cipher, cipher);
+        }
+    }
+
+    if (current.isValid()) {
+        m_ui->cboCipher->setCurrentIndex(m_ui->cboCipher->findData(current));
+    }
 }
 
-void OpenVpnAdvancedWidget::openVpnCipherFinished(int exitCode, QProcess::ExitStatus exitStatus)
+void OpenVpnAdvancedWidget::setCapabilities(const OpenVpnCapabilities &capabilities)
 {
     m_ui->cboCipher->removeItem(0);
-    if (!exitCode && exitStatus == QProcess::NormalExit) {
-        m_ui->cboCipher->addItem(i18nc("@item::inlist Default openvpn cipher item", "Default"));
-        const QList<QByteArray> rawOutputLines = d->openvpnCiphers.split('\n');
-        bool foundFirstSpace = false;
-        for (const QByteArray &cipher : rawOutputLines) {
-            if (cipher.length() == 0) {
-                foundFirstSpace = true;
-            } else if (foundFirstSpace) {
-                m_ui->cboCipher->addItem(QString::fromLocal8Bit(cipher.left(cipher.indexOf(' '))));
-            }
-        }
+    if (capabilities.valid) {
+        d->ciphers = capabilities.ciphers;
+        fillCiphers();
 
         if (m_ui->cboCipher->count()) {
             m_ui->cboCipher->setEnabled(true);
@@ -167,58 +185,49 @@ void OpenVpnAdvancedWidget::openVpnCipherFinished(int exitCode, QProcess::ExitSt
     } else {
         m_ui->cboCipher->addItem(i18nc("@item:inlistbox Item added when OpenVPN cipher lookup failed", "OpenVPN cipher lookup failed"));
     }
-    delete d->openvpnCipherProcess;
-    d->openvpnCipherProcess = nullptr;
-    d->openvpnCiphers = QByteArray();
     d->gotOpenVpnCiphers = true;
 
-    if (d->readConfig) {
-        const NMStringMap dataMap = d->setting->data();
-        if (dataMap.contains(NM_OPENVPN_KEY_CIPHER)) {
-            m_ui->cboCipher->setCurrentIndex(m_ui->cboCipher->findText(dataMap.value(NM_OPENVPN_KEY_CIPHER)));
+    // Digests this openvpn does not know cannot be used for the HMAC authentication
+    QStandardItemModel *hmacModel = qobject_cast<QStandardItemModel*>(m_ui->cboHmac->model());
+    if (hmacModel && !capabilities.digests.isEmpty()) {
+        const QList<QPair<int, QString>> digests = {
+            {Private::EnumHashingAlgorithms::Md4, QStringLiteral("MD4")},
+            {Private::EnumHashingAlgorithms::Md5, QStringLiteral("MD5")},
+            {Private::EnumHashingAlgorithms::Sha1, QStringLiteral("SHA1")},
+            {Private::EnumHashingAlgorithms::Sha224, QStringLiteral("SHA224")},
+            {Private::EnumHashingAlgorithms::Sha256, QStringLiteral("SHA256")},
+            {Private::EnumHashingAlgorithms::Sha384, QStringLiteral("SHA384")},
+            {Private::EnumHashingAlgorithms::Sha512, QStringLiteral("SHA512")},
+            {Private::EnumHashingAlgorithms::Ripemd160, QStringLiteral("RIPEMD160")}
+        };
+        for (const QPair<int, QString> &digest : digests) {
+            QStandardItem *item = hmacModel->item(digest.first);
+            if (item) {
+                item->setEnabled(capabilities.digests.contains(digest.second, Qt::CaseInsensitive));
+            }
         }
     }
-}
-
-void OpenVpnAdvancedWidget::gotOpenVpnVersionOutput()
-{
-    d->openVpnVersion.append(d->openvpnVersionProcess->readAll());
-}
 
-void OpenVpnAdvancedWidget::openVpnVersionError(QProcess::ProcessError)
-{
-    // We couldn't identify OpenVPN version so disable tls-remote
-    disableLegacySubjectMatch();
-}
+    const QStringList versionList = capabilities.version.split(QLatin1Char('.'));
+    if (versionList.count() == 3) {
+        d->versionX = versionList.at(0).toInt();
+        d->versionY = versionList.at(1).toInt();
+        d->versionZ = versionList.at(2).toInt();
 
-void OpenVpnAdvancedWidget::openVpnVersionFinished(int exitCode, QProcess::ExitStatus exitStatus)
-{
-    // OpenVPN returns 1 when you use "--help" and unfortunately returns 1 even when some error occurs
-    if (exitCode == 1 && exitStatus == QProcess::NormalExit) {
-        QStringList list = QString(d->openVpnVersion).split(QLatin1Char(' '));
-        if (list.count() > 2) {
-            const QStringList versionList = list.at(1).split(QLatin1Char('.'));
-            if (versionList.count() == 3) {
-                d->versionX = versionList.at(0).toInt();
-                d->versionY = versionList.at(1).toInt();
-                d->versionZ = versionList.at(2).toInt();
-
-                if (compareVersion(2, 4, 0) >= 0) {
-                    disableLegacySubjectMatch();
-                }
-            }
+        if (compareVersion(2, 4, 0) >= 0) {
+            disableLegacySubjectMatch();
         }
     } else {
+        // We couldn't identify OpenVPN version so disable tls-remote
         disableLegacySubjectMatch();
     }
-
-    delete d->openvpnVersionProcess;
-    d->openvpnVersionProcess = nullptr;
-    d->openVpnVersion = QByteArray();
     d->gotOpenVpnVersion = true;
 
     if (d->readConfig) {
         const NMStringMap dataMap = d->setting->data();
+        if (dataMap.contains(NM_OPENVPN_KEY_CIPHER)) {
+            m_ui->cboCipher->setCurrentIndex(m_ui->cboCipher->findData(dataMap.value(NM_OPENVPN_KEY_CIPHER)));
+        }
         if (dataMap.contains(NM_OPENVPN_KEY_TLS_REMOTE)) {
             m_ui->subjectMatch->setText(dataMap.value(NM_OPENVPN_KEY_TLS_REMOTE));
         }
@@ -385,7 +394,7 @@ void OpenVpnAdvancedWidget::loadConfig()
 
     // ciphers populated above?
     if (d->gotOpenVpnCiphers && dataMap.contains(QLatin1String(NM_OPENVPN_KEY_CIPHER))) {
-        m_ui->cboCipher->setCurrentIndex(m_ui->cboCipher->findText(dataMap[QLatin1String(NM_OPENVPN_KEY_CIPHER)]));
+        m_ui->cboCipher->setCurrentIndex(m_ui->cboCipher->findData(dataMap[QLatin1String(NM_OPENVPN_KEY_CIPHER)]));
     }
 
     // Optional TLS
@@ -592,7 +601,7 @@ NetworkManager::VpnSetting::Ptr OpenVpnAdvancedWidget::setting() const
     }
 
     if (m_ui->cboCipher->currentIndex() != 0) {
-        data.insert(QLatin1String(NM_OPENVPN_KEY_CIPHER), m_ui->cboCipher->currentText());
+        data.insert(QLatin1String(NM_OPENVPN_KEY_CIPHER), m_ui->cboCipher->currentData().toString());
     }
 
     // optional tls authentication
@@ -24,10 +24,11 @@
 #include "passwordfield.h"
 
 #include <QDialog>
-#include <QProcess>
 
 #include <NetworkManagerQt/VpnSetting>
 
+struct OpenVpnCapabilities;
+
 namespace Ui
 {
 class OpenVpnAdvancedWidget;
@@ -53,16 +54,13 @@ public:
     NetworkManager::VpnSetting::Ptr setting() const;
 
 private Q_SLOTS:
-    void gotOpenVpnCipherOutput();
-    void openVpnCipherError(QProcess::ProcessError);
-    void openVpnCipherFinished(int, QProcess::ExitStatus);
-    void gotOpenVpnVersionOutput();
-    void openVpnVersionError(QProcess::ProcessError);
-    void openVpnVersionFinished(int, QProcess::ExitStatus);
     void certCheckTypeChanged(int);
     void proxyTypeChanged(int);
 
 private:
+    void setCapabilities(const OpenVpnCapabilities &capabilities);
+    void measureCipherThroughput();
+    void fillCiphers();
     int compareVersion(const int x, const int y, const int z) const;
     void disableLegacySubjectMatch();
     void loadConfig();
@@ -0,0 +1,176 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "openvpncapabilities.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QProcess>
+#include <QStandardPaths>
+
+#include <KConfig>
+#include <KConfigGroup>
+
+static QString cacheFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/plasma-nm/openvpn-capabilities");
+}
+
+QString OpenVpnCapabilities::findBinary()
+{
+    return QStandardPaths::findExecutable(QStringLiteral("openvpn"), {QStringLiteral("/sbin"), QStringLiteral("/usr/sbin")});
+}
+
+OpenVpnCapabilities OpenVpnCapabilities::cached(const QString &binary)
+{
+    OpenVpnCapabilities capabilities;
+
+    const QFileInfo info(binary);
+    if (binary.isEmpty() || !info.exists()) {
+        return capabilities;
+    }
+
+    KConfig config(cacheFileName(), KConfig::SimpleConfig);
+    const KConfigGroup group(&config, QLatin1String("Capabilities"));
+    if (group.readEntry(QLatin1String("Binary"), QString()) != binary ||
+        group.readEntry(QLatin1String("Modified"), qint64(0)) != info.lastModified().toMSecsSinceEpoch() ||
+        group.readEntry(QLatin1String("Size"), qint64(-1)) != info.size()) {
+        return capabilities;
+    }
+
+    capabilities.binary = binary;
+    capabilities.ciphers = group.readEntry(QLatin1String("Ciphers"), QStringList());
+    capabilities.digests = group.readEntry(QLatin1String("Digests"), QStringList());
+    capabilities.version = group.readEntry(QLatin1String("Version"), QString());
+    capabilities.valid = true;
+    return capabilities;
+}
+
+void OpenVpnCapabilities::save() const
+{
+    const QFileInfo info(binary);
+    if (!valid || !info.exists()) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(cacheFileName()).absolutePath());
+
+    KConfig config(cacheFileName(), KConfig::SimpleConfig);
+    KConfigGroup group(&config, QLatin1String("Capabilities"));
+    group.writeEntry(QLatin1String("Binary"), binary);
+    group.writeEntry(QLatin1String("Modified"), info.lastModified().toMSecsSinceEpoch());
+    group.writeEntry(QLatin1String("Size"), info.size());
+    group.writeEntry(QLatin1String("Ciphers"), ciphers);
+    group.writeEntry(QLatin1String("Digests"), digests);
+    group.writeEntry(QLatin1String("Version"), version);
+    config.sync();
+}
+
+QStringList OpenVpnCapabilities::parseList(const QByteArray &output)
+{
+    QStringList result;
+    bool foundFirstSpace = false;
+    for (const QByteArray &line : output.split('\n')) {
+        if (line.isEmpty()) {
+            foundFirstSpace = true;
+        } else if (foundFirstSpace) {
+            result << QString::fromLocal8Bit(line.left(line.indexOf(' ')));
+        }
+    }
+    return result;
+}
+
+QString OpenVpnCapabilities::parseVersion(const QByteArray &output)
+{
+    const QStringList list = QString::fromLocal8Bit(output).split(QLatin1Char(' '));
+    if (list.count() > 2 && list.at(1).count(QLatin1Char('.')) == 2) {
+        return list.at(1);
+    }
+    return QString();
+}
+
+OpenVpnCapabilityProbe::OpenVpnCapabilityProbe(const QString &binary, QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<OpenVpnCapabilities>();
+
+    m_capabilities.binary = binary;
+}
+
+void OpenVpnCapabilityProbe::start()
+{
+    if (m_capabilities.binary.isEmpty()) {
+        QMetaObject::invokeMethod(this, [this] () {
+            Q_EMIT finished(m_capabilities);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    m_pending = 3;
+    run(QStringLiteral("--show-ciphers"), [this] (int exitCode, const QByteArray &output) {
+        if (!exitCode) {
+            m_capabilities.ciphers = OpenVpnCapabilities::parseList(output);
+            m_capabilities.valid = true;
+        }
+    });
+    run(QStringLiteral("--show-digests"), [this] (int exitCode, const QByteArray &output) {
+        if (!exitCode) {
+            m_capabilities.digests = OpenVpnCapabilities::parseList(output);
+        }
+    });
+    // OpenVPN returns 1 when you use "--help" and unfortunately returns 1 even when some error occurs
+    run(QStringLiteral("--version"), [this] (int exitCode, const QByteArray &output) {
+        if (exitCode == 1) {
+            m_capabilities.version = OpenVpnCapabilities::parseVersion(output);
+        }
+    });
+}
+
+void OpenVpnCapabilityProbe::run(const QString &argument, const std::function<void(int, const QByteArray &)> &handleOutput)
+{
+    QProcess *process = new QProcess(this);
+    process->setReadChannel(QProcess::StandardOutput);
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [this, process, handleOutput] (int exitCode, QProcess::ExitStatus exitStatus) {
+        if (exitStatus == QProcess::NormalExit) {
+            handleOutput(exitCode, process->readAllStandardOutput());
+        }
+        process->deleteLater();
+        processDone();
+    });
+    // No finished() follows if the process could not be started
+    connect(process, &QProcess::errorOccurred, this, [this, process] (QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            process->deleteLater();
+            processDone();
+        }
+    });
+    process->start(m_capabilities.binary, {argument});
+}
+
+void OpenVpnCapabilityProbe::processDone()
+{
+    if (--m_pending) {
+        return;
+    }
+
+    m_capabilities.save();
+    Q_EMIT finished(m_capabilities);
+}
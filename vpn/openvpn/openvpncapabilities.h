@@ -0,0 +1,89 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_OPENVPN_CAPABILITIES_H
+#define PLASMA_NM_OPENVPN_CAPABILITIES_H
+
+#include <QObject>
+#include <QStringList>
+
+#include <functional>
+
+/**
+ * Ciphers, digests and version of the installed openvpn binary.
+ *
+ * Asking the binary takes several process launches, so the result is cached
+ * together with the path, modification time and size of the binary and only
+ * probed again after it changed.
+ */
+struct Q_DECL_EXPORT OpenVpnCapabilities
+{
+    QString binary;
+    QStringList ciphers;
+    QStringList digests;
+    QString version;
+    // Whether the ciphers could be listed
+    bool valid = false;
+
+    static QString findBinary();
+
+    /**
+     * Returns the cached capabilities of @p binary, they are invalid if nothing
+     * was cached yet or the binary changed since.
+     */
+    static OpenVpnCapabilities cached(const QString &binary);
+    void save() const;
+
+    /**
+     * Returns the names listed by "--show-ciphers" or "--show-digests", they
+     * follow the description paragraph.
+     */
+    static QStringList parseList(const QByteArray &output);
+    /**
+     * Returns the version from the output of "--version", e.g. "2.4.7".
+     */
+    static QString parseVersion(const QByteArray &output);
+};
+
+/**
+ * Asks the openvpn binary for its capabilities in the background and caches them.
+ */
+class Q_DECL_EXPORT OpenVpnCapabilityProbe : public QObject
+{
+    Q_OBJECT
+public:
+    explicit OpenVpnCapabilityProbe(const QString &binary, QObject *parent = nullptr);
+
+    void start();
+
+Q_SIGNALS:
+    void finished(const OpenVpnCapabilities &capabilities);
+
+private:
+    void run(const QString &argument, const std::function<void(int, const QByteArray &)> &handleOutput);
+    void processDone();
+
+    OpenVpnCapabilities m_capabilities;
+    int m_pending = 0;
+};
+
+Q_DECLARE_METATYPE(OpenVpnCapabilities)
+
+#endif // PLASMA_NM_OPENVPN_CAPABILITIES_H
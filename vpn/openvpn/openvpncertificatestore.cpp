@@ -0,0 +1,148 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License or (at your option) version 3 or any later version
+    accepted by the membership of KDE e.V. (or its successor approved
+    by the membership of KDE e.V.), which shall act as a proxy
+    defined in Section 14 of version 3 of the license.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "openvpncertificatestore.h"
+#include "openvpnconfigparser.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryFile>
+
+static const int chunkSize = 64 * 1024;
+static const int gracePeriod = 24 * 60 * 60; // seconds
+
+QString OpenVpnCertificateStore::directory()
+{
+    return OpenVpnConfigParser::localCertPath() + QLatin1String("sha256/");
+}
+
+QString OpenVpnCertificateStore::add(QIODevice *source, QString *errorString)
+{
+    const QString storeDirectory = directory();
+    QDir().mkpath(storeDirectory);
+
+    // Hash while writing, the data is read only once
+    QTemporaryFile file(storeDirectory + QLatin1String("XXXXXX.tmp"));
+    if (!file.open()) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QByteArray buffer(chunkSize, Qt::Uninitialized);
+    qint64 size;
+    while ((size = source->read(buffer.data(), buffer.size())) > 0) {
+        hash.addData(buffer.constData(), int(size));
+        if (file.write(buffer.constData(), size) != size) {
+            if (errorString) {
+                *errorString = file.errorString();
+            }
+            return QString();
+        }
+    }
+
+    if (size < 0) {
+        if (errorString) {
+            *errorString = source->errorString();
+        }
+        return QString();
+    }
+
+    const QString path = storeDirectory + QString::fromLatin1(hash.result().toHex());
+    if (QFileInfo::exists(path)) {
+        // Known content, keep it away from the garbage collection
+        QFile entry(path);
+        if (entry.open(QFile::ReadWrite)) {
+            entry.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        }
+        return path;
+    }
+
+    file.setAutoRemove(false);
+    if (!file.rename(path)) {
+        file.remove();
+        // Another import may have stored the same content in the meantime
+        if (!QFileInfo::exists(path)) {
+            if (errorString) {
+                *errorString = file.errorString();
+            }
+            return QString();
+        }
+    }
+
+    return path;
+}
+
+QString OpenVpnCertificateStore::add(const QByteArray &data, QString *errorString)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return add(&buffer, errorString);
+}
+
+QString OpenVpnCertificateStore::addFile(const QString &fileName, QString *errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return QString();
+    }
+    return add(&file, errorString);
+}
+
+int OpenVpnCertificateStore::collectGarbage(const QSet<QString> &referencedFiles)
+{
+    // Without any reference the connections are most likely just not known yet
+    if (referencedFiles.isEmpty()) {
+        return 0;
+    }
+
+    // Connections may point to the store through symbolic links or non-clean paths
+    QSet<QString> referenced;
+    for (const QString &fileName : referencedFiles) {
+        const QString canonicalPath = QFileInfo(fileName).canonicalFilePath();
+        if (!canonicalPath.isEmpty()) {
+            referenced << canonicalPath;
+        }
+    }
+
+    const QDateTime expired = QDateTime::currentDateTime().addSecs(-gracePeriod);
+
+    int removed = 0;
+    const QFileInfoList entries = QDir(directory()).entryInfoList(QDir::Files | QDir::Hidden);
+    for (const QFileInfo &entry : entries) {
+        if (entry.lastModified() >= expired || referenced.contains(entry.canonicalFilePath())) {
+            continue;
+        }
+        if (QFile::remove(entry.absoluteFilePath())) {
+            ++removed;
+        }
+    }
+    return removed;
+}
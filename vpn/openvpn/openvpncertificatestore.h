@@ -0,0 +1,59 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License or (at your option) version 3 or any later version
+    accepted by the membership of KDE e.V. (or its successor approved
+    by the membership of KDE e.V.), which shall act as a proxy
+    defined in Section 14 of version 3 of the license.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMANM_OPENVPN_CERTIFICATE_STORE_H
+#define PLASMANM_OPENVPN_CERTIFICATE_STORE_H
+
+#include <QSet>
+#include <QString>
+
+class QIODevice;
+
+/**
+ * Content addressed storage for the certificates and keys of imported
+ * OpenVPN connections.
+ *
+ * Every entry is named after the SHA-256 hash of its contents, so connections
+ * sharing a certificate, e.g. all profiles of one provider, reference the same
+ * file instead of each getting a copy.
+ */
+class Q_DECL_EXPORT OpenVpnCertificateStore
+{
+public:
+    static QString directory();
+
+    /**
+     * Stores what is left to read from @p source and returns the path of the entry,
+     * or an empty string and @p errorString if it could not be written.
+     */
+    static QString add(QIODevice *source, QString *errorString = nullptr);
+    static QString add(const QByteArray &data, QString *errorString = nullptr);
+    static QString addFile(const QString &fileName, QString *errorString = nullptr);
+
+    /**
+     * Removes the entries none of @p referencedFiles points to. Entries modified
+     * during the last day are kept, they may belong to an import in progress.
+     * Nothing is removed if @p referencedFiles is empty, as that rather means the
+     * connections are not known. Returns the number of removed entries.
+     */
+    static int collectGarbage(const QSet<QString> &referencedFiles);
+};
+
+#endif // PLASMANM_OPENVPN_CERTIFICATE_STORE_H
@@ -0,0 +1,152 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "openvpncipherbenchmark.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QtCrypto>
+
+#include <KConfig>
+#include <KConfigGroup>
+
+#include <algorithm>
+
+// Payload of a full sized packet on a 1500 bytes MTU link
+static const int packetSize = 1400;
+static const int durationPerCipher = 100; // milliseconds
+
+struct Candidate {
+    const char *name;
+    const char *type;
+    int keySize;
+};
+
+// OpenVPN and QCA names of the data ciphers. QCA has no ChaCha20-Poly1305, so it cannot be measured.
+static const Candidate candidates[] = {
+    {"AES-128-GCM", "aes128", 16},
+    {"AES-192-GCM", "aes192", 24},
+    {"AES-256-GCM", "aes256", 32}
+};
+
+static QString cacheFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/plasma-nm/openvpn-cipher-benchmark");
+}
+
+static QString machine()
+{
+    QString cpu = QSysInfo::currentCpuArchitecture();
+
+    QFile cpuInfo(QStringLiteral("/proc/cpuinfo"));
+    if (cpuInfo.open(QFile::ReadOnly | QFile::Text)) {
+        while (!cpuInfo.atEnd()) {
+            const QByteArray line = cpuInfo.readLine();
+            if (line.startsWith("model name")) {
+                cpu = QString::fromLatin1(line.mid(line.indexOf(':') + 1).trimmed());
+                break;
+            }
+        }
+    }
+
+    return cpu + QLatin1String(", QCA ") + QLatin1String(QCA::qcaVersionStr());
+}
+
+bool OpenVpnCipherBenchmark::cached(QMap<QString, double> *throughput)
+{
+    KConfig config(cacheFileName(), KConfig::SimpleConfig);
+    const KConfigGroup group(&config, QLatin1String("Throughput"));
+    if (group.readEntry(QLatin1String("Machine"), QString()) != machine()) {
+        return false;
+    }
+
+    throughput->clear();
+    for (const Candidate &candidate : candidates) {
+        const QString name = QLatin1String(candidate.name);
+        if (group.hasKey(name)) {
+            throughput->insert(name, group.readEntry(name, 0.0));
+        }
+    }
+    return true;
+}
+
+void OpenVpnCipherBenchmark::save(const QMap<QString, double> &throughput)
+{
+    QDir().mkpath(QFileInfo(cacheFileName()).absolutePath());
+
+    KConfig config(cacheFileName(), KConfig::SimpleConfig);
+    KConfigGroup group(&config, QLatin1String("Throughput"));
+    group.deleteGroup();
+    group.writeEntry(QLatin1String("Machine"), machine());
+    for (auto it = throughput.constBegin(); it != throughput.constEnd(); ++it) {
+        group.writeEntry(it.key(), it.value());
+    }
+    config.sync();
+}
+
+QMap<QString, double> OpenVpnCipherBenchmark::measure()
+{
+    QCA::Initializer init;
+    QMap<QString, double> result;
+
+    const QCA::SecureArray packet(packetSize, 0);
+    for (const Candidate &candidate : candidates) {
+        const QString type = QLatin1String(candidate.type);
+        if (!QCA::isSupported(QCA::Cipher::withAlgorithms(type, QCA::Cipher::GCM, QCA::Cipher::NoPadding).toLatin1().constData())) {
+            continue;
+        }
+
+        const QCA::SymmetricKey key(candidate.keySize);
+        const QCA::InitializationVector iv(12);
+        const QCA::AuthTag tag(16);
+        QCA::Cipher cipher(type, QCA::Cipher::GCM, QCA::Cipher::NoPadding, QCA::Encode, key, iv, tag);
+
+        // Every packet is sealed on its own, like OpenVPN does with a fresh IV
+        qint64 bytes = 0;
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < durationPerCipher) {
+            cipher.setup(QCA::Encode, key, iv, tag);
+            cipher.update(packet);
+            cipher.final();
+            bytes += packetSize;
+        }
+
+        const qint64 elapsed = timer.nsecsElapsed();
+        if (cipher.ok() && elapsed > 0) {
+            result.insert(QLatin1String(candidate.name), bytes * 1000.0 / elapsed);
+        }
+    }
+
+    return result;
+}
+
+QStringList OpenVpnCipherBenchmark::rank(const QStringList &ciphers, const QMap<QString, double> &throughput)
+{
+    QStringList result = ciphers;
+    std::stable_sort(result.begin(), result.end(), [&throughput] (const QString &left, const QString &right) {
+        return throughput.value(left, -1) > throughput.value(right, -1);
+    });
+    return result;
+}
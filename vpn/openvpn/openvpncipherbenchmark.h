@@ -0,0 +1,57 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMA_NM_OPENVPN_CIPHER_BENCHMARK_H
+#define PLASMA_NM_OPENVPN_CIPHER_BENCHMARK_H
+
+#include <QMap>
+#include <QStringList>
+
+/**
+ * Measures how fast this machine encrypts with the AEAD data ciphers of OpenVPN,
+ * so the fastest ones can be recommended.
+ *
+ * Throughput depends on the CPU, e.g. whether it has AES instructions, so the
+ * results are cached per CPU model and QCA version.
+ */
+class Q_DECL_EXPORT OpenVpnCipherBenchmark
+{
+public:
+    /**
+     * Returns the cached throughput in MB/s by OpenVPN cipher name, or false if
+     * nothing was measured on this machine yet.
+     */
+    static bool cached(QMap<QString, double> *throughput);
+    static void save(const QMap<QString, double> &throughput);
+
+    /**
+     * Encrypts packet sized buffers with every candidate cipher supported by QCA
+     * and returns the throughput in MB/s. This blocks for a few hundred milliseconds.
+     */
+    static QMap<QString, double> measure();
+
+    /**
+     * Sorts the measured @p ciphers by throughput, fastest first, and keeps the
+     * others in their order behind them.
+     */
+    static QStringList rank(const QStringList &ciphers, const QMap<QString, double> &throughput);
+};
+
+#endif // PLASMA_NM_OPENVPN_CIPHER_BENCHMARK_H
@@ -0,0 +1,163 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License or (at your option) version 3 or any later version
+    accepted by the membership of KDE e.V. (or its successor approved
+    by the membership of KDE e.V.), which shall act as a proxy
+    defined in Section 14 of version 3 of the license.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMANM_OPENVPN_CONFIG_PARSER_H
+#define PLASMANM_OPENVPN_CONFIG_PARSER_H
+
+#include <QStringList>
+#include <QStringView>
+#include <QVarLengthArray>
+#include <QVector>
+
+#include <NetworkManagerQt/GenericTypes>
+
+#include <string_view>
+
+struct OpenVpnDiagnostic
+{
+    enum Severity {
+        Ignored, // option not supported by NetworkManager
+        Warning  // option with invalid arguments
+    };
+
+    int line = 0;
+    Severity severity = Warning;
+    QString message;
+};
+
+/**
+ * Reads an OpenVPN client configuration file into the settings of a
+ * NetworkManager VPN connection.
+ *
+ * Problems with single options do not stop the import, they are collected as
+ * diagnostics and left to the caller to present. The parser does not touch any
+ * UI, so several files can be parsed at the same time on worker threads.
+ */
+class Q_DECL_EXPORT OpenVpnConfigParser
+{
+public:
+    explicit OpenVpnConfigParser(const QString &fileName);
+
+    /**
+     * Copy certificates and keys referenced by the configuration to
+     * localCertPath() instead of pointing the connection to the originals.
+     */
+    void setCopyCertificates(bool copy);
+
+    /**
+     * Returns false if the file cannot be read or is not a usable OpenVPN
+     * client configuration, see errorString().
+     */
+    bool parse();
+
+    NMVariantMapMap connection() const;
+    QVector<OpenVpnDiagnostic> diagnostics() const;
+    /**
+     * Returns the diagnostics of severity Warning, formatted for display.
+     */
+    QStringList warnings() const;
+    QString errorString() const;
+
+    static QString localCertPath();
+
+private:
+    typedef QVarLengthArray<QStringView, 8> Arguments;
+    typedef void (OpenVpnConfigParser::*Handler)(const Arguments &args);
+
+    struct Keyword {
+        std::string_view name;
+        Handler handler;
+        int minArgs;
+        int maxArgs;
+    };
+    static const Keyword keywords[];
+    static constexpr bool keywordsSorted();
+
+    bool nextLine(QStringView *line);
+    void parseLine(QStringView line);
+    void finish();
+    void warn(const QString &message);
+    void warnArgumentCount(const Keyword &keyword);
+
+    QStringView rest(const Arguments &args) const;
+    QString filePath(QStringView value, QStringView *leftover = nullptr) const;
+    QString certificatePath(QStringView value, QStringView *leftover = nullptr);
+    void saveInline(const QString &endTag, const char *key);
+
+    void parseAuth(const Arguments &args);
+    void parseAuthUserPass(const Arguments &args);
+    void parseCa(const Arguments &args);
+    void parseCert(const Arguments &args);
+    void parseCipher(const Arguments &args);
+    void parseClient(const Arguments &args);
+    void parseCompLzo(const Arguments &args);
+    void parseCompress(const Arguments &args);
+    void parseDev(const Arguments &args);
+    void parseFragment(const Arguments &args);
+    void parseHttpProxy(const Arguments &args);
+    void parseIfconfig(const Arguments &args);
+    void parseKey(const Arguments &args);
+    void parseKeyDirection(const Arguments &args);
+    void parseMssfix(const Arguments &args);
+    void parsePkcs12(const Arguments &args);
+    void parsePort(const Arguments &args);
+    void parseProto(const Arguments &args);
+    void parseProxy(const QString &type, const Arguments &args);
+    void parseProxyRetry(const Arguments &args);
+    void parseRemote(const Arguments &args);
+    void parseRenegSec(const Arguments &args);
+    void parseRoutes(const Arguments &args);
+    void parseSecret(const Arguments &args);
+    void parseSocksProxy(const Arguments &args);
+    void parseTlsAuth(const Arguments &args);
+    void parseTlsRemote(const Arguments &args);
+    void parseTunMtu(const Arguments &args);
+    void parseInlineCa(const Arguments &args);
+    void parseInlineCert(const Arguments &args);
+    void parseInlineKey(const Arguments &args);
+    void parseInlineSecret(const Arguments &args);
+    void parseInlineTlsAuth(const Arguments &args);
+
+    QString m_fileName;
+    QString m_connectionName;
+    bool m_copyCertificates = false;
+
+    // The whole file, lines and arguments are views into it
+    QString m_text;
+    int m_position = 0;
+    int m_lineNumber = 0;
+    QStringView m_line;
+
+    NMStringMap m_data;
+    NMStringMap m_secrets;
+    QVariantMap m_ipv4;
+    bool m_haveClient = false;
+    bool m_haveRemote = false;
+    bool m_haveProxy = false;
+    bool m_havePass = false;
+    bool m_haveStaticKey = false;
+    int m_keyDirection = -1;
+
+    NMVariantMapMap m_connection;
+    QVector<OpenVpnDiagnostic> m_diagnostics;
+    QString m_errorString;
+};
+
+#endif // PLASMANM_OPENVPN_CONFIG_PARSER_H
@@ -53,11 +53,6 @@ QString PptpUiPlugin::suggestedFileName(const NetworkManager::ConnectionSettings
     return QString();
 }
 
-QString PptpUiPlugin::supportedFileExtensions() const
-{
-    return QString();
-}
-
 NMVariantMapMap PptpUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
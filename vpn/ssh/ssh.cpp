@@ -53,12 +53,6 @@ QString SshUiPlugin::suggestedFileName(const NetworkManager::ConnectionSettings:
     return QString();
 }
 
-QString SshUiPlugin::supportedFileExtensions() const
-{
-    // TODO : return supported file extensions
-    return QString();
-}
-
 NMVariantMapMap SshUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
@@ -53,12 +53,6 @@ QString SstpUiPlugin::suggestedFileName(const NetworkManager::ConnectionSettings
     return QString();
 }
 
-QString SstpUiPlugin::supportedFileExtensions() const
-{
-    // TODO : return supported file extensions
-    return QString();
-}
-
 NMVariantMapMap SstpUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
@@ -55,12 +55,6 @@ QString StrongswanUiPlugin::suggestedFileName(const NetworkManager::ConnectionSe
     return QString();
 }
 
-QString StrongswanUiPlugin::supportedFileExtensions() const
-{
-    // TODO : return supported file extensions
-    return QString();
-}
-
 NMVariantMapMap StrongswanUiPlugin::importConnectionSettings(const QString &fileName)
 {
     Q_UNUSED(fileName);
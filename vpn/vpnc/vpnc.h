@@ -28,25 +28,6 @@
 
 #include <QVariant>
 
-#include <KProcess>
-#include <KConfigGroup>
-
-class VpncUiPluginPrivate: public QObject
-{
-    Q_OBJECT
-public:
-    VpncUiPluginPrivate();
-    ~VpncUiPluginPrivate() override;
-    QString readStringKeyValue(const KConfigGroup & configGroup, const QString & key);
-    KProcess * ciscoDecrypt;
-    QString decryptedPasswd;
-
-public Q_SLOTS:
-    void gotCiscoDecryptOutput();
-    void ciscoDecryptError(QProcess::ProcessError pError);
-    void ciscoDecryptFinished(int exitCode, QProcess::ExitStatus exitStatus);
-};
-
 class Q_DECL_EXPORT VpncUiPlugin : public VpnUiPlugin
 {
     Q_OBJECT
@@ -58,8 +39,8 @@ public:
     SettingWidget * askUser(const NetworkManager::VpnSetting::Ptr &setting, QWidget * parent = nullptr) override;
 
     QString suggestedFileName(const NetworkManager::ConnectionSettings::Ptr &connection) const override;
-    QString supportedFileExtensions() const override;
     NMVariantMapMap importConnectionSettings(const QString &fileName) override;
+    QList<NMVariantMapMap> importConnections(const QStringList &fileNames, QStringList *messages) override;
     bool exportConnectionSettings(const NetworkManager::ConnectionSettings::Ptr &connection, const QString &fileName) override;
 };
 
@@ -0,0 +1,287 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License or (at your option) version 3 or any later version
+    accepted by the membership of KDE e.V. (or its successor approved
+    by the membership of KDE e.V.), which shall act as a proxy
+    defined in Section 14 of version 3 of the license.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "vpncpcfparser.h"
+#include "debug.h"
+#include "nm-vpnc-service.h"
+
+#include <QFileInfo>
+#include <QHostAddress>
+#include <QtCrypto>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+#include <NetworkManagerQt/IpRoute>
+#include <NetworkManagerQt/Setting>
+#include <NetworkManagerQt/VpnSetting>
+
+#include <arpa/inet.h>
+
+#define NM_VPNC_LOCAL_PORT_DEFAULT 500
+
+VpncPcfParser::VpncPcfParser(const QString &fileName)
+    : m_fileName(fileName)
+{
+}
+
+NMVariantMapMap VpncPcfParser::connection() const
+{
+    return m_connection;
+}
+
+QStringList VpncPcfParser::warnings() const
+{
+    return m_warnings;
+}
+
+QString VpncPcfParser::errorString() const
+{
+    return m_errorString;
+}
+
+QString VpncPcfParser::readStringKeyValue(const KConfigGroup &configGroup, const QString &key)
+{
+    const QString retValue = configGroup.readEntry(key);
+    if (retValue.isEmpty()) {
+        // String key can also start with "!" in CISCO pcf file.
+        return configGroup.readEntry('!' + key);
+    } else {
+        return retValue;
+    }
+}
+
+QString VpncPcfParser::decryptPassword(const QString &encrypted)
+{
+    // A 20 bytes seed for key and IV, the SHA-1 of the ciphertext and the 3DES ciphertext itself
+    const QByteArray hex = encrypted.trimmed().toLatin1();
+    const QByteArray data = QByteArray::fromHex(hex);
+    if (data.size() * 2 != hex.size() || data.size() < 48 || (data.size() - 40) % 8) {
+        return QString();
+    }
+
+    QCA::Initializer init;
+    if (!QCA::isSupported("sha1") || !QCA::isSupported("tripledes-cbc")) {
+        qCWarning(PLASMA_NM) << "QCA provides no SHA-1 or 3DES to decrypt the obfuscated password";
+        return QString();
+    }
+
+    const QByteArray seed = data.left(20);
+    const QByteArray ciphertext = data.mid(40);
+    if (QCA::Hash(QStringLiteral("sha1")).hash(ciphertext).toByteArray() != data.mid(20, 20)) {
+        return QString();
+    }
+
+    // The key is derived from the seed with its last byte incremented by one and by three
+    QByteArray keySeed = seed;
+    keySeed[19] = char(keySeed.at(19) + 1);
+    QByteArray key = QCA::Hash(QStringLiteral("sha1")).hash(keySeed).toByteArray();
+    keySeed[19] = char(keySeed.at(19) + 2);
+    key += QCA::Hash(QStringLiteral("sha1")).hash(keySeed).toByteArray().left(4);
+
+    QCA::Cipher cipher(QStringLiteral("tripledes"), QCA::Cipher::CBC, QCA::Cipher::NoPadding, QCA::Decode,
+                       QCA::SymmetricKey(key), QCA::InitializationVector(seed.left(8)));
+    QByteArray password = cipher.update(ciphertext).toByteArray();
+    password += cipher.final().toByteArray();
+    if (!cipher.ok() || password.isEmpty()) {
+        return QString();
+    }
+
+    // The last byte tells how much padding there is
+    const int padding = uchar(password.back());
+    if (padding > password.size()) {
+        return QString();
+    }
+    password.chop(padding);
+
+    return QString::fromUtf8(password);
+}
+
+bool VpncPcfParser::parse()
+{
+    m_connection.clear();
+    m_warnings.clear();
+    m_errorString.clear();
+
+    if (!QFileInfo(m_fileName).isReadable()) {
+        m_errorString = i18n("File %1 could not be opened.", m_fileName);
+        return false;
+    }
+
+    // NOTE: Cisco VPN pcf files follow ini style matching KConfig files
+    // http://www.cisco.com/en/US/docs/security/vpn_client/cisco_vpn_client/vpn_client46/administration/guide/vcAch2.html#wp1155033
+    KConfig config(m_fileName, KConfig::SimpleConfig);
+    KConfigGroup cg(&config, "main");   // Keys&Values are stored under [main]
+    if (!cg.exists()) {
+        m_errorString = i18n("%1: file format error.", m_fileName);
+        return false;
+    }
+
+    NMStringMap data;
+    NMStringMap secretData;
+    QVariantMap ipv4Data;
+
+    // gateway
+    data.insert(NM_VPNC_KEY_GATEWAY, readStringKeyValue(cg, "Host"));
+    // group name
+    data.insert(NM_VPNC_KEY_ID, readStringKeyValue(cg, "GroupName"));
+    // user password
+    if (!readStringKeyValue(cg, "UserPassword").isEmpty()) {
+        secretData.insert(NM_VPNC_KEY_XAUTH_PASSWORD, readStringKeyValue(cg, "UserPassword"));
+    } else if (!readStringKeyValue(cg, "enc_UserPassword").isEmpty()) {
+        const QString password = decryptPassword(readStringKeyValue(cg, "enc_UserPassword"));
+        if (password.isNull()) {
+            m_warnings << i18n("Error decrypting the obfuscated password");
+        } else {
+            secretData.insert(NM_VPNC_KEY_XAUTH_PASSWORD, password);
+        }
+    }
+    // Save user password
+    switch (cg.readEntry("SaveUserPassword").toInt()) {
+    case 0:
+        data.insert(NM_VPNC_KEY_XAUTH_PASSWORD"-flags", QString::number(NetworkManager::Setting::NotSaved));
+        break;
+    case 1:
+        data.insert(NM_VPNC_KEY_XAUTH_PASSWORD"-flags", QString::number(NetworkManager::Setting::AgentOwned));
+        break;
+    case 2:
+        data.insert(NM_VPNC_KEY_XAUTH_PASSWORD"-flags", QString::number(NetworkManager::Setting::NotRequired));
+        break;
+    }
+
+    // group password
+    if (!readStringKeyValue(cg, "GroupPwd").isEmpty()) {
+        secretData.insert(NM_VPNC_KEY_SECRET, readStringKeyValue(cg, "GroupPwd"));
+        data.insert(NM_VPNC_KEY_SECRET"-flags", QString::number(NetworkManager::Setting::AgentOwned));
+    } else if (!readStringKeyValue(cg, "enc_GroupPwd").isEmpty()) {
+        const QString password = decryptPassword(readStringKeyValue(cg, "enc_GroupPwd"));
+        if (password.isNull()) {
+            m_warnings << i18n("Error decrypting the obfuscated password");
+        } else {
+            secretData.insert(NM_VPNC_KEY_SECRET, password);
+            data.insert(NM_VPNC_KEY_SECRET"-flags", QString::number(NetworkManager::Setting::AgentOwned));
+        }
+    }
+
+    // Auth Type
+    if (!cg.readEntry("AuthType").isEmpty() && cg.readEntry("AuthType").toInt() == 5) {
+        data.insert(NM_VPNC_KEY_AUTHMODE, QLatin1String("hybrid"));
+    }
+
+    // Optional settings
+    // username
+    if (!readStringKeyValue(cg, "Username").isEmpty()) {
+        data.insert(NM_VPNC_KEY_XAUTH_USER, readStringKeyValue(cg, "Username"));
+    }
+    // domain
+    if (!readStringKeyValue(cg, "NTDomain").isEmpty()) {
+        data.insert(NM_VPNC_KEY_DOMAIN, readStringKeyValue(cg, "NTDomain"));
+    }
+    // encryption
+    if (!cg.readEntry("SingleDES").isEmpty() && cg.readEntry("SingleDES").toInt() != 0) {
+        data.insert(NM_VPNC_KEY_SINGLE_DES, QLatin1String("yes"));
+    }
+    /* Disable all NAT Traversal if explicit EnableNat=0 exists, otherwise
+     * default to NAT-T which is newer and standardized.  If EnableNat=1, then
+     * use Cisco-UDP like always; but if the key "X-NM-Use-NAT-T" is set, then
+     * use NAT-T.  If the key "X-NM-Force-NAT-T" is set then force NAT-T always
+     * on.  See vpnc documentation for more information on what the different
+     * NAT modes are.
+     */
+    // enable NAT
+    if (cg.readEntry("EnableNat").toInt() == 1) {
+        data.insert(NM_VPNC_KEY_NAT_TRAVERSAL_MODE, QLatin1String(NM_VPNC_NATT_MODE_CISCO));
+        // NAT traversal
+        if (!cg.readEntry("X-NM-Use-NAT-T").isEmpty()) {
+            if (cg.readEntry("X-NM-Use-NAT-T").toInt() == 1) {
+                data.insert(NM_VPNC_KEY_NAT_TRAVERSAL_MODE, QLatin1String(NM_VPNC_NATT_MODE_NATT));
+            }
+            if (cg.readEntry("X-NM-Force-NAT-T").toInt() == 1) {
+                data.insert(NM_VPNC_KEY_NAT_TRAVERSAL_MODE, QLatin1String(NM_VPNC_NATT_MODE_NATT_ALWAYS));
+            }
+        }
+    } else {
+        data.insert(NM_VPNC_KEY_NAT_TRAVERSAL_MODE, QLatin1String(NM_VPNC_NATT_MODE_NONE));
+    }
+    // dead peer detection
+    data.insert(NM_VPNC_KEY_DPD_IDLE_TIMEOUT, cg.readEntry("PeerTimeout"));
+    // UseLegacyIKEPort=0 uses dynamic source IKE port instead of 500.
+    if (cg.readEntry("UseLegacyIKEPort").isEmpty() || cg.readEntry("UseLegacyIKEPort").toInt() != 0) {
+        data.insert(NM_VPNC_KEY_LOCAL_PORT, QString::number(NM_VPNC_LOCAL_PORT_DEFAULT));
+    }
+    // DH Group
+    data.insert(NM_VPNC_KEY_DHGROUP, readStringKeyValue(cg, "DHGroup"));
+    // Tunneling Mode - not supported by vpnc
+    if (cg.readEntry("TunnelingMode").toInt() == 1) {
+        m_warnings << i18n("The VPN settings file '%1' specifies that VPN traffic should be tunneled through TCP which is currently not supported in the vpnc software.\n\nThe connection can still be created, with TCP tunneling disabled, however it may not work as expected.", m_fileName);
+    }
+    // EnableLocalLAN and X-NM-Routes are to be added to IPv4Setting
+    if (!cg.readEntry("EnableLocalLAN").isEmpty()) {
+        ipv4Data.insert("never-default", cg.readEntry("EnableLocalLAN"));
+    }
+    if (!readStringKeyValue(cg, "X-NM-Routes").isEmpty()) {
+        QList<NetworkManager::IpRoute> list;
+        for (const QString &route : readStringKeyValue(cg, "X-NM-Routes").split(' ', Qt::SkipEmptyParts)) {
+            const QStringList parts = route.split('/');
+            if (parts.size() != 2) {
+                continue;
+            }
+            NetworkManager::IpRoute ipRoute;
+            ipRoute.setIp(QHostAddress(parts.first()));
+            ipRoute.setPrefixLength(parts.at(1).toInt());
+            list << ipRoute;
+        }
+        QList<QList<uint> > dbusRoutes;
+        for (const NetworkManager::IpRoute &route : list) {
+            QList<uint> dbusRoute;
+            dbusRoute << htonl(route.ip().toIPv4Address())
+                    << route.prefixLength()
+                    << htonl(route.nextHop().toIPv4Address())
+                    << route.metric();
+            dbusRoutes << dbusRoute;
+        }
+        ipv4Data.insert("routes", QVariant::fromValue(dbusRoutes));
+    }
+
+    // Set the '...-type' and '...-flags' value also
+    NetworkManager::VpnSetting setting;
+    setting.setServiceType("org.freedesktop.NetworkManager.vpnc");
+    setting.setData(data);
+    setting.setSecrets(secretData);
+
+    QVariantMap conn;
+    if (readStringKeyValue(cg, "Description").isEmpty()) {
+        QFileInfo fileInfo(m_fileName);
+        conn.insert("id", fileInfo.fileName().remove(QLatin1String(".pcf"), Qt::CaseInsensitive));
+    } else {
+        conn.insert("id", readStringKeyValue(cg, "Description"));
+    }
+    conn.insert("type", "vpn");
+    m_connection.insert("connection", conn);
+
+    m_connection.insert("vpn", setting.toMap());
+
+    if (!ipv4Data.isEmpty()) {
+        m_connection.insert("ipv4", ipv4Data);
+    }
+
+    return true;
+}
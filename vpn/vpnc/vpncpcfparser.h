@@ -0,0 +1,71 @@
+/*
+    Copyright 2026 The plasma-nm developers
+
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as
+    published by the Free Software Foundation; either version 2 of
+    the License or (at your option) version 3 or any later version
+    accepted by the membership of KDE e.V. (or its successor approved
+    by the membership of KDE e.V.), which shall act as a proxy
+    defined in Section 14 of version 3 of the license.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLASMANM_VPNC_PCF_PARSER_H
+#define PLASMANM_VPNC_PCF_PARSER_H
+
+#include <QStringList>
+
+#include <NetworkManagerQt/GenericTypes>
+
+class KConfigGroup;
+
+/**
+ * Reads a Cisco VPN client profile (.pcf) into the settings of a
+ * NetworkManager vpnc connection.
+ *
+ * The parser does not touch any UI, so several files can be parsed at the same
+ * time on worker threads.
+ */
+class Q_DECL_EXPORT VpncPcfParser
+{
+public:
+    explicit VpncPcfParser(const QString &fileName);
+
+    /**
+     * Returns false if the file cannot be read or is not a Cisco VPN client
+     * profile, see errorString().
+     */
+    bool parse();
+
+    NMVariantMapMap connection() const;
+    /**
+     * Returns the problems that did not prevent the import, formatted for display.
+     */
+    QStringList warnings() const;
+    QString errorString() const;
+
+    /**
+     * Recovers a password obfuscated by the Cisco VPN client, as found in the
+     * enc_GroupPwd and enc_UserPassword entries. Returns a null string if
+     * @p encrypted is malformed or was tampered with.
+     */
+    static QString decryptPassword(const QString &encrypted);
+
+private:
+    static QString readStringKeyValue(const KConfigGroup &configGroup, const QString &key);
+
+    QString m_fileName;
+    NMVariantMapMap m_connection;
+    QStringList m_warnings;
+    QString m_errorString;
+};
+
+#endif // PLASMANM_VPNC_PCF_PARSER_H